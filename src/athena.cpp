@@ -389,8 +389,20 @@ namespace athena
 			manager->trigger_event(event); // Trigger the given event.
 	}
 
+	// A function that triggers the events in the range [begin,end). Allias for the direct call from the manager.
+	void trigger_events( const core::Event* begin , const core::Event* end )
+	{
+		// Get a pointer to the event manager.
+		core::EventManager* manager = core::EventManager::get();
+
+
+		// If the manager is initialised.
+		if ( manager != NULL )
+			manager->trigger_events(begin,end); // Trigger the given events.
+	}
+
 	// A function that registers an event for periodic triggering. Allias for the direct call from the manager.
-	void trigger_event_periodically( core::Event& event , const utility::TimerValueType& period )
+	void trigger_event_periodically( core::Event& event , const utility::TimerValueType& period , const core::PeriodicEventMode mode )
 	{
 		// Get a pointer to the event manager.
 		core::EventManager* manager = core::EventManager::get();
@@ -398,7 +410,7 @@ namespace athena
 
 		// If the manager is initialised.
 		if ( manager != NULL )
-			manager->trigger_event_periodically(event,period); // Register the periodic triggering.
+			manager->trigger_event_periodically(event,period,mode); // Register the periodic triggering.
 	}
 
 	// A function that unregisters an event from periodic triggering. Allias for the direct call from the manager.
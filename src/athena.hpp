@@ -5,6 +5,7 @@
 #include "eventCodes.hpp"
 #include "event.hpp"
 #include "timer.hpp"
+#include "periodicEventInfo.hpp"
 
 
 
@@ -36,8 +37,10 @@ namespace athena
 
 	// A function that triggers an event. Allias for the direct call from the manager.
 	ATHENA_DLL void trigger_event( const core::Event& event );
+	// A function that triggers the events in the range [begin,end). Allias for the direct call from the manager.
+	ATHENA_DLL void trigger_events( const core::Event* begin , const core::Event* end );
 	// A function that registers an event for periodic triggering. Allias for the direct call from the manager.
-	ATHENA_DLL void trigger_event_periodically( core::Event& event , const utility::TimerValueType& period );
+	ATHENA_DLL void trigger_event_periodically( core::Event& event , const utility::TimerValueType& period , const core::PeriodicEventMode mode = core::FixedRate );
 	// A function that unregisters an event from periodic triggering. Allias for the direct call from the manager.
 	ATHENA_DLL void stop_triggering_event_periodically( const core::EventCode& code );
 
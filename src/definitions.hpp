@@ -13,10 +13,16 @@
 		#define ATHENA_DLL __declspec(dllimport)
 	#endif /* DLL_EXPORT */
 
+	// Macro that is used to declare a variable that has a separate instance for each thread. Only plain data can be thread local.
+	#define ATHENA_THREAD_LOCAL __declspec(thread)
+
 #else	// Unix definitions.
 
 	#define ATHENA_DLL
 
+	// Macro that is used to declare a variable that has a separate instance for each thread. Only plain data can be thread local.
+	#define ATHENA_THREAD_LOCAL __thread
+
 #endif /* _WIN32 */
 
 
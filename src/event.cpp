@@ -8,36 +8,80 @@ namespace athena
 	namespace core
 	{
 
+		// Function returning the parameter at the given index, adding a new parameter to the list if the index is past the end of the list.
+		Parameter* Event::writable_parameter( const unsigned int& index )
+		{
+			Parameter* return_value = NULL;
+
+
+			if ( index < m_parameter_count )
+			{
+				if ( index < s_INLINE_PARAMETER_COUNT )
+					return_value = &m_parameters[index];
+				else
+					return_value = &m_extra_parameters[index-s_INLINE_PARAMETER_COUNT];
+			}
+			else if ( m_parameter_count < s_INLINE_PARAMETER_COUNT )
+			{
+				return_value = &m_parameters[m_parameter_count];
+				++m_parameter_count;
+			}
+			else
+			{
+				m_extra_parameters.push_back(Parameter());
+				return_value = &m_extra_parameters.back();
+				++m_parameter_count;
+			}
+
+
+			return return_value;
+		}
+
+
 		// The constructor of the class.
 		Event::Event( const EventCode& code , const ListenerIDType& initiator_id ) :
-			m_parameters(0,NULL) ,
+			m_extra_parameters(0) ,
+			m_parameter_count(0) ,
 			m_code(code) ,
 			m_initiator_id(initiator_id) ,
-			m_cleanup_function(NULL)
+			m_cleanup_function(NULL) ,
+			m_trigger_time()
 		{
 		}
 
 		// The copy constructor of the class.
 		Event::Event( const Event& event ) :
-			m_parameters(0,NULL) ,
+			m_extra_parameters(event.m_extra_parameters) ,
+			m_parameter_count(event.m_parameter_count) ,
 			m_code(event.code()) ,
 			m_initiator_id(event.initiator_id()) ,
-			m_cleanup_function(event.cleanup_function())
+			m_cleanup_function(event.cleanup_function()) ,
+			m_trigger_time(event.trigger_time())
 		{
-			for ( unsigned int i = 0;  i < event.parameter_count();  ++i )
-			{
-				const Parameter* new_parameter = event.parameter(i);
+			for ( unsigned int i = 0;  i < m_parameter_count  &&  i < s_INLINE_PARAMETER_COUNT;  ++i )
+				m_parameters[i] = event.m_parameters[i];
+		}
 
+		// The move constructor of the class. The given event is left without parameters and cleanup function.
+		Event::Event( Event&& event ) :
+			m_extra_parameters(0) ,
+			m_parameter_count(event.m_parameter_count) ,
+			m_code(event.code()) ,
+			m_initiator_id(event.initiator_id()) ,
+			m_cleanup_function(event.cleanup_function()) ,
+			m_trigger_time(event.trigger_time())
+		{
+			for ( unsigned int i = 0;  i < m_parameter_count  &&  i < s_INLINE_PARAMETER_COUNT;  ++i )
+				m_parameters[i] = event.m_parameters[i];
 
-				if ( new_parameter != NULL )
-					parameter(i,new_parameter->m_type,new_parameter->m_data);
-			}
+			m_extra_parameters.swap(event.m_extra_parameters);
+			event.m_parameter_count = 0;
+			event.m_cleanup_function = NULL;
 		}
 
 		// The destructor of the class.
 		Event::~Event()
 		{
-			clear();
 		}
 
 		// The assignment operator.
@@ -45,19 +89,38 @@ namespace athena
 		{
 			if ( this != &event )
 			{
-				clear();
+				m_extra_parameters = event.m_extra_parameters;
+				m_parameter_count = event.m_parameter_count;
 				m_code = event.code();
 				m_initiator_id = event.initiator_id();
 				m_cleanup_function = event.cleanup_function();
+				m_trigger_time = event.trigger_time();
+
+				for ( unsigned int i = 0;  i < m_parameter_count  &&  i < s_INLINE_PARAMETER_COUNT;  ++i )
+					m_parameters[i] = event.m_parameters[i];
+			}
+
+			return *this;
+		}
 
-				for ( unsigned int i = 0;  i < event.parameter_count();  ++i )
-				{
-					const Parameter* new_parameter = event.parameter(i);
+		// The move assignment operator. The given event is left without parameters and cleanup function.
+		Event& Event::operator=( Event&& event )
+		{
+			if ( this != &event )
+			{
+				m_extra_parameters.clear();
+				m_extra_parameters.swap(event.m_extra_parameters);
+				m_parameter_count = event.m_parameter_count;
+				m_code = event.code();
+				m_initiator_id = event.initiator_id();
+				m_cleanup_function = event.cleanup_function();
+				m_trigger_time = event.trigger_time();
 
+				for ( unsigned int i = 0;  i < m_parameter_count  &&  i < s_INLINE_PARAMETER_COUNT;  ++i )
+					m_parameters[i] = event.m_parameters[i];
 
-					if ( new_parameter != NULL )
-						parameter(i,new_parameter->m_type,new_parameter->m_data);
-				}
+				event.m_parameter_count = 0;
+				event.m_cleanup_function = NULL;
 			}
 
 			return *this;
@@ -69,35 +132,29 @@ namespace athena
 		{
 			if ( ( type != Null  &&  data != NULL )  ||  ( type == Null  &&  data == NULL ) )
 			{
-				if ( index < m_parameters.size() )
-				{
-					m_parameters[index]->m_type = type;
-					m_parameters[index]->m_data = data;
-				}
-				else
-				{
-					Parameter* new_parameter = new (std::nothrow) Parameter(type,data);
+				Parameter* parameter = writable_parameter(index);
 
 
-					if ( new_parameter != NULL )
-						m_parameters.push_back(new_parameter);
-				}
+				parameter->m_type = type;
+				parameter->data(data);
 			}
 		}
 
+		/*
+			Function responsible of setting the parameter at the given index or adding a new parameter to the list.
+			The value is copied inline, so it does not need to outlive the event nor a cleanup function.
+		*/
+		void Event::parameter_value( const unsigned int& index , const ParameterType type , const void* value )
+		{
+			if ( type != Null  &&  value != NULL )
+				writable_parameter(index)->value(type,value);
+		}
+
 		// Function responsible of clearing the parameter list.
 		void Event::clear()
 		{
-			for (
-					std::vector<Parameter*>::iterator parameter_iterator = m_parameters.begin();
-					parameter_iterator != m_parameters.end();
-					++parameter_iterator
-				)
-			{
-				delete (*parameter_iterator);
-			}
-
-			m_parameters.clear();
+			m_extra_parameters.clear();
+			m_parameter_count = 0;
 		}
 
 		// Function responsible of performing cleanup.
@@ -113,8 +170,10 @@ namespace athena
 		// Function returning the parameter at the given index.
 		const Parameter* Event::parameter( const unsigned int& index ) const
 		{
-			if ( index < m_parameters.size() ) 
-				return m_parameters[index];
+			if ( index < s_INLINE_PARAMETER_COUNT  &&  index < m_parameter_count ) 
+				return &m_parameters[index];
+			else if ( index < m_parameter_count ) 
+				return &m_extra_parameters[index-s_INLINE_PARAMETER_COUNT];
 			else
 				return NULL;
 		}
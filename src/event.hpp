@@ -3,6 +3,7 @@
 
 #include "definitions.hpp"
 #include <vector>
+#include <chrono>
 #include "parameter.hpp"
 
 
@@ -23,23 +24,41 @@ namespace athena
 		typedef unsigned int EventCode;
 		// A definition that defines the function to be used for cleanup.
 		typedef void (*EventCleanupFunction)( const Event& event );
+		// A type definition that defines the clock that is used to timestamp the events.
+		typedef std::chrono::steady_clock EventClock;
 
 
 		/*
 			A class representing and handling an event of the event system.
+			The first parameters of the event are stored inline and only the parameters
+			beyond them are kept in a list, so a typical event requires no allocation.
 		*/
 		class Event
 		{
 			private:
 
-				// The list of the parameters.
-				std::vector<Parameter*> m_parameters;
+				// The amount of parameters that are stored inline.
+				static const unsigned int s_INLINE_PARAMETER_COUNT = 4;
+
+
+				// The parameters that are stored inline.
+				Parameter m_parameters[s_INLINE_PARAMETER_COUNT];
+				// The list of the parameters that do not fit inline.
+				std::vector<Parameter> m_extra_parameters;
+				// The amount of parameters of the event.
+				unsigned int m_parameter_count;
 				// The id code of the event. A valid code id is greater than 0. 0 is reserved for the EVENT_ALL virtual event.
 				EventCode m_code;
 				// The id of the triggering entity.
 				ListenerIDType m_initiator_id;
 				// The function to be called in order to perform cleanup.
 				EventCleanupFunction m_cleanup_function;
+				// The time the event was queued for triggering.
+				EventClock::time_point m_trigger_time;
+
+
+				// Function returning the parameter at the given index, adding a new parameter to the list if the index is past the end of the list.
+				Parameter* writable_parameter( const unsigned int& index );
 
 
 			public:
@@ -48,21 +67,32 @@ namespace athena
 				ATHENA_DLL explicit Event( const EventCode& id = 0 , const ListenerIDType& initiator_id = 0 );
 				// The copy constructor of the class.
 				ATHENA_DLL Event( const Event& event );
+				// The move constructor of the class. The given event is left without parameters and cleanup function.
+				ATHENA_DLL Event( Event&& event );
 				// The destructor of the class.
 				ATHENA_DLL ~Event();
 
 				// The assignment operator.
 				ATHENA_DLL Event& operator=( const Event& event );
+				// The move assignment operator. The given event is left without parameters and cleanup function.
+				ATHENA_DLL Event& operator=( Event&& event );
 
 
 				// Function responsible of setting the parameter at the given index or adding a new parameter to the list.
 				ATHENA_DLL void parameter( const unsigned int& index , const ParameterType type , void* data );
+				/*
+					Function responsible of setting the parameter at the given index or adding a new parameter to the list.
+					The value is copied inline, so it does not need to outlive the event nor a cleanup function.
+				*/
+				ATHENA_DLL void parameter_value( const unsigned int& index , const ParameterType type , const void* value );
 				// Function responsible of setting the id code of the event.
 				ATHENA_DLL void code( const EventCode& value );
 				// Function responsible of setting the id code of the triggering entity.
 				ATHENA_DLL void initiator_id( const ListenerIDType& value );
 				// Function responsible of setting the cleanup function.
 				ATHENA_DLL void cleanup_function( EventCleanupFunction function );
+				// Function responsible of setting the time the event was queued for triggering.
+				ATHENA_DLL void trigger_time( const EventClock::time_point& value );
 				// Function responsible of clearing the parameter list.
 				ATHENA_DLL void clear();
 				// Function responsible of performing cleanup.
@@ -77,6 +107,8 @@ namespace athena
 				ATHENA_DLL ListenerIDType initiator_id() const;
 				// Function returning the cleanup function.
 				ATHENA_DLL EventCleanupFunction cleanup_function() const;
+				// Function returning the time the event was queued for triggering.
+				ATHENA_DLL const EventClock::time_point& trigger_time() const;
 				// Function returning the size of the parameter list.
 				ATHENA_DLL unsigned int parameter_count() const;
 		};
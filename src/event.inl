@@ -32,6 +32,12 @@ namespace athena
 			m_cleanup_function = function;
 		}
 
+		// Function responsible of setting the time the event was queued for triggering.
+		inline void Event::trigger_time( const EventClock::time_point& value )
+		{
+			m_trigger_time = value;
+		}
+
 
 		// Function returning the id code of the event.
 		inline EventCode Event::code() const
@@ -51,10 +57,16 @@ namespace athena
 			return m_cleanup_function;
 		}
 
+		// Function returning the time the event was queued for triggering.
+		inline const EventClock::time_point& Event::trigger_time() const
+		{
+			return m_trigger_time;
+		}
+
 		// Function returning the size of the parameter list.
 		inline unsigned int Event::parameter_count() const
 		{
-			return m_parameters.size();
+			return m_parameter_count;
 		}
 
 	} /* core */
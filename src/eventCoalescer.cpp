@@ -0,0 +1,260 @@
+#include "eventCoalescer.hpp"
+#include <cstring>
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of adding the value the delta points to, to the value the target points to.
+		template< typename T >
+		static void add_value( void* target , const void* delta )
+		{
+			T target_value;
+			T delta_value;
+
+
+			memcpy(&target_value,target,sizeof(T));
+			memcpy(&delta_value,delta,sizeof(T));
+			target_value = static_cast<T>(target_value + delta_value);
+			memcpy(target,&target_value,sizeof(T));
+		}
+
+		/*
+			A function responsible of adding the value of the delta parameter to the value of the parameter of the target event at the given index.
+			The sum is stored inline in the target event, since a parameter that is not stored inline points to data of the triggering entity,
+			which must not be changed. A parameter that points to data of an event with a cleanup function is left untouched,
+			since the cleanup function may expect the data it points to. Parameters of different or non-numeric types are also left untouched.
+		*/
+		static void add_parameter( Event& target , const unsigned int index , const Parameter* delta )
+		{
+			const Parameter* target_parameter = target.parameter(index);
+
+
+			if ( target_parameter != NULL  &&  delta != NULL  &&  target_parameter->type() == delta->type()  &&  target_parameter->data() != NULL  &&  delta->data() != NULL  &&  ( target_parameter->stored_inline()  ||  target.cleanup_function() == NULL ) )
+			{
+				ParameterValue value;
+				bool numeric = true;
+
+
+				memcpy(&value,target_parameter->data(),Parameter::size(target_parameter->type()));
+
+				switch ( target_parameter->type() )
+				{
+					case Character:					add_value<char>(&value,delta->data());					break;
+					case UnsignedCharacter:			add_value<unsigned char>(&value,delta->data());			break;
+					case WideCharacter:				add_value<wchar_t>(&value,delta->data());				break;
+					case ShortInteger:				add_value<short>(&value,delta->data());					break;
+					case UnsignedShortInteger:		add_value<unsigned short>(&value,delta->data());		break;
+					case Integer:					add_value<int>(&value,delta->data());					break;
+					case UnsignedInteger:			add_value<unsigned int>(&value,delta->data());			break;
+					case LongInteger:				add_value<long>(&value,delta->data());					break;
+					case UnsignedLongInteger:		add_value<unsigned long>(&value,delta->data());			break;
+					case Real:						add_value<float>(&value,delta->data());					break;
+					case DoubleReal:				add_value<double>(&value,delta->data());				break;
+					default:						numeric = false;										break;
+				}
+
+				if ( numeric )
+					target.parameter_value(index,target_parameter->type(),&value);
+			}
+		}
+
+
+		// A function responsible of merging the given event into the target event, according to the given policy. The given event is consumed.
+		void EventCoalescer::merge( Event& target , Event& event , const EventCoalescingPolicy policy )
+		{
+			if ( policy == SumDeltasCoalescing )
+			{
+				for ( unsigned int i = 0;  i < target.parameter_count()  &&  i < event.parameter_count();  ++i )
+					add_parameter(target,i,event.parameter(i));
+
+				event.cleanup();
+			}
+			else
+			{
+				// The target keeps the time it was queued, since that is when its wait started.
+				EventClock::time_point trigger_time = target.trigger_time();
+
+
+				target.cleanup();
+				target = std::move(event);
+				target.trigger_time(trigger_time);
+			}
+		}
+
+
+		// The constructor of the class.
+		EventCoalescer::EventCoalescer() :
+			m_entry_count(0) ,
+			m_entry_lock() ,
+			m_coalesced(0)
+		{
+			for ( unsigned int i = 0;  i < s_MAX_COALESCED_CODES;  ++i )
+			{
+				m_entries[i].m_code = 0;
+				m_entries[i].m_policy.store(NoCoalescing,std::memory_order_relaxed);
+				m_entries[i].m_dropped = 0;
+				m_entries[i].m_queued = false;
+				m_entries[i].m_merged = false;
+			}
+		}
+
+		// The destructor of the class.
+		EventCoalescer::~EventCoalescer()
+		{
+			clear();
+		}
+
+
+		/*
+			A function responsible of coalescing an event that is about to be queued. Returns true if the event has been
+			merged into a queued event of the same code, in which case it must not be queued. The given count of dropped events
+			of the lane the code is queued to is used to detect whether the queued event may have been dropped by the overflow policy.
+		*/
+		bool EventCoalescer::coalesce( Event& event , const unsigned long long dropped )
+		{
+			EventCoalescingEntry* code_entry = entry(event.code());
+			bool return_value = false;
+
+
+			if ( code_entry != NULL )
+			{
+				EventCoalescingPolicy code_policy = static_cast<EventCoalescingPolicy>(code_entry->m_policy.load(std::memory_order_relaxed));
+
+
+				if ( code_policy != NoCoalescing )
+				{
+					code_entry->m_lock.lock();
+
+					/*
+						If events of the same lane have been dropped since the event of the code was queued, the queued event
+						may be gone, so the merged events are discarded and the new event is queued instead.
+					*/
+					if ( code_entry->m_queued  &&  code_entry->m_dropped != dropped )
+					{
+						if ( code_entry->m_merged )
+							code_entry->m_event.cleanup();
+
+						code_entry->m_queued = false;
+						code_entry->m_merged = false;
+					}
+
+					if ( !code_entry->m_queued )
+					{
+						code_entry->m_queued = true;
+						code_entry->m_dropped = dropped;
+					}
+					else
+					{
+						if ( code_entry->m_merged )
+							merge(code_entry->m_event,event,code_policy);
+						else
+						{
+							code_entry->m_event = std::move(event);
+							code_entry->m_merged = true;
+						}
+
+						return_value = true;
+					}
+
+					code_entry->m_lock.unlock();
+
+					if ( return_value )
+						m_coalesced.fetch_add(1,std::memory_order_relaxed);
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of folding any merged events into the given event, which has just been popped from the queue.
+		void EventCoalescer::flush( Event& event )
+		{
+			EventCoalescingEntry* code_entry = entry(event.code());
+
+
+			if ( code_entry != NULL )
+			{
+				code_entry->m_lock.lock();
+
+				if ( code_entry->m_queued )
+				{
+					if ( code_entry->m_merged )
+						merge(event,code_entry->m_event,static_cast<EventCoalescingPolicy>(code_entry->m_policy.load(std::memory_order_relaxed)));
+
+					code_entry->m_queued = false;
+					code_entry->m_merged = false;
+				}
+
+				code_entry->m_lock.unlock();
+			}
+		}
+
+		// A function responsible of cleaning up any merged events.
+		void EventCoalescer::clear()
+		{
+			unsigned int count = m_entry_count.load(std::memory_order_acquire);
+
+
+			for ( unsigned int i = 0;  i < count;  ++i )
+			{
+				m_entries[i].m_lock.lock();
+
+				if ( m_entries[i].m_merged )
+					m_entries[i].m_event.cleanup();
+
+				m_entries[i].m_queued = false;
+				m_entries[i].m_merged = false;
+				m_entries[i].m_lock.unlock();
+			}
+		}
+
+		/*
+			A function responsible of setting the coalescing policy of the given event code.
+			Returns false if no more codes can be given a policy.
+		*/
+		bool EventCoalescer::policy( const EventCode code , const EventCoalescingPolicy policy )
+		{
+			EventCoalescingEntry* code_entry = NULL;
+			bool return_value = true;
+
+
+			m_entry_lock.lock();
+			code_entry = entry(code);
+
+			if ( code_entry == NULL )
+			{
+				unsigned int count = m_entry_count.load(std::memory_order_relaxed);
+
+
+				if ( count < s_MAX_COALESCED_CODES )
+				{
+					/*
+						The code is written before the count is raised, so a thread that
+						observes the new count also observes the code of the entry.
+					*/
+					code_entry = &m_entries[count];
+					code_entry->m_code = code;
+					m_entry_count.store(count + 1,std::memory_order_release);
+				}
+			}
+
+			if ( code_entry != NULL )
+				code_entry->m_policy.store(policy,std::memory_order_relaxed);
+			else
+				return_value = false;
+
+			m_entry_lock.unlock();
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
@@ -0,0 +1,132 @@
+#ifndef ATHENA_CORE_EVENTCOALESCER_HPP
+#define ATHENA_CORE_EVENTCOALESCER_HPP
+
+#include "definitions.hpp"
+#include <atomic>
+#include <mutex>
+#include "event.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			An enumeration holding the possible ways events of the same code can be merged while one of them is queued.
+			KeepLatestCoalescing replaces the queued event with the latest one, while SumDeltasCoalescing
+			adds the numeric parameters of the latest event to the ones of the queued event. The sums are stored
+			inline, so the data that a parameter points to is never changed. Any other parameters of the queued event are kept.
+		*/
+		enum EventCoalescingPolicy
+		{
+			NoCoalescing = 0 ,
+			KeepLatestCoalescing ,
+			SumDeltasCoalescing
+		};
+
+
+		/*
+			A class that is used by the event manager in order to coalesce high-frequency events.
+			While an event of a code with a coalescing policy is queued, any further events of the same code are
+			merged into it instead of being queued. The merged events are kept next to the queued event and folded into
+			it right before it is dispatched, so the event keeps its place in the queue and carries the latest state.
+			Looking up the policy of a code requires no lock. Each code uses its own lock for merging, so only
+			producers of the same code contend with each other and with the dispatch of that code.
+			Policies should be set before events of the code are triggered.
+		*/
+		class EventCoalescer
+		{
+			private:
+
+				// A struct holding the coalescing state of an event code.
+				struct EventCoalescingEntry
+				{
+					// The code of the events. Never changes after the entry has been published.
+					EventCode m_code;
+					// The coalescing policy of the code.
+					std::atomic<unsigned int> m_policy;
+					// A lock that is used to handle concurrency issues regarding the rest of the members.
+					std::mutex m_lock;
+					// The event holding the events that have been merged since an event of the code was queued.
+					Event m_event;
+					// The amount of events of the lane of the code that were dropped when the event of the code was queued.
+					unsigned long long m_dropped;
+					// Whether an event of the code is queued.
+					bool m_queued;
+					// Whether any events have been merged since an event of the code was queued.
+					bool m_merged;
+				};
+
+
+				// The maximum amount of event codes that can be given a coalescing policy.
+				static const unsigned int s_MAX_COALESCED_CODES = 64;
+
+
+				// The coalescing state of the event codes that have been given a policy.
+				EventCoalescingEntry m_entries[s_MAX_COALESCED_CODES];
+				// The amount of published entries.
+				std::atomic<unsigned int> m_entry_count;
+				// A lock that is used to handle concurrency issues between threads that set a policy.
+				std::mutex m_entry_lock;
+				// The amount of events that have been merged instead of being queued.
+				std::atomic<unsigned long long> m_coalesced;
+
+
+				// The copy constructor is not available.
+				EventCoalescer( const EventCoalescer& );
+				// The assignment operator is not available.
+				EventCoalescer& operator=( const EventCoalescer& );
+
+
+				// A function responsible of merging the given event into the target event, according to the given policy. The given event is consumed.
+				static void merge( Event& target , Event& event , const EventCoalescingPolicy policy );
+
+
+				// A function returning the entry of the given event code, or NULL if the code has never been given a policy.
+				EventCoalescingEntry* entry( const EventCode code ) const;
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL EventCoalescer();
+				// The destructor of the class.
+				ATHENA_DLL ~EventCoalescer();
+
+
+				/*
+					A function responsible of coalescing an event that is about to be queued. Returns true if the event has been
+					merged into a queued event of the same code, in which case it must not be queued. The given count of dropped events
+					of the lane the code is queued to is used to detect whether the queued event may have been dropped by the overflow policy.
+				*/
+				ATHENA_DLL bool coalesce( Event& event , const unsigned long long dropped );
+				// A function responsible of folding any merged events into the given event, which has just been popped from the queue.
+				ATHENA_DLL void flush( Event& event );
+				// A function responsible of cleaning up any merged events.
+				ATHENA_DLL void clear();
+				/*
+					A function responsible of setting the coalescing policy of the given event code.
+					Returns false if no more codes can be given a policy.
+				*/
+				ATHENA_DLL bool policy( const EventCode code , const EventCoalescingPolicy policy );
+
+
+				// A function returning the coalescing policy of the given event code.
+				ATHENA_DLL EventCoalescingPolicy policy( const EventCode code ) const;
+				// A function returning the amount of events that have been merged instead of being queued.
+				ATHENA_DLL unsigned long long coalesced() const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "eventCoalescer.inl"
+
+
+
+#endif /* ATHENA_CORE_EVENTCOALESCER_HPP */
\ No newline at end of file
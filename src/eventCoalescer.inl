@@ -0,0 +1,58 @@
+#ifndef ATHENA_CORE_EVENTCOALESCER_INL
+#define ATHENA_CORE_EVENTCOALESCER_INL
+
+#ifndef ATHENA_CORE_EVENTCOALESCER_HPP
+	#error "eventCoalescer.hpp must be included before eventCoalescer.inl"
+#endif /* ATHENA_CORE_EVENTCOALESCER_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function returning the entry of the given event code, or NULL if the code has never been given a policy.
+		inline EventCoalescer::EventCoalescingEntry* EventCoalescer::entry( const EventCode code ) const
+		{
+			unsigned int count = m_entry_count.load(std::memory_order_acquire);
+			EventCoalescingEntry* return_value = NULL;
+
+
+			for ( unsigned int i = 0;  i < count;  ++i )
+			{
+				if ( m_entries[i].m_code == code )
+				{
+					return_value = const_cast<EventCoalescingEntry*>(&m_entries[i]);
+					break;
+				}
+			}
+
+
+			return return_value;
+		}
+
+
+		// A function returning the coalescing policy of the given event code.
+		inline EventCoalescingPolicy EventCoalescer::policy( const EventCode code ) const
+		{
+			EventCoalescingEntry* code_entry = entry(code);
+
+
+			return ( code_entry != NULL  ?  static_cast<EventCoalescingPolicy>(code_entry->m_policy.load(std::memory_order_relaxed)) : NoCoalescing );
+		}
+
+		// A function returning the amount of events that have been merged instead of being queued.
+		inline unsigned long long EventCoalescer::coalesced() const
+		{
+			return m_coalesced.load(std::memory_order_relaxed);
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_EVENTCOALESCER_INL */
\ No newline at end of file
@@ -2,6 +2,7 @@
 #define ATHENA_EVENTCODES_HPP
 
 #include "event.hpp"
+#include "typedEvent.hpp"
 
 
 
@@ -269,6 +270,15 @@ namespace athena
 		EVENT_LOG_MAX_VALUE
 	};
 
+
+	/*
+		The typed events that are triggered by the engine.
+	*/
+	// The event holding the position of the mouse, as x and y.
+	typedef core::TypedEvent<EVENT_INPUT_MOUSE_POSITION,int,int> MousePositionEvent;
+	// The event holding the difference of the position of the mouse from its last position, as x and y.
+	typedef core::TypedEvent<EVENT_INPUT_MOUSE_POSITION_DIFFERENCE,int,int> MousePositionDifferenceEvent;
+
 } /* athena */
 
 #endif /* ATHENA_EVENTCODES_HPP */
@@ -2,10 +2,6 @@
 #include "threadPool.hpp"
 #include "eventCodes.hpp"
 
-#ifdef __unix
-	#include <unistd.h>
-#endif /* __UNIX */
-
 
 
 namespace athena
@@ -19,18 +15,6 @@ namespace athena
 		// A lock used to handle concurrency issues regarding the instance of the class.
 		std::mutex EventManager::s_instance_lock;
 
-		#ifdef ATHENA_EVENTMANAGER_SINGLETHREADED
-		#else
-						
-			/// The amount of time the spawned thread will sleep if there is nothing to do.
-			#ifdef _WIN32
-				const DWORD EventManager::s_sleep_time = 1;
-			#else
-				const unsigned int EventManager::s_sleep_time = 1000;
-			#endif /* _WIN32 */
-
-		#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
-
 
 		#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
 
@@ -42,32 +26,85 @@ namespace athena
 				
 				if ( manager != NULL )
 				{
-					bool run = true;
-
+					// The thread of the event manager is the consumer of the event queue.
+					manager->m_event_queue.consumer(std::this_thread::get_id());
 
-					while ( run )
-					{
-						manager->m_initialisation_lock.lock();
-						run = manager->m_running;
-						manager->m_initialisation_lock.unlock();
-
-						if ( run )
-							manager->actual_operate();
-					}
+					while ( manager->m_running.load() )
+						manager->actual_operate();
 				}
 
 
 				return 0;
 			}
 
-			// The static function that is used to perform the callback functionality for the spawned thread.
-			void EventManager::thread_callback_function( const int , void* parameter )
+			// A function responsible of waking up the functionality thread if it is blocked.
+			void EventManager::wake_up()
 			{
-				EventManager* manager = static_cast<EventManager*>(parameter);
-				
-				
-				if ( manager != NULL )
-					manager->m_thread_condition_variable.notify_all();
+				/*
+					The fence orders the publishing of the work before the check of the sleeping flag.
+					It pairs with the fence in wait_for_work(), so either this thread sees the
+					functionality thread going to sleep, or the functionality thread sees the work.
+				*/
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				// Only take the mutex if the functionality thread is (about to be) blocked.
+				if ( m_sleeping.load(std::memory_order_relaxed) )
+				{
+					m_wakeup_mutex.lock();
+					m_wakeup_pending = true;
+					m_wakeup_mutex.unlock();
+					m_wakeup_condition_variable.notify_one();
+				}
+			}
+
+			/*
+				A function responsible of waking up the functionality thread after the schedule of the periodic events or of a replay has changed.
+				The thread computes its timeout before it starts sleeping, so the wakeup is always recorded, and a thread that has not
+				started sleeping yet returns at once and computes its timeout again.
+			*/
+			void EventManager::wake_up_for_schedule()
+			{
+				m_wakeup_mutex.lock();
+				m_wakeup_pending = true;
+				m_wakeup_mutex.unlock();
+				m_wakeup_condition_variable.notify_one();
+			}
+
+			// A function responsible of blocking the functionality thread until there is work to do or the given time (in milliseconds) passes.
+			void EventManager::wait_for_work( const bool has_timeout , const utility::TimerValueType timeout )
+			{
+				m_wakeup_mutex.lock();
+				m_sleeping.store(true,std::memory_order_relaxed);
+				std::atomic_thread_fence(std::memory_order_seq_cst);
+
+				// Only block if no work has been published in the meantime.
+				if ( !m_wakeup_pending  &&  m_running.load(std::memory_order_relaxed)  &&  m_event_queue.empty() )
+				{
+					if ( has_timeout )
+					{
+						if ( timeout > 0 )
+						{
+							// The time at which the next periodic event is due.
+							std::chrono::steady_clock::time_point wakeup_time = std::chrono::steady_clock::now() + std::chrono::duration_cast<std::chrono::steady_clock::duration>(std::chrono::duration<utility::TimerValueType,std::milli>(timeout));
+
+
+							while ( !m_wakeup_pending  &&  m_running.load(std::memory_order_relaxed) )
+							{
+								if ( m_wakeup_condition_variable.wait_until(m_wakeup_mutex,wakeup_time) == std::cv_status::timeout )
+									break;
+							}
+						}
+					}
+					else
+					{
+						while ( !m_wakeup_pending  &&  m_running.load(std::memory_order_relaxed) )
+							m_wakeup_condition_variable.wait(m_wakeup_mutex);
+					}
+				}
+
+				m_sleeping.store(false,std::memory_order_relaxed);
+				m_wakeup_pending = false;
+				m_wakeup_mutex.unlock();
 			}
 
 		#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
@@ -77,25 +114,61 @@ namespace athena
 		EventManager::EventManager() :
 			m_event_list() ,
 			m_listener_list() ,
-			m_event_queue(0) ,
-			m_periodic_event_list(0) ,
-			m_pending_operation_queue(0) ,
-			m_pending_event_removals(0) ,
-			m_pending_listener_removals(0) ,
+			m_subscriptions() ,
+			m_event_queue() ,
+			m_event_coalescer() ,
+			m_event_recorder() ,
+			m_event_replayer() ,
+			m_replay_mode(FastReplay) ,
+			m_replay_start() ,
+
+			#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+				m_statistics() ,
+
+			#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+			m_periodic_event_scheduler() ,
+			m_due_periodic_events(0) ,
+			m_pending_events(0) ,
+			m_pending_operation_queue() ,
+			m_operation_buffer() ,
+			m_pending_event_removals() ,
+			m_pending_listener_removals() ,
+			m_routing_table() ,
+			m_mailbox_list() ,
+			m_retired_mailbox_list() ,
 			m_lock() ,
+			m_operation_lock() ,
 			m_initialisation_lock() ,
 			m_timer() ,
+			m_event_queue_capacity(0) ,
+			m_event_queue_overflow_policy(GrowOnOverflow) ,
 
 			#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
 
-				m_thread_condition_variable() ,
-				m_thread_mutex() ,
+				m_thread() ,
+				m_wakeup_condition_variable() ,
+				m_wakeup_mutex() ,
+				m_wakeup_pending(false) ,
+				m_sleeping(false) ,
 				m_running(false) ,
 
 			#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
 
-			m_initialised(false)
+			m_routing_table_outdated(false) ,
+			m_epoch_pending(false) ,
+			m_parallel_dispatch(false) ,
+			m_replaying(false) ,
+			m_initialised(false) ,
+			m_accepting_events(false) ,
+			m_triggering_threads(0)
 		{
+			// The default priority classes of the core events.
+			m_event_queue.priority(EVENT_EXIT,EVENT_EXIT,CriticalPriority);
+			m_event_queue.priority(EVENT_INPUT_KEYBOARD_SHIFT_DOWN,EVENT_INPUT_KEYBOARD_MACKEY_UP,InputPriority);
+			m_event_queue.priority(EVENT_INPUT_MOUSE_LEFT_DOWN,EVENT_INPUT_MOUSE_WHEEL_UP,InputPriority);
+			m_event_queue.priority(EVENT_LOG_NEW_ENTRY,EVENT_LOG_NEW_ENTRY,BackgroundPriority);
 		}
 
 		// The destructor of the class.
@@ -106,70 +179,119 @@ namespace athena
 		}
 
 
-		// A function responsible of queuing an event to be removed.
-		void EventManager::queue_listener_removal( Listener* listener )
+		// A function responsible of queuing a triggered event, unless it is merged into a queued event. Returns true if the event was queued.
+		bool EventManager::queue_event( Event& event )
 		{
-			std::vector<Listener*>::iterator listener_iterator(m_pending_listener_removals.begin());
+			bool return_value = false;
 
 
-			// Check the listener removal queue if the listener is already queued for removal.
-			while ( listener_iterator != m_pending_listener_removals.end() )
+			/*
+				The event is moved into the event queue. Only the drops of the lane the event is queued to
+				can have removed a queued event of the same code.
+			*/
+			if ( !m_event_coalescer.coalesce(event,m_event_queue.dropped(m_event_queue.priority(event.code()))) )
 			{
-				// If the listener is already queue stop the loop.
-				if ( (*listener_iterator) == listener )
-					break;
-
-				++listener_iterator;
+				m_event_queue.push(event);
+				return_value = true;
 			}
 
-			// If the listener is not queued for removal, add it to the queue.
-			if  ( listener_iterator == m_pending_listener_removals.end() )
-				m_pending_listener_removals.push_back(listener);
+
+			return return_value;
 		}
 
-		// A function responsible of queuing an event to be removed.
-		void EventManager::queue_event_removal( const EventCode& code )
+		/*
+			A function responsible of queuing at most the given amount of the events of the event log being replayed that are due.
+			Must be called while holding the lock.
+		*/
+		void EventManager::replay_events( const size_t max_events )
 		{
-			std::vector<EventCode>::iterator event_iterator(m_pending_event_removals.begin());
+			// The time that has passed since the replay started, in microseconds.
+			unsigned long long elapsed_time = static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(EventClock::now() - m_replay_start).count());
+			// The time the next event of the event log was triggered.
+			unsigned long long timestamp = 0;
+			size_t replayed_events = 0;
 
 
-			// Check the event removal queue if the event is already queued for removal.
-			while ( event_iterator != m_pending_event_removals.end() )
+			while ( replayed_events < max_events  &&  m_event_replayer.peek(timestamp)  &&  ( m_replay_mode == FastReplay  ||  timestamp <= elapsed_time ) )
 			{
-				// If the event is already queued for removal stop the loop.
-				if ( (*event_iterator) == code )
-					break;
+				Event event;
+
 
-				++event_iterator;
+				if ( m_event_replayer.pop(event) )
+				{
+					queue_event(event);
+					++replayed_events;
+				}
 			}
+		}
+
+		// A function responsible of queuing the event list of a listener to be compacted, and the listener to be removed if the list becomes empty.
+		void EventManager::queue_listener_removal( Listener* listener )
+		{
+			m_pending_listener_removals.insert(listener);
+		}
 
-			// If the event is not queued for removal, add it to the queue.
-			if  ( event_iterator == m_pending_event_removals.end() )
-				m_pending_event_removals.push_back(code);
+		// A function responsible of queuing the listener list of an event to be compacted, and the event to be removed if the list becomes empty.
+		void EventManager::queue_event_removal( const EventCode& code )
+		{
+			m_pending_event_removals.insert(code);
 		}
 
-		// A function responsible of performing any queued removals.
+		/*
+			A function responsible of performing any queued removals.
+			The lists of the listeners and events that have lost a registration are compacted in a single pass,
+			keeping the registrations that still exist in their original order, so removing any amount of
+			registrations on an epoch takes linear time. A registration that has been removed and added again
+			on the same epoch keeps its original place.
+		*/
 		void EventManager::perform_removals()
 		{
+			std::unordered_set<EventSubscription,EventSubscriptionHash> kept_subscriptions;
+
+
 			// For every listener in the listener removal queue.
 			for (
-					std::vector<Listener*>::iterator listener_iterator = m_pending_listener_removals.begin();
+					std::unordered_set<Listener*>::iterator listener_iterator = m_pending_listener_removals.begin();
 					listener_iterator != m_pending_listener_removals.end();
 					++listener_iterator
 				)
 			{
 				// Find the listener in the listener list.
-				std::map<Listener*,std::vector<EventCode> >::iterator listener_list_iterator(m_listener_list.find((*listener_iterator)));
+				std::unordered_map<Listener*,std::vector<EventCode> >::iterator listener_list_iterator(m_listener_list.find((*listener_iterator)));
 
 
-				// If the listener exists in the list, remove it from the list.
 				if ( listener_list_iterator != m_listener_list.end() )
-					m_listener_list.erase(listener_list_iterator);
+				{
+					std::vector<EventCode>& codes = listener_list_iterator->second;
+					size_t count = 0;
+
+
+					kept_subscriptions.clear();
+
+					// Keep every event the listener is still registered with, once.
+					for ( size_t i = 0;  i < codes.size();  ++i )
+					{
+						EventSubscription subscription(codes[i],(*listener_iterator));
+
+
+						if ( m_subscriptions.count(subscription) > 0  &&  kept_subscriptions.insert(subscription).second )
+						{
+							codes[count] = codes[i];
+							++count;
+						}
+					}
+
+					codes.resize(count);
+
+					// If the listener's event list is empty, remove it from the list.
+					if ( count == 0 )
+						m_listener_list.erase(listener_list_iterator);
+				}
 			}
 
 			// For every event in the event removal queue.
 			for (
-					std::vector<EventCode>::iterator event_iterator = m_pending_event_removals.begin();
+					std::unordered_set<EventCode>::iterator event_iterator = m_pending_event_removals.begin();
 					event_iterator != m_pending_event_removals.end();
 					++event_iterator
 				)
@@ -178,9 +300,33 @@ namespace athena
 				std::map<EventCode,std::vector<Listener*> >::iterator event_list_iterator(m_event_list.find((*event_iterator)));
 
 
-				// If the event exists in the list, remove it from the list.
 				if ( event_list_iterator != m_event_list.end() )
-					m_event_list.erase(event_list_iterator);
+				{
+					std::vector<Listener*>& listeners = event_list_iterator->second;
+					size_t count = 0;
+
+
+					kept_subscriptions.clear();
+
+					// Keep every listener that is still registered with the event, once.
+					for ( size_t i = 0;  i < listeners.size();  ++i )
+					{
+						EventSubscription subscription((*event_iterator),listeners[i]);
+
+
+						if ( m_subscriptions.count(subscription) > 0  &&  kept_subscriptions.insert(subscription).second )
+						{
+							listeners[count] = listeners[i];
+							++count;
+						}
+					}
+
+					listeners.resize(count);
+
+					// If the event's listener list is empty, remove it from the list.
+					if ( count == 0 )
+						m_event_list.erase(event_list_iterator);
+				}
 			}
 
 			// Clear the removal queues.
@@ -189,222 +335,410 @@ namespace athena
 		}
 
 		// A function responsible of adding notification regarding a single event for a listener.
-		void EventManager::add_event( std::map<Listener*,std::vector<EventCode> >::iterator& listener_iterator , const EventCode& code )
+		void EventManager::add_event( std::unordered_map<Listener*,std::vector<EventCode> >::iterator& listener_iterator , const EventCode& code )
 		{
-			std::vector<EventCode>::iterator event_iterator(listener_iterator->second.begin());
-
+			// If the listener has not been registered with the event already, add the event and the listener to each other's list.
+			if ( m_subscriptions.insert(EventSubscription(code,listener_iterator->first)).second )
+			{
+				m_event_list[code].push_back(listener_iterator->first);
+				listener_iterator->second.push_back(code);
+			}
+		}
 
-			// Check the listener's event list if the event has already been added.
-			while ( event_iterator != listener_iterator->second.end() )
+		// A function responsible of removing notification regarding a single event for a listener.
+		void EventManager::remove_event( std::unordered_map<Listener*,std::vector<EventCode> >::iterator& listener_iterator , const EventCode& code )
+		{
+			// If the listener is registered with the event, remove the registration and queue both lists to be compacted.
+			if ( m_subscriptions.erase(EventSubscription(code,listener_iterator->first)) > 0 )
 			{
-				// If the event has already been added, exit the loop.
-				if ( (*event_iterator) == code )
-					break;
+				queue_event_removal(code);
+				queue_listener_removal(listener_iterator->first);
+			}
+		}
 
-				++event_iterator;
+		// A function responsible of removing notification regarding all events for a listener.
+		void EventManager::remove_all_events( std::unordered_map<Listener*,std::vector<EventCode> >::iterator& listener_iterator )
+		{
+			// For all the events in the listener's event list.
+			for (
+					std::vector<EventCode>::iterator event_iterator(listener_iterator->second.begin());
+					event_iterator != listener_iterator->second.end();
+					++event_iterator
+				)
+			{
+				// Remove the registration and queue the event's listener list to be compacted.
+				if ( m_subscriptions.erase(EventSubscription((*event_iterator),listener_iterator->first)) > 0 )
+					queue_event_removal((*event_iterator));
 			}
 
-			// If the event has not been added already.
-			if ( event_iterator == listener_iterator->second.end() )
+			// Queue the listener's event list to be compacted. The listener is removed if it has not been registered with another event meanwhile.
+			queue_listener_removal(listener_iterator->first);
+		}
+
+		// The function that is used to perform any listener operations.
+		void EventManager::perform_listener_operation( const ListenerOperation& operation )
+		{
+			// Locate the listener in the listener list.
+			std::unordered_map<Listener*,std::vector<EventCode> >::iterator listener_iterator(m_listener_list.find(operation.m_listener));
+
+
+			// The routing table has to be compiled again before the next dispatch.
+			m_routing_table_outdated = true;
+
+			// Depending on the requested operation perform the necessary actions.
+			switch ( operation.m_operation )
 			{
-				// Check if the event has been added to the event list.
-				std::map<EventCode,std::vector<Listener*> >::iterator event_list_iterator(m_event_list.find(code));
+				// If we want to add an event notification.
+				case AddEvent:
 
+					// If the listener is not in the listener list, add the listener to the list.
+					if ( listener_iterator == m_listener_list.end() )
+						listener_iterator = m_listener_list.insert(std::pair<Listener*,std::vector<EventCode> >(operation.m_listener,std::vector<EventCode>(0,0))).first;
 
-				// If the event has been added to the event list.
-				if ( event_list_iterator != m_event_list.end() )
-				{
-					std::vector<Listener*>::iterator event_list_listener_iterator(event_list_iterator->second.begin());
+					// Register the listener for notification of the specified event.
+					add_event(listener_iterator,operation.m_code);
 					
+					break;
 
-					// Check if the listener has been added to the event's list. (A bit redundant could be skipped for a performance boost).
-					while ( event_list_listener_iterator != event_list_iterator->second.end() )
-					{
-						// If the listener is already in the event's list, exit the loop.
-						if ( (*event_list_listener_iterator) == listener_iterator->first )
-							break;
+				// If we want to add notification for all events.
+				case AddAllEvents:
 
-						++event_list_listener_iterator;
-					}
+					// If the listener is not in the listener list, add the listener to the list.
+					if ( listener_iterator == m_listener_list.end() )
+						listener_iterator = m_listener_list.insert(std::pair<Listener*,std::vector<EventCode> >(operation.m_listener,std::vector<EventCode>(0,0))).first;
+					else // If the listener is in the listener list.
+						remove_all_events(listener_iterator);	// Unregister all events associated with the listener since we will be notifying for all events anyway.
 
-					// If the listener is not in the event's list, add it.
-					if ( event_list_listener_iterator == event_list_iterator->second.end() )
-						event_list_iterator->second.push_back(listener_iterator->first);
-				}
-				else // If the event has not been added, add it to the event list and add the listener to the event's list.
-					m_event_list.insert(std::pair<EventCode,std::vector<Listener*> >(code,std::vector<Listener*>(1,listener_iterator->first)));
+					// Register the listener for notification of the virtual EVENT_ALL event.
+					add_event(listener_iterator,operation.m_code);
 
-				// Add the event to the listener's event list.
-				listener_iterator->second.push_back(code);
+					break;
+
+				// If we want to remove notification for an event.
+				case RemoveEvent:
+
+					// Remove the event from the listener's list.
+					if ( listener_iterator != m_listener_list.end() )
+						remove_event(listener_iterator,operation.m_code);
+
+					break;
+
+				// If we want to remove notification for all events.
+				case RemoveAllEvents:
+
+					// Remove all events and the listeners from the lists.
+					if ( listener_iterator != m_listener_list.end() )
+						remove_all_events(listener_iterator);
+
+					break;
 			}
 		}
 
-		// A function responsible of removing notification regarding a single event for a listener.
-		void EventManager::remove_event( std::map<Listener*,std::vector<EventCode> >::iterator& listener_iterator , const EventCode& code )
+		// A function responsible of queuing a listener operation to be performed on the next epoch.
+		void EventManager::queue_listener_operation( const ListenerOperation& operation )
+		{
+			m_operation_lock.lock();
+			m_pending_operation_queue.push_back(operation);
+			m_epoch_pending.store(true,std::memory_order_release);
+			m_operation_lock.unlock();
+		}
+
+		// A function responsible of queuing the given operation for every pair of listener and event code in the given ranges, to be performed on the next epoch.
+		void EventManager::queue_listener_operations( const AvailableListenerOperations operation , Listener* const* listeners , const size_t listener_count , const EventCode* codes , const size_t code_count )
 		{
-			std::vector<EventCode>::iterator event_iterator(listener_iterator->second.begin());
+			bool initialised = false;
 
 
-			// Check if the event exists in the listener's event list.
-			while ( event_iterator != listener_iterator->second.end() )
+			m_initialisation_lock.lock();
+			initialised = m_initialised;
+			m_initialisation_lock.unlock();
+
+			if ( initialised  &&  listener_count > 0  &&  code_count > 0 )
 			{
-				// If the event exists in the list.
-				if ( (*event_iterator) == code )
+				m_operation_lock.lock();
+				m_pending_operation_queue.reserve(m_pending_operation_queue.size() + listener_count * code_count);
+
+				for ( size_t i = 0;  i < listener_count;  ++i )
 				{
-					// Find the event in the event list.
-					std::map<EventCode,std::vector<Listener*> >::iterator event_list_iterator(m_event_list.find(code));
+					for ( size_t j = 0;  j < code_count;  ++j )
+					{
+						// The virtual EVENT_ALL event cannot be registered or unregistered on an individual basis.
+						if ( operation == RemoveAllEvents  ||  codes[j] != EVENT_ALL )
+							m_pending_operation_queue.push_back(ListenerOperation(operation,codes[j],listeners[i]));
+					}
+				}
 
+				m_epoch_pending.store(true,std::memory_order_release);
+				m_operation_lock.unlock();
+			}
+		}
 
-					// If the event exists in the event list.
-					if ( event_list_iterator != m_event_list.end() )
-					{
-						std::vector<Listener*>::iterator event_list_listener_iterator(event_list_iterator->second.begin());
-					
+		/*
+			A function responsible of starting a new epoch, performing any pending listener operations
+			and updating the routing table. Must be called without holding the lock.
+		*/
+		void EventManager::perform_pending_operations()
+		{
+			// If nothing has changed since the last epoch, the routing table is up to date.
+			if ( m_epoch_pending.exchange(false,std::memory_order_acquire) )
+			{
+				// Take the queued operations by swapping the queue with the empty buffer.
+				m_operation_lock.lock();
+				m_operation_buffer.swap(m_pending_operation_queue);
+				m_operation_lock.unlock();
 
-						// Find the listener is in the event's listener list.
-						while ( event_list_listener_iterator != event_list_iterator->second.end() )
-						{
-							// When the listener is found.
-							if ( (*event_list_listener_iterator) == listener_iterator->first )
-							{
-								// Remove the listener from the event's list.
-								event_list_iterator->second.erase(event_list_listener_iterator);
+				m_lock.lock();
 
-								// If the event's listener list is empty, queue the event for removal.
-								if ( event_list_iterator->second.size() == 0 )
-									queue_event_removal(code);
+				// For all listeners in the operation buffer.
+				for (
+						std::vector<ListenerOperation>::iterator operation_iterator = m_operation_buffer.begin();
+						operation_iterator != m_operation_buffer.end();
+						++operation_iterator
+					)
+				{
+					// Perform any pending listener operation.
+					perform_listener_operation((*operation_iterator));
+				}
 
-								// Exit the loop.
-								break;
-							}
+				// Clear the operation buffer. Its storage is kept for the next epoch.
+				m_operation_buffer.clear();
 
-							++event_list_listener_iterator;
-						}
-					}
+				// Perform any event and listener removals.
+				perform_removals();
 
-					// Remove the event from the listener's event list and exit the loop.
-					listener_iterator->second.erase(event_iterator);
-					break;
+				// If the registry has changed, compile the routing table again.
+				if ( m_routing_table_outdated )
+				{
+					update_mailboxes();
+					m_routing_table.build(m_event_list,m_mailbox_list);
+					m_routing_table_outdated = false;
 				}
 
-				++event_iterator;
+				m_lock.unlock();
 			}
-
-			// If the listener's event list is empty, queue the listener for removal.
-			if ( listener_iterator->second.size() == 0 )
-				queue_listener_removal(listener_iterator->first);
 		}
 
-		// A function responsible of removing notification regarding all events for a listener.
-		void EventManager::remove_all_events( std::map<Listener*,std::vector<EventCode> >::iterator& listener_iterator , const bool removable )
+		// A function responsible of updating the mailboxes of the registered listeners.
+		void EventManager::update_mailboxes()
 		{
-			// For all the events in the listener's event list.
+			std::map<Listener*,ListenerMailbox*> mailbox_list;
+			ThreadPool* thread_pool = ThreadPool::get();
+			bool parallel = false;
+
+
+			// Parallel dispatch needs a thread pool thread, otherwise the mailboxes would never be served.
+			if ( m_parallel_dispatch  &&  thread_pool != NULL )
+				parallel = ( thread_pool->thread_count() > 0 );
+
+			// Deallocate the mailboxes of unregistered listeners that have delivered their events.
 			for (
-					std::vector<EventCode>::iterator event_iterator(listener_iterator->second.begin());
-					event_iterator != listener_iterator->second.end();
-					++event_iterator
+					std::map<Listener*,ListenerMailbox*>::iterator mailbox_iterator = m_retired_mailbox_list.begin();
+					mailbox_iterator != m_retired_mailbox_list.end();
 				)
 			{
-				// Find the event in the event list.
-				std::map<EventCode,std::vector<Listener*> >::iterator event_list_iterator(m_event_list.find((*event_iterator)));
-
-
-				// If the event is found.
-				if ( event_list_iterator != m_event_list.end() )
+				if ( mailbox_iterator->second->idle() )
 				{
-					std::vector<Listener*>::iterator event_list_listener_iterator(event_list_iterator->second.begin());
-					
+					delete mailbox_iterator->second;
+					m_retired_mailbox_list.erase(mailbox_iterator++);
+				}
+				else
+					++mailbox_iterator;
+			}
 
-					// Search the event's listener list for the listener.
-					while ( event_list_listener_iterator != event_list_iterator->second.end() )
+			// For every registered listener.
+			for (
+					std::map<EventCode,std::vector<Listener*> >::iterator event_iterator = m_event_list.begin();
+					event_iterator != m_event_list.end();
+					++event_iterator
+				)
+			{
+				for (
+						std::vector<Listener*>::iterator listener_iterator = event_iterator->second.begin();
+						listener_iterator != event_iterator->second.end();
+						++listener_iterator
+					)
+				{
+					if ( mailbox_list.find((*listener_iterator)) == mailbox_list.end() )
 					{
-						// If the listener is found.
-						if ( (*event_list_listener_iterator) == listener_iterator->first )
+						std::map<Listener*,ListenerMailbox*>::iterator mailbox_iterator = m_mailbox_list.find((*listener_iterator));
+						ListenerMailbox* mailbox = NULL;
+
+
+						// Keep the existing mailbox of the listener, so that its pending events stay in order.
+						if ( mailbox_iterator != m_mailbox_list.end() )
 						{
-							// Remove the listener from the event's listener list.
-							event_list_iterator->second.erase(event_list_listener_iterator);
+							mailbox = mailbox_iterator->second;
+							m_mailbox_list.erase(mailbox_iterator);
+						}
+						else
+						{
+							mailbox_iterator = m_retired_mailbox_list.find((*listener_iterator));
 
-							// If the event's listener list is empty, queue the event for removal.
-							if ( event_list_iterator->second.size() == 0 )
-								queue_event_removal((*event_iterator));
+							if ( mailbox_iterator != m_retired_mailbox_list.end() )
+							{
+								mailbox = mailbox_iterator->second;
+								m_retired_mailbox_list.erase(mailbox_iterator);
+							}
+							else
+							{
+								mailbox = new (std::nothrow) ListenerMailbox((*listener_iterator));
 
-							// Exit the loop.
-							break;
+								#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+									// The slow handlers of the listener are reported to the statistics of the manager.
+									if ( mailbox != NULL )
+										mailbox->statistics(&m_statistics);
+
+								#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+							}
 						}
 
-						++event_list_listener_iterator;
+						// A listener without a mailbox is notified directly.
+						if ( mailbox != NULL )
+						{
+							mailbox->parallel(parallel  &&  (*listener_iterator)->thread_safe());
+							mailbox_list.insert(std::pair<Listener*,ListenerMailbox*>((*listener_iterator),mailbox));
+						}
 					}
 				}
 			}
 
-			// If the listener should be removed from the listener list, queue the listener for removal.
-			if ( removable )
-				queue_listener_removal(listener_iterator->first);
+			// Any remaining mailbox belongs to a listener that has been unregistered.
+			for (
+					std::map<Listener*,ListenerMailbox*>::iterator mailbox_iterator = m_mailbox_list.begin();
+					mailbox_iterator != m_mailbox_list.end();
+					++mailbox_iterator
+				)
+			{
+				if ( mailbox_iterator->second->idle() )
+					delete mailbox_iterator->second;
+				else
+				{
+					mailbox_iterator->second->parallel(false);
+					m_retired_mailbox_list.insert((*mailbox_iterator));
+				}
+			}
+
+			m_mailbox_list.swap(mailbox_list);
 		}
 
-		// The function that is used to perform any listener operations.
-		void EventManager::perform_listener_operation( ListenerOperation& operation )
+		// A function responsible of waiting until every mailbox has delivered its events.
+		void EventManager::wait_for_mailboxes()
 		{
-			// Locate the listener in the listener list.
-			std::map<Listener*,std::vector<EventCode> >::iterator listener_iterator(m_listener_list.find(operation.m_listener));
+			std::vector<ListenerMailbox*> mailboxes(0,NULL);
 
 
-			// Depending on the requested operation perform the necessary actions.
-			switch ( operation.m_operation )
+			m_lock.lock();
+
+			for (
+					std::map<Listener*,ListenerMailbox*>::iterator mailbox_iterator = m_mailbox_list.begin();
+					mailbox_iterator != m_mailbox_list.end();
+					++mailbox_iterator
+				)
 			{
-				// If we want to add an event notification.
-				case AddEvent:
+				mailboxes.push_back(mailbox_iterator->second);
+			}
 
-					// If the listener is not in the listener list.
-					if ( listener_iterator == m_listener_list.end() )
-					{
-						// Add the listener to the list
-						m_listener_list.insert(std::pair<Listener*,std::vector<EventCode> >(operation.m_listener,std::vector<EventCode>(0,0)));
-						listener_iterator = m_listener_list.find(operation.m_listener);
-					}
+			for (
+					std::map<Listener*,ListenerMailbox*>::iterator mailbox_iterator = m_retired_mailbox_list.begin();
+					mailbox_iterator != m_retired_mailbox_list.end();
+					++mailbox_iterator
+				)
+			{
+				mailboxes.push_back(mailbox_iterator->second);
+			}
 
-					// If the listener is in the listener list, register the listener for notification of the specified event.
-					if ( listener_iterator != m_listener_list.end() )
-						add_event(listener_iterator,operation.m_code);
-					
-					break;
+			m_lock.unlock();
 
-				// If we want to add notification for all events.
-				case AddAllEvents:
+			// The lock is not held while waiting, since the listeners may use the event manager.
+			for (
+					std::vector<ListenerMailbox*>::iterator mailbox_iterator = mailboxes.begin();
+					mailbox_iterator != mailboxes.end();
+					++mailbox_iterator
+				)
+			{
+				while ( !(*mailbox_iterator)->idle() )
+					std::this_thread::yield();
+			}
+		}
 
-					// If the listener is not in the listener list.
-					if ( listener_iterator == m_listener_list.end() )
-					{
-						// Add the listener to the list
-						m_listener_list.insert(std::pair<Listener*,std::vector<EventCode> >(operation.m_listener,std::vector<EventCode>(0,0)));
-						listener_iterator = m_listener_list.find(operation.m_listener);
-					}
-					else // If the listener is in the listener list.
-						remove_all_events(listener_iterator,false);	// Unregister all events associated with the listener since we will be notifying for all events anyway.
+		// A function responsible of notifying the given listeners of an event, either directly or through their mailbox.
+		void EventManager::notify_listeners( Event& event , const bool periodic , const DispatchClock::time_point& dispatch_time , Listener* const* listeners , ListenerMailbox* const* mailboxes , const unsigned int count , DispatchedEvent*& dispatched_event )
+		{
+			for ( unsigned int i = 0;  i < count;  ++i )
+			{
+				bool deferred = ( mailboxes[i] != NULL  &&  mailboxes[i]->deferred() );
 
-					// If the listener is in the listener list, register the listener for notification of the virtual EVENT_ALL event.
-					if ( listener_iterator != m_listener_list.end() )
-						add_event(listener_iterator,operation.m_code);
 
-					break;
+				// The event is shared by every mailbox it is posted to.
+				if ( deferred  &&  dispatched_event == NULL )
+				{
+					if ( periodic )
+						dispatched_event = new (std::nothrow) DispatchedEvent(event,dispatch_time);
+					else
+						dispatched_event = new (std::nothrow) DispatchedEvent(std::move(event),dispatch_time);
+				}
 
-				// If we want to remove notification for an event.
-				case RemoveEvent:
+				// Once a triggered event has been moved to the dispatched event, the listeners are notified of the moved event.
+				const Event& current_event = ( dispatched_event != NULL  ?  dispatched_event->event() : event );
 
-					// Remove the event from the listener's list.
-					if ( listener_iterator != m_listener_list.end() )
-						remove_event(listener_iterator,operation.m_code);
 
-					break;
+				// A listener without a mailbox is notified directly.
+				if ( mailboxes[i] == NULL )
+					listeners[i]->on_event(current_event);
+				else if ( !deferred  ||  dispatched_event == NULL  ||  !mailboxes[i]->post(dispatched_event) ) // If the event cannot be posted, notify the listener directly.
+					mailboxes[i]->deliver(current_event,dispatch_time);
+			}
+		}
 
-				// If we want to remove notification for all events.
-				case RemoveAllEvents:
+		/*
+			A function responsible of notifying the registered listeners of the given event.
+			A triggered event is cleaned up once every listener has been notified, and is moved out if it has to be delivered on the thread pool.
+			A periodic event is copied if it has to be delivered on the thread pool.
+		*/
+		void EventManager::dispatch_event( Event& event , const bool periodic )
+		{
+			DispatchClock::time_point dispatch_time = DispatchClock::now();
+			DispatchedEvent* dispatched_event = NULL;
+			Listener* const* listeners = NULL;
+			ListenerMailbox* const* mailboxes = NULL;
+			unsigned int count = m_routing_table.route_all(listeners,mailboxes);
 
-					// Remove all events and the listeners from the lists.
-					if ( listener_iterator != m_listener_list.end() )
-						remove_all_events(listener_iterator,true);
+			#ifdef ATHENA_EVENTMANAGER_STATISTICS
 
-					break;
+				// The event may be moved out while the listeners are notified.
+				EventCode code = event.code();
+				EventClock::time_point trigger_time = event.trigger_time();
+
+			#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+
+			// Notify the listeners that want to be notified for all events.
+			notify_listeners(event,periodic,dispatch_time,listeners,mailboxes,count,dispatched_event);
+
+			count = m_routing_table.route(event.code(),listeners,mailboxes);
+
+			// Notify the listeners of the triggered event.
+			notify_listeners(event,periodic,dispatch_time,listeners,mailboxes,count,dispatched_event);
+
+			#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+				m_statistics.record_dispatch(
+					code,
+					!periodic,
+					( !periodic  &&  dispatch_time > trigger_time  ?  static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(dispatch_time - trigger_time).count()) : 0 ),
+					static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(DispatchClock::now() - dispatch_time).count())
+				);
+
+			#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+			// If the event was posted to any mailbox, the last listener to be notified performs the cleanup.
+			if ( dispatched_event != NULL )
+				dispatched_event->release();
+			else if ( !periodic )
+			{
+				// Call the specified callback function that is responsible of performing cleanup for the parameters of the event.
+				event.cleanup();
 			}
 		}
 
@@ -412,206 +746,204 @@ namespace athena
 		void EventManager::actual_operate()
 		{
 			/*
-				A queue that is used to "buffer" the pending event list.
-				By using this technique, more CPU power is utilized to copy the queue, however the
-				size of the critical section that is needed is minimized.
+				The maximum amount of events that are dispatched on each pass.
+				The events are popped from the lock-free event queue without holding any lock.
+				At most a ring buffer worth of events is dispatched on each pass, so that a producer
+				flooding the queue cannot stall the periodic events.
 			*/
-			std::deque<Event*> pending_events(0);
+			size_t max_pending_events = m_event_queue.capacity();
+			// The amount of events that have been dispatched on this pass.
+			size_t dispatched_events = 0;
+			// The amount of events that have been popped on the current round.
+			size_t popped_events = 0;
 			// A variable that is used to get the current time value.
 			utility::TimerValueType current_time = 0;
 
 			#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
 
-				// Whether to sleep or not at the end of the function in order to avoid busy loops.
+				// Whether to block or not at the end of the function in order to avoid busy loops.
 				bool sleep = false;
+				// Whether there is a periodic event that the thread should wake up for.
+				bool has_deadline = false;
+				// The time the next periodic event is due.
+				utility::TimerValueType deadline = 0;
+				// The time the thread may block for, in milliseconds.
+				utility::TimerValueType timeout = 0;
+
+			#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
+
+
+			#ifdef ATHENA_EVENTMANAGER_SINGLETHREADED
+
+				// The thread that operates the event manager is the consumer of the event queue.
+				m_event_queue.consumer(std::this_thread::get_id());
 
 			#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
 
+			if ( max_pending_events < 1 )
+				max_pending_events = 1;
 
 			m_lock.lock();
-			// Get any pending events from the event queue and "buffer" them in the 
-			pending_events.insert(pending_events.end(),m_event_queue.begin(),m_event_queue.end());
-			// Clear the event queue.
-			m_event_queue.clear();
 			// Get the current time.
 			current_time = m_timer.milliseconds();
+
+			/*
+				Queue the events of the event log being replayed that are due. They are only queued while the event queue is empty,
+				so that the thread never blocks on its own queue, and at most a ring buffer worth of them is queued on each pass.
+			*/
+			if ( m_replaying.load(std::memory_order_relaxed)  &&  m_event_queue.empty() )
+				replay_events(max_pending_events);
+
 			m_lock.unlock();
 
-			// For all events in the pending queue
-			for (
-					std::deque<Event*>::iterator event_iterator = pending_events.begin();
-					event_iterator != pending_events.end();
-					++event_iterator
-				)
+			/*
+				The pending events are popped one weighted round at a time, so that urgent events
+				that are triggered during the pass overtake the less urgent events that are still queued.
+			*/
+			do
 			{
-				m_lock.lock();
+				// Get the events of the next round from the event queue and "buffer" them in the pending event list.
+				m_pending_events.clear();
+				popped_events = m_event_queue.pop(m_pending_events);
 
-				// For all listeners in the pending operation queue.
+				// For all events in the pending queue
 				for (
-						std::deque<ListenerOperation*>::iterator operation_iterator = m_pending_operation_queue.begin();
-						operation_iterator != m_pending_operation_queue.end();
-						++operation_iterator
+						std::vector<Event>::iterator event_iterator = m_pending_events.begin();
+						event_iterator != m_pending_events.end();
+						++event_iterator
 					)
 				{
 					// Perform any pending listener operation.
-					perform_listener_operation((*(*operation_iterator)));
-					delete (*operation_iterator);
+					perform_pending_operations();
+
+					// Fold any events that have been merged into the event while it was queued.
+					m_event_coalescer.flush((*event_iterator));
+
+					// Notify the listeners of the event. The event is cleaned up once every listener has been notified.
+					dispatch_event((*event_iterator),false);
 				}
 
-				// Clear the pending operation queue.
-				m_pending_operation_queue.clear();
-				m_lock.unlock();
+				dispatched_events += popped_events;
+			}
+			while ( popped_events > 0  &&  dispatched_events < max_pending_events );
 
+			m_lock.lock();
+			// Take the periodic events that are due out of the scheduler.
+			m_due_periodic_events.clear();
+			m_periodic_event_scheduler.collect(current_time,m_due_periodic_events);
+			m_lock.unlock();
 
-				// Find the virtual event EVENT_ALL in the event list that is used to notify the listeners that want to be notified for all events.
-				std::map<EventCode,std::vector<Listener*> >::iterator event_list_iterator(m_event_list.find(EVENT_ALL));
-				
-				
-				// If there is an ALL_EVENT entry in the event list.
-				if ( event_list_iterator != m_event_list.end() )
+			/*
+				The due periodic events are out of the scheduler while they are being triggered, so
+				they are dispatched without holding the lock. An event that is unregistered meanwhile
+				is only marked as cancelled.
+			*/
+			if ( m_due_periodic_events.size() > 0 )
+			{
+				// A variable that is used to get the time the periodic events have been triggered.
+				utility::TimerValueType trigger_time = 0;
+
+
+				// Perform any pending listener operation.
+				perform_pending_operations();
+
+				// For all the periodic events that are due.
+				for (
+						std::vector<PeriodicEventInfo*>::iterator event_iterator = m_due_periodic_events.begin();
+						event_iterator != m_due_periodic_events.end();
+						++event_iterator
+					)
 				{
-					// For all the listeners in the event's listener list.
-					for (
-							std::vector<Listener*>::iterator event_list_listener_iterator = event_list_iterator->second.begin();
-							event_list_listener_iterator != event_list_iterator->second.end();
-							++event_list_listener_iterator
-						)
+					// Skip any event that was unregistered by the listeners of a previous event.
+					if ( !(*event_iterator)->m_cancelled.load(std::memory_order_acquire) )
 					{
-						// Call the on_event function of the listener.
-						(*event_list_listener_iterator)->on_event((*(*event_iterator)));
+						// Calculate the time difference between the current time and the last trigger of the vent.
+						utility::TimerValueType difference = (current_time - (*event_iterator)->m_last_trigger);
+						// Get the first parameter of the event.
+						const Parameter* parameter = (*event_iterator)->m_event.parameter(0);
+				
+					
+						// Set the value of the first parameter of the event to the time that has passed since the last call.
+						*(static_cast<utility::TimerValueType*>(parameter->data())) = difference;
+
+						// Notify the listeners of the event.
+						dispatch_event((*event_iterator)->m_event,true);
+
+						// Update the time the periodic event was last triggered.
+						(*event_iterator)->m_last_trigger = current_time;
 					}
 				}
 
-				// Find the triggered event's entry in the entry list.
-				event_list_iterator = m_event_list.find((*event_iterator)->code());
+				m_lock.lock();
+				trigger_time = m_timer.milliseconds();
 
-				// If the entry exists in the event list.
-				if ( event_list_iterator != m_event_list.end() )
+				// Put the events back in the scheduler with their next deadline.
+				for (
+						std::vector<PeriodicEventInfo*>::iterator event_iterator = m_due_periodic_events.begin();
+						event_iterator != m_due_periodic_events.end();
+						++event_iterator
+					)
 				{
-					// For all the listeners in the event's listener list.
-					for (
-							std::vector<Listener*>::iterator event_list_listener_iterator = event_list_iterator->second.begin();
-							event_list_listener_iterator != event_list_iterator->second.end();
-							++event_list_listener_iterator
-						)
-					{
-						// Call the on_event function of the listener.
-						(*event_list_listener_iterator)->on_event((*(*event_iterator)));
-					}
+					m_periodic_event_scheduler.reschedule((*event_iterator),trigger_time);
 				}
 
-				// Call the specified callback function that is responsible of performing cleanup for the parameters of the event.
-				(*event_iterator)->cleanup();
-				delete (*event_iterator);
+				m_due_periodic_events.clear();
+				m_lock.unlock();
 			}
 
 			m_lock.lock();
 
-			// For all the periodic events.
-			for (
-					std::vector<PeriodicEventInfo*>::iterator event_iterator = m_periodic_event_list.begin();
-					event_iterator != m_periodic_event_list.end();
-					++event_iterator
-				)
+			// The replay is over once every event of the event log has been dispatched.
+			if ( m_replaying.load(std::memory_order_relaxed)  &&  !m_event_replayer.pending()  &&  m_event_queue.empty() )
 			{
-				// Calculate the time difference between the current time and the last trigger of the vent.
-				utility::TimerValueType difference = (current_time - (*event_iterator)->m_last_trigger);
+				m_event_replayer.close();
+				m_replaying.store(false,std::memory_order_release);
+			}
 
+			#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
 
-				// If the time difference is greater than the period of the event, trigger the event.
-				if ( difference >= (*event_iterator)->m_period )
+				// If no events were triggered, block until there is work to do or the next periodic event is due, in order to avoid busy loops.
+				if ( dispatched_events == 0 )
 				{
-					// Find the virtual event EVENT_ALL in the event list that is used to notify the listeners that want to be notified for all events.
-					std::map<EventCode,std::vector<Listener*> >::iterator event_list_iterator(m_event_list.find(EVENT_ALL));
-					// Get the first parameter of the event.
-					const Parameter* parameter = (*event_iterator)->m_event.parameter(0);
-				
-					
-					// Set the value of the first parameter of the event to the time that has passed since the last call.
-					*(static_cast<utility::TimerValueType*>(parameter->data())) = difference;
+					sleep = true;
+					has_deadline = m_periodic_event_scheduler.next_deadline(deadline);
 
-					// For all listeners in the pending operation queue.
-					for (
-							std::deque<ListenerOperation*>::iterator operation_iterator = m_pending_operation_queue.begin();
-							operation_iterator != m_pending_operation_queue.end();
-							++operation_iterator
-						)
-					{
-						// Perform any pending listener operation.
-						perform_listener_operation((*(*operation_iterator)));
-						delete (*operation_iterator);
-					}
-					
-					// Clear the pending operation queue.
-					m_pending_operation_queue.clear();
+					if ( has_deadline )
+						timeout = deadline - m_timer.milliseconds();
+				}
+
+				// If an event log is being replayed, the thread should also wake up for its next event.
+				if ( m_replaying.load(std::memory_order_relaxed) )
+				{
+					unsigned long long timestamp = 0;
 
 
-					// If there is an ALL_EVENT entry in the event list.
-					if ( event_list_iterator != m_event_list.end() )
+					if ( m_replay_mode == FastReplay )
+						sleep = false;
+					else if ( m_event_replayer.peek(timestamp) )
 					{
-						// For all the listeners in the event's listener list.
-						for (
-								std::vector<Listener*>::iterator event_list_listener_iterator = event_list_iterator->second.begin();
-								event_list_listener_iterator != event_list_iterator->second.end();
-								++event_list_listener_iterator
-							)
-						{
-							// Call the on_event function of the listener.
-							(*event_list_listener_iterator)->on_event((*event_iterator)->m_event);
-						}
-					}
+						// The time until the next event of the event log is due, in milliseconds.
+						utility::TimerValueType replay_timeout = ( static_cast<utility::TimerValueType>(timestamp) - static_cast<utility::TimerValueType>(std::chrono::duration_cast<std::chrono::microseconds>(EventClock::now() - m_replay_start).count()) ) / 1000.0;
 
-					// Find the triggered event's entry in the entry list.
-					event_list_iterator = m_event_list.find((*event_iterator)->m_event.code());
 
-					// If the entry exists in the event list.
-					if ( event_list_iterator != m_event_list.end() )
-					{
-						// For all the listeners in the event's listener list.
-						for (
-								std::vector<Listener*>::iterator event_list_listener_iterator = event_list_iterator->second.begin();
-								event_list_listener_iterator != event_list_iterator->second.end();
-								++event_list_listener_iterator
-							)
+						if ( !has_deadline  ||  replay_timeout < timeout )
 						{
-							// Call the on_event function of the listener.
-							(*event_list_listener_iterator)->on_event((*event_iterator)->m_event);
+							has_deadline = true;
+							timeout = replay_timeout;
 						}
 					}
-
-					// Update the time the periodic event was last triggered.
-					(*event_iterator)->m_last_trigger = current_time;
 				}
-			}
-
-			#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
-
-				// If no events were triggered, sleep for the desired time in order to avoid busy loops.
-				if ( pending_events.size() == 0  && m_periodic_event_list.size() == 0 )
-					sleep = true;
 
 			#endif /* #ifndef ATHENA_EVENTMANAGER_SINGLETHREADED */
 
-
-			// Perform any event and listener removals.
-			perform_removals();
 			m_lock.unlock();
 
 
 			#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
 
-				// If we should sleep
+				// If we should sleep, block until an event is triggered or the next periodic event is due.
 				if ( sleep )
-				{
-					// Sleep
-					#ifdef _WIN32 
-						Sleep(s_sleep_time);
-					#elif __unix
-						usleep(s_sleep_time);
-					#else
-						#error "Unsupported platform"
-					#endif /* WIN32 */
-				}
+					wait_for_work(has_deadline,timeout);
 
 			#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
 		}
@@ -619,45 +951,45 @@ namespace athena
 		// A function responsible of performing cleanup.
 		void EventManager::cleanup()
 		{
-			// For every periodic event.
-			for (
-					std::vector<PeriodicEventInfo*>::iterator periodic_event_iterator = m_periodic_event_list.begin();
-					periodic_event_iterator != m_periodic_event_list.end();
-					++periodic_event_iterator
-				)
-			{
-				// Call the specified callback function that is responsible of performing cleanup for the parameters of the event.
-				(*periodic_event_iterator)->m_event.cleanup();
-				delete (*periodic_event_iterator);
-			}
+			// Cleanup every periodic event.
+			m_periodic_event_scheduler.clear();
+
+			// Cleanup every event in the event queue, along with any events that have been merged into them.
+			m_event_queue.clear();
+			m_event_coalescer.clear();
 
-			m_periodic_event_list.clear();
+			// Stop recording and replaying the events.
+			m_event_recorder.close();
+			m_event_replayer.close();
+			m_replaying.store(false,std::memory_order_release);
 
-			// For every event in the event queue.
-			for ( 
-					std::deque<Event*>::iterator event_iterator = m_event_queue.begin();
-					event_iterator != m_event_queue.end();
-					++event_iterator
+			// Discard every pending listener operation.
+			m_operation_lock.lock();
+			m_pending_operation_queue.clear();
+			m_epoch_pending.store(false,std::memory_order_relaxed);
+			m_operation_lock.unlock();
+
+			// Deallocate the mailboxes of the listeners.
+			for (
+					std::map<Listener*,ListenerMailbox*>::iterator mailbox_iterator = m_mailbox_list.begin();
+					mailbox_iterator != m_mailbox_list.end();
+					++mailbox_iterator
 				)
 			{
-				// Call the specified callback function that is responsible of performing cleanup for the parameters of the event.
-				(*event_iterator)->cleanup();
-				delete (*event_iterator);
+				delete mailbox_iterator->second;
 			}
 
-			m_event_queue.clear();
-
-			// For every pending listener operation.
 			for (
-					std::deque<ListenerOperation*>::iterator operation_iterator = m_pending_operation_queue.begin();
-					operation_iterator != m_pending_operation_queue.end();
-					++operation_iterator
+					std::map<Listener*,ListenerMailbox*>::iterator mailbox_iterator = m_retired_mailbox_list.begin();
+					mailbox_iterator != m_retired_mailbox_list.end();
+					++mailbox_iterator
 				)
 			{
-				delete (*operation_iterator);
+				delete mailbox_iterator->second;
 			}
 
-			m_pending_operation_queue.clear();
+			m_mailbox_list.clear();
+			m_retired_mailbox_list.clear();
 		}
 
 
@@ -707,29 +1039,43 @@ namespace athena
 
 			#ifdef ATHENA_EVENTMANAGER_SINGLETHREADED
 
-				// (Re)Start the timer.
-				//m_timer.reset();
-				m_timer.start();
-				m_initialised = true;
-				return_value = true;
+				// Allocate the event queue, unless the event system is already operational.
+				if ( m_initialised  ||  m_event_queue.initialise(m_event_queue_capacity,m_event_queue_overflow_policy) )
+				{
+					// (Re)Start the timer.
+					//m_timer.reset();
+					m_timer.start();
+					m_initialised = true;
+					m_accepting_events.store(true,std::memory_order_seq_cst);
+					return_value = true;
+				}
 
 			#else
 				
 				ThreadPool* thread_pool = ThreadPool::get();
 
 
-				if ( thread_pool != NULL )
+				// Allocate the event queue, unless the event system is already operational.
+				if ( thread_pool != NULL  &&  ( m_initialised  ||  m_event_queue.initialise(m_event_queue_capacity,m_event_queue_overflow_policy) ) )
 				{
-					// Startup the thread.
-					if ( thread_pool->add_task(thread_function,static_cast<void*>(this),thread_callback_function,static_cast<void*>(this)) )
+					// The thread must see that it should run as soon as it starts.
+					m_running = true;
+
+					/*
+						Startup the thread, unless it is already running. The functionality loop runs for as long as
+						the event system is operational, so it is given a service thread instead of occupying a thread of the pool.
+					*/
+					if ( m_initialised  ||  m_thread.start("athena-events",thread_function,static_cast<void*>(this)) )
 					{
 						// (Re)Start the timer.
 						//m_timer.reset();
 						m_timer.start();
-						m_running = true;
 						m_initialised = true;
+						m_accepting_events.store(true,std::memory_order_seq_cst);
 						return_value = true;
 					}
+					else
+						m_running = false;
 				}
 
 			#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
@@ -747,25 +1093,44 @@ namespace athena
 
 			if ( m_initialised )
 			{
+				/*
+					Stop accepting events and wait for the threads that are already triggering events to finish, before the queue is cleaned up.
+					The functionality thread is still running, so a thread that is blocked on a full queue is unblocked.
+				*/
+				m_accepting_events.store(false,std::memory_order_seq_cst);
+
+				while ( m_triggering_threads.load(std::memory_order_seq_cst) > 0 )
+					std::this_thread::yield();
+
 				#ifdef ATHENA_EVENTMANAGER_SINGLETHREADED
+
+					m_initialisation_lock.unlock();
+
 				#else
 
 					m_running = false;
+					wake_up();
 					m_initialisation_lock.unlock();
 
-					m_thread_mutex.lock();
-					m_thread_condition_variable.wait(m_thread_mutex);
-					m_thread_mutex.unlock();
-					m_initialisation_lock.lock();
+					// Wait for the thread to exit.
+					m_thread.join();
 
 				#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
 
+				// Wait for the events that have been posted to the thread pool to be delivered.
+				wait_for_mailboxes();
+				m_initialisation_lock.lock();
+
 				m_lock.lock();
 				// Perform cleanup.
 				cleanup();
 				// Clear the lists and the queues.
 				m_event_list.clear();
 				m_listener_list.clear();
+				m_subscriptions.clear();
+				m_pending_event_removals.clear();
+				m_pending_listener_removals.clear();
+				m_routing_table.clear();
 				m_initialised = false;
 				m_lock.unlock();
 			}
@@ -795,27 +1160,109 @@ namespace athena
 			// If the event is not the virtual EVENT_ALL event.
 			if ( event.code() != EVENT_ALL )
 			{
-				bool initialised = false;
+				bool accepting_events = false;
 
 
-				m_initialisation_lock.lock();
-				initialised = m_initialised;
-				m_initialisation_lock.unlock();
+				/*
+					The thread is counted before the flag is read without locking, so triggering an event never blocks,
+					while terminate waits for the event to be queued before it cleans up the queue.
+				*/
+				m_triggering_threads.fetch_add(1,std::memory_order_seq_cst);
+				accepting_events = m_accepting_events.load(std::memory_order_seq_cst);
 
-				if ( initialised )
+				if ( accepting_events )
+				{
+					Event new_event(event);
+
+
+					// Record the event before it may be merged into a queued event.
+					if ( m_event_recorder.recording() )
+						m_event_recorder.record(new_event);
+
+					// Queue the event for triggering, unless it has been merged into a queued event. The copy is moved into the event queue.
+					if ( queue_event(new_event) )
+					{
+						#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
+							wake_up();
+						#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
+					}
+				}
+
+				m_triggering_threads.fetch_sub(1,std::memory_order_seq_cst);
+			}
+		}
+
+		/*
+			A function responsible of triggering the events in the range [begin,end), in order.
+			The events are queued in batches, with a single wakeup of the event manager thread.
+		*/
+		void EventManager::trigger_events( const Event* begin , const Event* end )
+		{
+			bool accepting_events = false;
+
+
+			// The thread is counted before the flag is read without locking, the same way as when a single event is triggered.
+			m_triggering_threads.fetch_add(1,std::memory_order_seq_cst);
+			accepting_events = m_accepting_events.load(std::memory_order_seq_cst);
+
+			if ( begin != NULL  &&  begin < end  &&  accepting_events )
+			{
+				const Event* event = begin;
+
+
+				while ( event != end )
 				{
-					Event* new_event = new (std::nothrow) Event(event);
+					// The copies of the events of the current batch.
+					Event batch[s_TRIGGER_BATCH_SIZE];
+					size_t count = 0;
+
+
+					while ( event != end  &&  count < s_TRIGGER_BATCH_SIZE )
+					{
+						// The virtual EVENT_ALL event cannot be triggered.
+						if ( event->code() != EVENT_ALL )
+						{
+							batch[count] = (*event);
 
+							// Record the event before it may be merged into a queued event.
+							if ( m_event_recorder.recording() )
+								m_event_recorder.record(batch[count]);
 
-					if ( new_event != NULL )
+							// Keep the copy in the batch, unless it has been merged into a queued event.
+							if ( !m_event_coalescer.coalesce(batch[count],m_event_queue.dropped(m_event_queue.priority(batch[count].code()))) )
+								++count;
+						}
+
+						++event;
+					}
+
+					// Queue the batch for triggering.
+					if ( count > 0 )
 					{
-						m_lock.lock();
-						// Queue the event for triggering.
-						m_event_queue.push_back(new_event);
-						m_lock.unlock();
+						size_t pushed = m_event_queue.push(batch,count);
+
+
+						#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
+							wake_up();
+						#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
+
+						/*
+							If the ring buffer is full, queue the rest of the batch one event at a time.
+							The overflow policy may block until the woken thread frees a slot.
+						*/
+						for ( size_t i = pushed;  i < count;  ++i )
+						{
+							m_event_queue.push(batch[i]);
+
+							#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
+								wake_up();
+							#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
+						}
 					}
 				}
 			}
+
+			m_triggering_threads.fetch_sub(1,std::memory_order_seq_cst);
 		}
 
 		/*
@@ -823,8 +1270,9 @@ namespace athena
 			The parameter at index 0 will be used to set the time that has passed since last trigger.
 			If the parameter is not the proper type or if there are no parameter the event manager will 
 			add the needed parameter.
+			If the event is already being triggered periodically, its period and mode are updated.
 		*/
-		void EventManager::trigger_event_periodically( Event& event , const utility::TimerValueType& period )
+		void EventManager::trigger_event_periodically( Event& event , const utility::TimerValueType& period , const PeriodicEventMode mode )
 		{
 			// If the event is not the virtual EVENT_ALL event.
 			if ( event.code() != EVENT_ALL )
@@ -838,29 +1286,15 @@ namespace athena
 
 				if ( initialised )
 				{
-					std::vector<PeriodicEventInfo*>::iterator periodic_event_iterator;
-
-
 					m_lock.lock();
-					periodic_event_iterator = m_periodic_event_list.begin();
-			
+
 					// Check if the event is already being triggered periodically.
-					while ( periodic_event_iterator != m_periodic_event_list.end() )
+					if ( m_periodic_event_scheduler.find(event.code()) != NULL )
 					{
-						// If the event is already being triggered.
-						if ( (*periodic_event_iterator)->m_event.code() == event.code() )
-						{
-							// Update the period of the event to the newly given value.
-							(*periodic_event_iterator)->m_period = period;
-							// Exit the loop.
-							break;
-						}
-
-						++periodic_event_iterator;
+						// Update the period and the mode of the event to the newly given values.
+						m_periodic_event_scheduler.schedule(event,period,mode,m_timer.milliseconds());
 					}
-
-					// If the event is not in the periodic event list.
-					if ( periodic_event_iterator == m_periodic_event_list.end() )
+					else // If the event is not being triggered periodically.
 					{
 						bool done = false;
 
@@ -881,32 +1315,22 @@ namespace athena
 						}
 						else // If the event does not have any parameters.
 						{
-							// Allocate a new variable to be used for the time difference value.
-							double* value = new (std::nothrow) double;
+							// The time difference value is stored inline, so the event owns it.
+							double value = 0;
 
 
-							// If the allocation was successful.
-							if ( value != NULL )
-							{
-								// Set the value to 0.
-								(*value) = 0;
-								// Add the parameter to the event.
-								event.parameter(0,DoubleReal,value);
+							// Add the parameter to the event.
+							event.parameter_value(0,DoubleReal,&value);
 
-								if ( event.parameter_count() > 0 )
-									done = true;
-							}
+							if ( event.parameter_count() > 0 )
+								done = true;
 						}
 
 						// If we can add the event to the periodic event list.
 						if ( done )
 						{
-							PeriodicEventInfo* event_info = new (std::nothrow) PeriodicEventInfo(event,period,0);
-
-
-							if ( event_info != NULL )
-								m_periodic_event_list.push_back(event_info); // Add the event to the periodic event list.
-							else
+							// Schedule the event to be triggered one period from now.
+							if ( !m_periodic_event_scheduler.schedule(event,period,mode,m_timer.milliseconds()) )
 								event.cleanup();
 						}
 						else // If we cannot add the event.
@@ -914,6 +1338,11 @@ namespace athena
 					}
 
 					m_lock.unlock();
+
+					#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
+						// Wake up the thread so that it takes the new period into account.
+						wake_up_for_schedule();
+					#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
 				}
 			}
 		}
@@ -935,26 +1364,8 @@ namespace athena
 				{
 					m_lock.lock();
 			
-					// Check the periodic event list.
-					for (
-							std::vector<PeriodicEventInfo*>::iterator periodic_event_iterator = m_periodic_event_list.begin();
-							periodic_event_iterator != m_periodic_event_list.end();
-							++periodic_event_iterator
-						)
-					{
-						// If we find the event we are looking for.
-						if ( (*periodic_event_iterator)->m_event.code() == code )
-						{
-							// Call the cleanup function of the event.
-							(*periodic_event_iterator)->m_event.cleanup();
-							delete (*periodic_event_iterator);
-							// Remove the event from the periodic event list.
-							m_periodic_event_list.erase(periodic_event_iterator);
-							// Exit the loop.
-							break;
-						}
-					}
-
+					// Unregister the event, if it is being triggered periodically.
+					m_periodic_event_scheduler.cancel(code);
 					m_lock.unlock();
 				}
 			}
@@ -975,17 +1386,8 @@ namespace athena
 
 				if ( initialised )
 				{
-					// Create the operation to be performed.
-					ListenerOperation* operation = new (std::nothrow) ListenerOperation(AddEvent,code,listener);
-
-
-					if ( operation != NULL )
-					{
-						m_lock.lock();
-						// Add the operation to the operation queue.
-						m_pending_operation_queue.push_back(operation);
-						m_lock.unlock();
-					}
+					// Add the operation to be performed to the operation queue.
+					queue_listener_operation(ListenerOperation(AddEvent,code,listener));
 				}
 			}
 		}
@@ -1007,17 +1409,8 @@ namespace athena
 
 			if ( initialised )
 			{
-				// Create the operation to be performed. Notice the virtual EVENT_ALL event that is being used.
-				ListenerOperation* operation = new (std::nothrow) ListenerOperation(AddAllEvents,EVENT_ALL,listener);
-
-
-				if ( operation != NULL )
-				{
-					m_lock.lock();
-					// Add the operation to the operation queue.
-					m_pending_operation_queue.push_back(operation);
-					m_lock.unlock();
-				}
+				// Add the operation to be performed to the operation queue. Notice the virtual EVENT_ALL event that is being used.
+				queue_listener_operation(ListenerOperation(AddAllEvents,EVENT_ALL,listener));
 			}
 		}
 			
@@ -1036,17 +1429,8 @@ namespace athena
 				// If the event is not the virtual EVENT_ALL event.
 				if ( code != EVENT_ALL )
 				{
-					// Create the operation to be performed.
-					ListenerOperation* operation = new (std::nothrow) ListenerOperation(RemoveEvent,code,listener);
-
-
-					if ( operation != NULL )
-					{
-						m_lock.lock();
-						// Add the operation to the operation queue.
-						m_pending_operation_queue.push_back(operation);
-						m_lock.unlock();
-					}
+					// Add the operation to be performed to the operation queue.
+					queue_listener_operation(ListenerOperation(RemoveEvent,code,listener));
 				}
 			}
 		}
@@ -1063,19 +1447,301 @@ namespace athena
 
 			if ( initialised )
 			{
-				// Create the operation to be performed.
-				ListenerOperation* operation = new (std::nothrow) ListenerOperation(RemoveAllEvents,EVENT_ALL,listener);
+				// Add the operation to be performed to the operation queue.
+				queue_listener_operation(ListenerOperation(RemoveAllEvents,EVENT_ALL,listener));
+			}
+		}
+
+		// A function responsible of registering a listener for notification of the event codes in the range [begin,end), with a single queue operation.
+		void EventManager::register_events( Listener* listener , const EventCode* begin , const EventCode* end )
+		{
+			if ( begin != NULL  &&  begin < end )
+				queue_listener_operations(AddEvent,&listener,1,begin,static_cast<size_t>(end - begin));
+		}
+
+		// A function responsible of registering the listeners in the range [begin,end) for notification of the specified event code, with a single queue operation.
+		void EventManager::register_listeners( Listener* const* begin , Listener* const* end , const EventCode& code )
+		{
+			if ( begin != NULL  &&  begin < end )
+				queue_listener_operations(AddEvent,begin,static_cast<size_t>(end - begin),&code,1);
+		}
+
+		// A function responsible of unregistering a listener from notification of the event codes in the range [begin,end), with a single queue operation.
+		void EventManager::unregister_events( Listener* listener , const EventCode* begin , const EventCode* end )
+		{
+			if ( begin != NULL  &&  begin < end )
+				queue_listener_operations(RemoveEvent,&listener,1,begin,static_cast<size_t>(end - begin));
+		}
+
+		// A function responsible of unregistering the listeners in the range [begin,end) from notification of all events, with a single queue operation.
+		void EventManager::unregister_listeners( Listener* const* begin , Listener* const* end )
+		{
+			EventCode code = EVENT_ALL;
+
+
+			if ( begin != NULL  &&  begin < end )
+				queue_listener_operations(RemoveAllEvents,begin,static_cast<size_t>(end - begin),&code,1);
+		}
+
+		// A function responsible of setting the capacity of the event queue. The new capacity is used the next time the event system is started.
+		void EventManager::event_queue_capacity( const size_t capacity )
+		{
+			m_initialisation_lock.lock();
+			m_event_queue_capacity = capacity;
+			m_initialisation_lock.unlock();
+		}
+
+		// A function responsible of setting the overflow policy of the event queue. The new policy is used the next time the event system is started.
+		void EventManager::event_queue_overflow_policy( const EventQueueOverflowPolicy policy )
+		{
+			m_initialisation_lock.lock();
+			m_event_queue_overflow_policy = policy;
+			m_initialisation_lock.unlock();
+		}
+
+
+		// A function returning the capacity of the event queue that is used when the event system is started.
+		size_t EventManager::event_queue_capacity()
+		{
+			size_t return_value = 0;
+
+
+			m_initialisation_lock.lock();
+			return_value = m_event_queue_capacity;
+			m_initialisation_lock.unlock();
+
+
+			return return_value;
+		}
+
+		// A function returning the overflow policy of the event queue that is used when the event system is started.
+		EventQueueOverflowPolicy EventManager::event_queue_overflow_policy()
+		{
+			EventQueueOverflowPolicy return_value = GrowOnOverflow;
+
+
+			m_initialisation_lock.lock();
+			return_value = m_event_queue_overflow_policy;
+			m_initialisation_lock.unlock();
+
+
+			return return_value;
+		}
+
+
+		/*
+			A function responsible of setting whether thread-safe listeners should be notified on the thread pool.
+			Parallel dispatch only takes effect if the thread pool has been started.
+		*/
+		void EventManager::parallel_dispatch( const bool value )
+		{
+			m_lock.lock();
+			m_parallel_dispatch = value;
+			// The mailboxes are updated when the routing table is compiled again, on the next epoch.
+			m_routing_table_outdated = true;
+			m_epoch_pending.store(true,std::memory_order_release);
+			m_lock.unlock();
+		}
+
+		// A function returning whether thread-safe listeners should be notified on the thread pool.
+		bool EventManager::parallel_dispatch()
+		{
+			bool return_value = false;
+
+
+			m_lock.lock();
+			return_value = m_parallel_dispatch;
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of starting the recording of the triggered events to the given file, which is truncated.
+			Any recording in progress is stopped first. Returns false if the file cannot be opened.
+		*/
+		bool EventManager::start_recording( const std::string& filename )
+		{
+			return m_event_recorder.open(filename);
+		}
+
+		// A function responsible of stopping the recording of the triggered events.
+		void EventManager::stop_recording()
+		{
+			m_event_recorder.close();
+		}
+
+		/*
+			A function responsible of starting the replay of the given event log with the given mode.
+			Any replay in progress is stopped first. Returns false if the file is not a valid event log.
+		*/
+		bool EventManager::start_replay( const std::string& filename , const EventReplayMode mode )
+		{
+			bool return_value = false;
+
+
+			m_lock.lock();
+			return_value = m_event_replayer.open(filename);
+			m_replay_mode = mode;
+			m_replay_start = EventClock::now();
+			m_replaying.store(return_value,std::memory_order_release);
+			m_lock.unlock();
+
+			#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
+
+				if ( return_value )
+					wake_up_for_schedule();
+
+			#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
+
+
+			return return_value;
+		}
+
+		// A function responsible of stopping the replay of the event log. Events that have already been queued are still dispatched.
+		void EventManager::stop_replay()
+		{
+			m_lock.lock();
+			m_event_replayer.close();
+			m_replaying.store(false,std::memory_order_release);
+			m_lock.unlock();
+		}
+
+		/*
+			A function responsible of copying the dispatch latency histogram of the given listener, in microseconds.
+			Returns false if the listener has no mailbox.
+		*/
+		bool EventManager::dispatch_latency( Listener* listener , utility::Histogram& histogram )
+		{
+			std::map<Listener*,ListenerMailbox*>::iterator mailbox_iterator;
+			bool return_value = false;
+
+
+			m_lock.lock();
+			mailbox_iterator = m_mailbox_list.find(listener);
+
+			if ( mailbox_iterator != m_mailbox_list.end() )
+			{
+				histogram = mailbox_iterator->second->latency();
+				return_value = true;
+			}
+			else
+			{
+				mailbox_iterator = m_retired_mailbox_list.find(listener);
+
+				if ( mailbox_iterator != m_retired_mailbox_list.end() )
+				{
+					histogram = mailbox_iterator->second->latency();
+					return_value = true;
+				}
+			}
+
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+			/*
+				A function responsible of copying the handler time histogram of the given listener, in microseconds, along with
+				the amount of times the listener has exceeded the handler budget. Returns false if the listener has no mailbox.
+			*/
+			bool EventManager::listener_statistics( Listener* listener , utility::Histogram& handler_time , unsigned long long& slow_handlers )
+			{
+				std::map<Listener*,ListenerMailbox*>::iterator mailbox_iterator;
+				ListenerMailbox* mailbox = NULL;
+				bool return_value = false;
+
+
+				m_lock.lock();
+				mailbox_iterator = m_mailbox_list.find(listener);
+
+				if ( mailbox_iterator != m_mailbox_list.end() )
+					mailbox = mailbox_iterator->second;
+				else
+				{
+					mailbox_iterator = m_retired_mailbox_list.find(listener);
+
+					if ( mailbox_iterator != m_retired_mailbox_list.end() )
+						mailbox = mailbox_iterator->second;
+				}
+
+				if ( mailbox != NULL )
+				{
+					handler_time = mailbox->handler_time();
+					slow_handlers = mailbox->slow_handlers();
+					return_value = true;
+				}
+
+				m_lock.unlock();
+
+
+				return return_value;
+			}
+
+			/*
+				A function responsible of writing the statistics of the event codes, the listeners and the lanes as a JSON object.
+				Returns false if the stream is invalid.
+			*/
+			bool EventManager::dump_statistics( std::ostream* stream )
+			{
+				bool return_value = ( stream != NULL  &&  stream->good() );
 
 
-				if ( operation != NULL )
+				if ( return_value )
 				{
+					(*stream) << "{\"events\":";
+					m_statistics.write_json((*stream));
+					(*stream) << ",\"listeners\":[";
+
 					m_lock.lock();
-					// Add the operation to the operation queue.
-					m_pending_operation_queue.push_back(operation);
+
+					for (
+							std::map<Listener*,ListenerMailbox*>::iterator mailbox_iterator = m_mailbox_list.begin();
+							mailbox_iterator != m_mailbox_list.end();
+							++mailbox_iterator
+						)
+					{
+						if ( mailbox_iterator != m_mailbox_list.begin() )
+							(*stream) << ",";
+
+						(*stream) << "{\"id\":" << mailbox_iterator->first->id();
+						(*stream) << ",\"address\":\"" << static_cast<const void*>(mailbox_iterator->first) << "\"";
+						(*stream) << ",\"slow_handlers\":" << mailbox_iterator->second->slow_handlers();
+						(*stream) << ",\"handler_time\":";
+						EventStatistics::write_histogram((*stream),mailbox_iterator->second->handler_time());
+						(*stream) << ",\"dispatch_latency\":";
+						EventStatistics::write_histogram((*stream),mailbox_iterator->second->latency());
+						(*stream) << "}";
+					}
+
 					m_lock.unlock();
+
+					(*stream) << "],\"lanes\":[";
+
+					for ( unsigned int i = 0;  i < PriorityEventQueue::s_LANE_COUNT;  ++i )
+					{
+						if ( i > 0 )
+							(*stream) << ",";
+
+						(*stream) << "{\"depth\":" << m_event_queue.depth(static_cast<EventPriority>(i)) << ",\"wait_time\":";
+						EventStatistics::write_histogram((*stream),m_event_queue.wait_time(static_cast<EventPriority>(i)));
+						(*stream) << "}";
+					}
+
+					(*stream) << "],\"dropped_events\":" << dropped_event_count();
+					(*stream) << ",\"coalesced_events\":" << coalesced_event_count() << "}";
+					return_value = stream->good();
 				}
+
+
+				return return_value;
 			}
-		}
+
+		#endif /* ATHENA_EVENTMANAGER_STATISTICS */
 
 	} /* core */
 
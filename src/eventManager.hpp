@@ -3,6 +3,7 @@
 
 #include "definitions.hpp"
 #include <mutex>
+#include <atomic>
 #include <chrono>
 	
 #ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
@@ -13,12 +14,34 @@
 #endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
 
 #include <map>
+#include <unordered_map>
+#include <unordered_set>
 #include <vector>
 #include <deque>
+#include <string>
+#include <new>
 #include "athena.hpp"
 #include "event.hpp"
+#include "eventQueue.hpp"
+#include "priorityEventQueue.hpp"
+#include "eventCoalescer.hpp"
+#include "eventRecorder.hpp"
+#include "eventReplayer.hpp"
+#include "eventRoutingTable.hpp"
 #include "listener.hpp"
+#include "listenerMailbox.hpp"
+#include "histogram.hpp"
+#include "objectPool.hpp"
 #include "periodicEventInfo.hpp"
+#include "periodicEventScheduler.hpp"
+#include "serviceThread.hpp"
+
+#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+	#include <ostream>
+	#include "eventStatistics.hpp"
+
+#endif /* ATHENA_EVENTMANAGER_STATISTICS */
 
 
 
@@ -44,6 +67,7 @@ namespace athena
 		/*
 			A struct that is used by the Event Manager in order to 
 			manage any pending listener operations.
+			The operations are queued by value, so queuing an operation requires no allocation of its own.
 		*/
 		struct ListenerOperation
 		{
@@ -60,16 +84,71 @@ namespace athena
 		};
 
 
+		// A struct that is used by the Event Manager in order to look up whether a listener is registered for an event.
+		struct EventSubscription
+		{
+			EventCode m_code;
+			Listener* m_listener;
+
+			EventSubscription( const EventCode code , Listener* listener ) :
+				m_code(code) , 
+				m_listener(listener)
+			{
+			};
+
+			bool operator==( const EventSubscription& subscription ) const
+			{
+				return ( m_code == subscription.m_code  &&  m_listener == subscription.m_listener );
+			};
+		};
+
+
+		// A struct that is used in order to hash the subscriptions.
+		struct EventSubscriptionHash
+		{
+			size_t operator()( const EventSubscription& subscription ) const
+			{
+				return ( std::hash<Listener*>()(subscription.m_listener) ^ ( std::hash<EventCode>()(subscription.m_code) * 0x9E3779B9U ) );
+			};
+		};
+
+
 		/*
 			A singleton class representing and handling the event system of the engine.
 			The event system forms the main message parsing functionality of the engine, 
 			informing entities of any triggered events.
 			If the macro ATHENA_EVENTMANAGER_SINGLETHREADED is defined the event manager performs
 			its functionality when the operate() function is called. If the macro is not defined, the
-			event manager spawns a thread which is responsible of performing the operation of the manager.
+			event manager spawns a service thread which is responsible of performing the operation of the manager,
+			so the threads of the thread pool remain available to the tasks. The thread blocks while there is nothing to do and is woken up when an event is triggered or
+			when the next periodic event is due.
 			When an event is passed to the event system a SHALLOW copy is performed. Therefore the caller should
 			make sure the parameters of the event do not go out of scope. Once the event has been successfully 
 			triggered a callback function will be called in order to perform any necessary cleanup.
+			Triggered events are passed through a bounded lock-free queue, so triggering an event does not
+			contend with the dispatching of the events. The capacity and overflow policy of the queue
+			can be set before the event system is started.
+			Every event code belongs to a priority class, and each class is queued in its own lane.
+			The lanes are dispatched in weighted rounds, so urgent events overtake queued events of lower
+			classes without starving them. By default the exit event is critical, keyboard and mouse button
+			events are input, log entries are background and every other event is normal.
+			Event codes can be given a coalescing policy, in which case an event of the code that is triggered
+			while another one is queued is merged into the queued event instead of being queued itself.
+			The triggered events can be recorded to a binary event log, which can later be replayed either as fast
+			as possible or with the timing it was recorded with. The replayed events are queued by the event manager
+			itself while its queue is empty, so they go through the same lanes and coalescing as triggered events. If
+			the macro ATHENA_EVENTMANAGER_SINGLETHREADED is defined, operate() has to be called until replaying() returns false.
+			If the macro ATHENA_EVENTMANAGER_STATISTICS is defined, the event manager keeps the dispatch count,
+			queue wait time and dispatch time of every event code and the handler time of every listener, and
+			reports listeners that exceed the handler budget to the log manager. The statistics can be queried
+			or dumped as JSON. If the macro is not defined, no statistics are kept and the functions are not available.
+			If parallel dispatch is enabled, listeners that declare themselves thread-safe are notified
+			on the thread pool through their mailbox, while the rest are notified on the thread of the
+			event manager. The cleanup of an event is performed once every listener has been notified.
+			Listeners are notified without holding any lock of the event manager. Listener registrations are
+			queued and take effect on the next epoch, which starts before the dispatch of every event and
+			before every batch of periodic events. Starting an epoch swaps the queued registrations with an
+			empty buffer, so registering a listener never waits for a dispatch to finish.
 		*/
 		class EventManager
 		{
@@ -79,69 +158,134 @@ namespace athena
 				static EventManager* s_instance;
 				// A lock used to handle concurrency issues regarding the instance of the class.
 				static std::mutex s_instance_lock;
-					
-				#ifdef ATHENA_EVENTMANAGER_SINGLETHREADED
-				#else
-						
-					// The amount of time the spawned thread will sleep if there is nothing to do.
-					#ifdef _WIN32
-						static const unsigned long s_sleep_time;
-					#else
-						static const unsigned int s_sleep_time;
-					#endif /* _WIN32 */
-
-				#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
+				// The maximum amount of events that are queued at once by trigger_events().
+				static const size_t s_TRIGGER_BATCH_SIZE = 64;
 
 
 				// The map that holds the registry of events and the entities that are registered for each event.
 				std::map<EventCode,std::vector<Listener*> > m_event_list;
 				// The map that holds the registry of entities and the events they are registered with.
-				std::map<Listener*,std::vector<EventCode> > m_listener_list;
-				// The event queue that is processed by the event manager.
-				std::deque<Event*> m_event_queue;
-				// The periodic event list that is triggered every specified interval.
-				std::vector<PeriodicEventInfo*> m_periodic_event_list;
+				std::unordered_map<Listener*,std::vector<EventCode> > m_listener_list;
+				/*
+					The set holding every registration of an entity with an event, which is used to look up a registration in constant time.
+					A registration is erased from the set as soon as it is removed, while the lists are compacted once per epoch.
+				*/
+				std::unordered_set<EventSubscription,EventSubscriptionHash> m_subscriptions;
+				// The priority event queue that is processed by the event manager.
+				PriorityEventQueue m_event_queue;
+				// The coalescer that merges high-frequency events while they are queued.
+				EventCoalescer m_event_coalescer;
+				// The recorder that writes the triggered events to an event log.
+				EventRecorder m_event_recorder;
+				// The replayer that reads the events of the event log being replayed.
+				EventReplayer m_event_replayer;
+				// The mode the event log is being replayed with.
+				EventReplayMode m_replay_mode;
+				// The time the replay of the event log started.
+				EventClock::time_point m_replay_start;
+
+				#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+					// The dispatch statistics of the event codes.
+					EventStatistics m_statistics;
+
+				#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+				// The scheduler of the periodic events that are triggered every specified interval.
+				PeriodicEventScheduler m_periodic_event_scheduler;
+				// The periodic events that are being triggered on the current pass.
+				std::vector<PeriodicEventInfo*> m_due_periodic_events;
+				/*
+					The list that is used to "buffer" the events that are popped from the event queue.
+					The list is kept between passes, so that its storage is reused.
+				*/
+				std::vector<Event> m_pending_events;
 				/*
 					The pending listener operation queue that is used to 
 					insert or delete entities or event notifications from the event and listener list
 				*/
-				std::deque<ListenerOperation*> m_pending_operation_queue;
-				// An array holding the events to be removed from the event list.
-				std::vector<EventCode> m_pending_event_removals;
-				// An array  holding the entities to be removed from the listener list.
-				std::vector<Listener*> m_pending_listener_removals;
+				std::vector<ListenerOperation> m_pending_operation_queue;
+				/*
+					The buffer that the pending listener operation queue is swapped with at the start of an epoch,
+					holding the operations that are performed on the current epoch.
+				*/
+				std::vector<ListenerOperation> m_operation_buffer;
+				// A set holding the events whose entity lists have to be compacted, and removed if they become empty.
+				std::unordered_set<EventCode> m_pending_event_removals;
+				// A set holding the entities whose event lists have to be compacted, and removed if they become empty.
+				std::unordered_set<Listener*> m_pending_listener_removals;
+				// The flat routing table that is compiled from the event list and used to dispatch the events.
+				EventRoutingTable m_routing_table;
+				// The mailboxes of the registered listeners.
+				std::map<Listener*,ListenerMailbox*> m_mailbox_list;
+				// The mailboxes of unregistered listeners that still have events to deliver.
+				std::map<Listener*,ListenerMailbox*> m_retired_mailbox_list;
 				// A lock that is used to handle concurrency issues.
 				std::recursive_mutex m_lock;
+				// A lock that is used to handle concurrency issues regarding the pending listener operation queue.
+				std::mutex m_operation_lock;
 				// A lock that is used to handle initialisation issues.
 				std::recursive_mutex m_initialisation_lock;
 				// A timer that is used for timing the elapsed time for periodic events.
 				utility::Timer m_timer;
+				// The capacity of the event queue that will be used when the event system is started.
+				size_t m_event_queue_capacity;
+				// The overflow policy of the event queue that will be used when the event system is started.
+				EventQueueOverflowPolicy m_event_queue_overflow_policy;
 
 				#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
 
+					// The service thread that runs the functionality of the event manager, which is joined when the terminate function is called.
+					ServiceThread m_thread;
 					/*
-						The condition variable that is used to syncronise the
-						functionality thread with the main thread when the 
-						terminate function is called.
+						The condition variable that the functionality thread blocks on while
+						there is nothing to do, until an event is triggered or the next
+						periodic event is due.
 					*/
-					std::condition_variable_any m_thread_condition_variable;
-					// The mutes that is used with the condition variable.
-					std::mutex m_thread_mutex;
+					std::condition_variable_any m_wakeup_condition_variable;
+					// The mutex that is used with the wakeup condition variable.
+					std::mutex m_wakeup_mutex;
+					// A variable holding whether a wakeup has been requested. Protected by the wakeup mutex.
+					bool m_wakeup_pending;
+					// A variable holding whether the functionality thread is about to block or is blocked.
+					std::atomic<bool> m_sleeping;
 					// A variable containing whether the thread should run or not.
-					bool m_running;
+					std::atomic<bool> m_running;
 
 				#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
 
+				// A variable holding whether the routing table has to be compiled again.
+				bool m_routing_table_outdated;
+				// A variable holding whether the registry has to be updated on the next epoch.
+				std::atomic<bool> m_epoch_pending;
+				// A variable holding whether thread-safe listeners should be notified on the thread pool.
+				bool m_parallel_dispatch;
+				// A variable holding whether an event log is being replayed.
+				std::atomic<bool> m_replaying;
 				// A variable holding whether the class has been initialised.
-				bool m_initialised;
+				std::atomic<bool> m_initialised;
+				// A variable holding whether events can be triggered, which is cleared as soon as the event system starts terminating.
+				std::atomic<bool> m_accepting_events;
+				// The amount of threads that are triggering events, which the termination waits for before cleaning up the event queue.
+				std::atomic<unsigned int> m_triggering_threads;
 
 
 				#ifndef ATHENA_EVENTMANAGER_SINGLETHREADED
 					
 					// The static function that is used by the thread in order to perform the needed functionality.
 					static int thread_function( void* parameter );
-					// The static function that is used to perform the callback functionality for the spawned thread.
-					static void thread_callback_function( const int exit_code , void* parameter );
+
+
+					// A function responsible of waking up the functionality thread if it is blocked.
+					void wake_up();
+					/*
+						A function responsible of waking up the functionality thread after the schedule of the periodic events or of a replay has changed.
+						The thread computes its timeout before it starts sleeping, so the wakeup is always recorded, and a thread that has not
+						started sleeping yet returns at once and computes its timeout again.
+					*/
+					void wake_up_for_schedule();
+					// A function responsible of blocking the functionality thread until there is work to do or the given time (in milliseconds) passes.
+					void wait_for_work( const bool has_timeout , const utility::TimerValueType timeout );
 
 				#endif /* ATHENA_EVENTMANAGER_SINGLETHREADED */
 
@@ -151,20 +295,48 @@ namespace athena
 				~EventManager();
 
 
-				// A function responsible of queuing a listener to be removed.
+				// A function responsible of queuing a triggered event, unless it is merged into a queued event. Returns true if the event was queued.
+				bool queue_event( Event& event );
+				/*
+					A function responsible of queuing at most the given amount of the events of the event log being replayed that are due.
+					Must be called while holding the lock.
+				*/
+				void replay_events( const size_t max_events );
+				// A function responsible of queuing the event list of a listener to be compacted, and the listener to be removed if the list becomes empty.
 				void queue_listener_removal( Listener* listener );
-				// A function responsible of queuing an event to be removed.
+				// A function responsible of queuing the listener list of an event to be compacted, and the event to be removed if the list becomes empty.
 				void queue_event_removal( const EventCode& code );
 				// A function responsible of performing any queued removals.
 				void perform_removals();
 				// A function responsible of adding notification regarding a single event for a listener.
-				void add_event( std::map<Listener*,std::vector<EventCode> >::iterator& listener_iterator , const EventCode& code );
+				void add_event( std::unordered_map<Listener*,std::vector<EventCode> >::iterator& listener_iterator , const EventCode& code );
 				// A function responsible of removing notification regarding a single event for a listener.
-				void remove_event( std::map<Listener*,std::vector<EventCode> >::iterator& listener_iterator , const EventCode& code );
+				void remove_event( std::unordered_map<Listener*,std::vector<EventCode> >::iterator& listener_iterator , const EventCode& code );
 				// A function responsible of removing notification regarding all events for a listener.
-				void remove_all_events( std::map<Listener*,std::vector<EventCode> >::iterator& listener_iterator , const bool removable );
+				void remove_all_events( std::unordered_map<Listener*,std::vector<EventCode> >::iterator& listener_iterator );
 				// A function responsible of performing any listener operations.
-				void perform_listener_operation( ListenerOperation& operation );
+				void perform_listener_operation( const ListenerOperation& operation );
+				// A function responsible of queuing a listener operation to be performed on the next epoch.
+				void queue_listener_operation( const ListenerOperation& operation );
+				// A function responsible of queuing the given operation for every pair of listener and event code in the given ranges, to be performed on the next epoch.
+				void queue_listener_operations( const AvailableListenerOperations operation , Listener* const* listeners , const size_t listener_count , const EventCode* codes , const size_t code_count );
+				/*
+					A function responsible of starting a new epoch, performing any pending listener operations
+					and updating the routing table. Must be called without holding the lock.
+				*/
+				void perform_pending_operations();
+				// A function responsible of updating the mailboxes of the registered listeners.
+				void update_mailboxes();
+				// A function responsible of waiting until every mailbox has delivered its events.
+				void wait_for_mailboxes();
+				// A function responsible of notifying the given listeners of an event, either directly or through their mailbox.
+				void notify_listeners( Event& event , const bool periodic , const DispatchClock::time_point& dispatch_time , Listener* const* listeners , ListenerMailbox* const* mailboxes , const unsigned int count , DispatchedEvent*& dispatched_event );
+				/*
+					A function responsible of notifying the registered listeners of the given event.
+					A triggered event is cleaned up once every listener has been notified, and is moved out if it has to be delivered on the thread pool.
+					A periodic event is copied if it has to be delivered on the thread pool.
+				*/
+				void dispatch_event( Event& event , const bool periodic );
 				// A function responsible of performing the operation of the event manager.
 				void actual_operate();
 				// A function responsible of performing cleanup.
@@ -198,13 +370,19 @@ namespace athena
 
 				// A function responsible of triggering an event with the given parameters and id code.
 				ATHENA_DLL void trigger_event( const Event& event );
+				/*
+					A function responsible of triggering the events in the range [begin,end), in order.
+					The events are queued in batches, with a single wakeup of the event manager thread.
+				*/
+				ATHENA_DLL void trigger_events( const Event* begin , const Event* end );
 				/*
 					A function responsible of registering an event to be triggered periodically.
 					The parameter at index 0 will be used to set the time that has passed since last trigger.
 					If the parameter is not the proper type or if there are no parameter the event manager will 
 					add the needed parameter.
+					If the event is already being triggered periodically, its period and mode are updated.
 				*/
-				ATHENA_DLL void trigger_event_periodically( Event& event , const utility::TimerValueType& period );
+				ATHENA_DLL void trigger_event_periodically( Event& event , const utility::TimerValueType& period , const PeriodicEventMode mode = FixedRate );
 				// A function responsible of unregistering an event from being triggered periodically.
 				ATHENA_DLL void stop_triggerring_event_periodically( const EventCode& code );
 				// A function responsible of registering a listener for notification of the specified event code.
@@ -220,6 +398,110 @@ namespace athena
 				ATHENA_DLL void unregister_event( Listener* listener , const EventCode& code );
 				// A function responsible of unregistering a listener from notification of all events.
 				ATHENA_DLL void unregister_all_events( Listener* listener );
+				// A function responsible of registering a listener for notification of the event codes in the range [begin,end), with a single queue operation.
+				ATHENA_DLL void register_events( Listener* listener , const EventCode* begin , const EventCode* end );
+				// A function responsible of registering the listeners in the range [begin,end) for notification of the specified event code, with a single queue operation.
+				ATHENA_DLL void register_listeners( Listener* const* begin , Listener* const* end , const EventCode& code );
+				// A function responsible of unregistering a listener from notification of the event codes in the range [begin,end), with a single queue operation.
+				ATHENA_DLL void unregister_events( Listener* listener , const EventCode* begin , const EventCode* end );
+				// A function responsible of unregistering the listeners in the range [begin,end) from notification of all events, with a single queue operation.
+				ATHENA_DLL void unregister_listeners( Listener* const* begin , Listener* const* end );
+				// A function responsible of setting the capacity of the event queue. The new capacity is used the next time the event system is started.
+				ATHENA_DLL void event_queue_capacity( const size_t capacity );
+				// A function responsible of setting the overflow policy of the event queue. The new policy is used the next time the event system is started.
+				ATHENA_DLL void event_queue_overflow_policy( const EventQueueOverflowPolicy policy );
+				/*
+					A function responsible of setting whether thread-safe listeners should be notified on the thread pool.
+					Parallel dispatch only takes effect if the thread pool has been started.
+				*/
+				ATHENA_DLL void parallel_dispatch( const bool value );
+				/*
+					A function responsible of assigning the given priority class to the given range of event codes.
+					Later assignments take precedence over earlier ones. Returns false if no more ranges can be assigned.
+				*/
+				ATHENA_DLL bool event_priority( const EventCode& first , const EventCode& last , const EventPriority priority );
+				// A function responsible of assigning the given priority class to the given event code.
+				ATHENA_DLL bool event_priority( const EventCode& code , const EventPriority priority );
+				// A function responsible of setting the maximum amount of events the lane of the given priority class dispatches on every round.
+				ATHENA_DLL void event_lane_weight( const EventPriority priority , const unsigned int weight );
+				/*
+					A function responsible of setting the coalescing policy of the given event code.
+					Should be set before events of the code are triggered. Returns false if no more codes can be given a policy.
+				*/
+				ATHENA_DLL bool event_coalescing_policy( const EventCode& code , const EventCoalescingPolicy policy );
+				/*
+					A function responsible of starting the recording of the triggered events to the given file, which is truncated.
+					Any recording in progress is stopped first. Returns false if the file cannot be opened.
+				*/
+				ATHENA_DLL bool start_recording( const std::string& filename );
+				// A function responsible of stopping the recording of the triggered events.
+				ATHENA_DLL void stop_recording();
+				/*
+					A function responsible of starting the replay of the given event log with the given mode.
+					Any replay in progress is stopped first. Returns false if the file is not a valid event log.
+				*/
+				ATHENA_DLL bool start_replay( const std::string& filename , const EventReplayMode mode = FastReplay );
+				// A function responsible of stopping the replay of the event log. Events that have already been queued are still dispatched.
+				ATHENA_DLL void stop_replay();
+
+
+				// A function returning the capacity of the event queue that is used when the event system is started.
+				ATHENA_DLL size_t event_queue_capacity();
+				// A function returning the overflow policy of the event queue that is used when the event system is started.
+				ATHENA_DLL EventQueueOverflowPolicy event_queue_overflow_policy();
+				// A function returning the amount of events that have been dropped due to the overflow policy of the event queue.
+				ATHENA_DLL unsigned long long dropped_event_count() const;
+				// A function returning whether thread-safe listeners should be notified on the thread pool.
+				ATHENA_DLL bool parallel_dispatch();
+				// A function returning the priority class of the given event code.
+				ATHENA_DLL EventPriority event_priority( const EventCode& code ) const;
+				// A function returning the maximum amount of events the lane of the given priority class dispatches on every round.
+				ATHENA_DLL unsigned int event_lane_weight( const EventPriority priority ) const;
+				// A function returning the approximate amount of events that are queued in the lane of the given priority class.
+				ATHENA_DLL size_t event_lane_depth( const EventPriority priority ) const;
+				// A function returning the histogram of the time the events have waited in the lane of the given priority class, in microseconds.
+				ATHENA_DLL const utility::Histogram& event_lane_wait_time( const EventPriority priority ) const;
+				// A function returning the coalescing policy of the given event code.
+				ATHENA_DLL EventCoalescingPolicy event_coalescing_policy( const EventCode& code ) const;
+				// A function returning the amount of events that have been merged into queued events instead of being queued.
+				ATHENA_DLL unsigned long long coalesced_event_count() const;
+				// A function returning whether the triggered events are being recorded.
+				ATHENA_DLL bool recording() const;
+				// A function returning the amount of events that have been recorded since the recording started.
+				ATHENA_DLL unsigned long long recorded_event_count() const;
+				// A function returning whether an event log is being replayed, which stops once every event of the log has been dispatched.
+				ATHENA_DLL bool replaying() const;
+				/*
+					A function responsible of copying the dispatch latency histogram of the given listener, in microseconds.
+					Returns false if the listener has no mailbox.
+				*/
+				ATHENA_DLL bool dispatch_latency( Listener* listener , utility::Histogram& histogram );
+
+				#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+					// A function responsible of setting the time a listener may take to handle an event before it is reported, in microseconds. Zero (0) disables the reports.
+					ATHENA_DLL void handler_budget( const unsigned long long microseconds );
+					/*
+						A function responsible of writing the statistics of the event codes, the listeners and the lanes as a JSON object.
+						Returns false if the stream is invalid.
+					*/
+					ATHENA_DLL bool dump_statistics( std::ostream* stream );
+
+
+					// A function returning the time a listener may take to handle an event before it is reported, in microseconds.
+					ATHENA_DLL unsigned long long handler_budget() const;
+					/*
+						A function responsible of copying the dispatch statistics of the given event code.
+						Returns false if no event of the code has been dispatched.
+					*/
+					ATHENA_DLL bool event_statistics( const EventCode& code , EventCodeStatistics& statistics ) const;
+					/*
+						A function responsible of copying the handler time histogram of the given listener, in microseconds, along with
+						the amount of times the listener has exceeded the handler budget. Returns false if the listener has no mailbox.
+					*/
+					ATHENA_DLL bool listener_statistics( Listener* listener , utility::Histogram& handler_time , unsigned long long& slow_handlers );
+
+				#endif /* ATHENA_EVENTMANAGER_STATISTICS */
 
 				#ifdef ATHENA_EVENTMANAGER_SINGLETHREADED
 
@@ -13,6 +13,126 @@ namespace athena
 	namespace core
 	{
 
+		// A function returning the amount of events that have been dropped due to the overflow policy of the event queue.
+		inline unsigned long long EventManager::dropped_event_count() const
+		{
+			return m_event_queue.dropped();
+		}
+
+
+		/*
+			A function responsible of assigning the given priority class to the given range of event codes.
+			Later assignments take precedence over earlier ones. Returns false if no more ranges can be assigned.
+		*/
+		inline bool EventManager::event_priority( const EventCode& first , const EventCode& last , const EventPriority priority )
+		{
+			return m_event_queue.priority(first,last,priority);
+		}
+
+		// A function responsible of assigning the given priority class to the given event code.
+		inline bool EventManager::event_priority( const EventCode& code , const EventPriority priority )
+		{
+			return m_event_queue.priority(code,code,priority);
+		}
+
+		// A function responsible of setting the maximum amount of events the lane of the given priority class dispatches on every round.
+		inline void EventManager::event_lane_weight( const EventPriority priority , const unsigned int weight )
+		{
+			m_event_queue.weight(priority,weight);
+		}
+
+		/*
+			A function responsible of setting the coalescing policy of the given event code.
+			Should be set before events of the code are triggered. Returns false if no more codes can be given a policy.
+		*/
+		inline bool EventManager::event_coalescing_policy( const EventCode& code , const EventCoalescingPolicy policy )
+		{
+			return m_event_coalescer.policy(code,policy);
+		}
+
+
+		// A function returning the priority class of the given event code.
+		inline EventPriority EventManager::event_priority( const EventCode& code ) const
+		{
+			return m_event_queue.priority(code);
+		}
+
+		// A function returning the maximum amount of events the lane of the given priority class dispatches on every round.
+		inline unsigned int EventManager::event_lane_weight( const EventPriority priority ) const
+		{
+			return m_event_queue.weight(priority);
+		}
+
+		// A function returning the approximate amount of events that are queued in the lane of the given priority class.
+		inline size_t EventManager::event_lane_depth( const EventPriority priority ) const
+		{
+			return m_event_queue.depth(priority);
+		}
+
+		// A function returning the histogram of the time the events have waited in the lane of the given priority class, in microseconds.
+		inline const utility::Histogram& EventManager::event_lane_wait_time( const EventPriority priority ) const
+		{
+			return m_event_queue.wait_time(priority);
+		}
+
+		// A function returning the coalescing policy of the given event code.
+		inline EventCoalescingPolicy EventManager::event_coalescing_policy( const EventCode& code ) const
+		{
+			return m_event_coalescer.policy(code);
+		}
+
+		// A function returning the amount of events that have been merged into queued events instead of being queued.
+		inline unsigned long long EventManager::coalesced_event_count() const
+		{
+			return m_event_coalescer.coalesced();
+		}
+
+		// A function returning whether the triggered events are being recorded.
+		inline bool EventManager::recording() const
+		{
+			return m_event_recorder.recording();
+		}
+
+		// A function returning the amount of events that have been recorded since the recording started.
+		inline unsigned long long EventManager::recorded_event_count() const
+		{
+			return m_event_recorder.recorded();
+		}
+
+		// A function returning whether an event log is being replayed, which stops once every event of the log has been dispatched.
+		inline bool EventManager::replaying() const
+		{
+			return m_replaying.load(std::memory_order_acquire);
+		}
+
+
+		#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+			// A function responsible of setting the time a listener may take to handle an event before it is reported, in microseconds. Zero (0) disables the reports.
+			inline void EventManager::handler_budget( const unsigned long long microseconds )
+			{
+				m_statistics.handler_budget(microseconds);
+			}
+
+
+			// A function returning the time a listener may take to handle an event before it is reported, in microseconds.
+			inline unsigned long long EventManager::handler_budget() const
+			{
+				return m_statistics.handler_budget();
+			}
+
+			/*
+				A function responsible of copying the dispatch statistics of the given event code.
+				Returns false if no event of the code has been dispatched.
+			*/
+			inline bool EventManager::event_statistics( const EventCode& code , EventCodeStatistics& statistics ) const
+			{
+				return m_statistics.code_statistics(code,statistics);
+			}
+
+		#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+
 		#ifdef ATHENA_EVENTMANAGER_SINGLETHREADED
 
 			// A function responsible of performing the operation of the manager if single-threaded mode is enabled.
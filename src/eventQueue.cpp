@@ -0,0 +1,404 @@
+#include "eventQueue.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of moving an event to the ring buffer. Returns false if the ring buffer is full.
+		bool EventQueue::push_ring( Event& event )
+		{
+			bool return_value = false;
+
+
+			if ( m_slots != NULL )
+			{
+				size_t position = m_tail.load(std::memory_order_relaxed);
+				EventQueueSlot* slot = NULL;
+				bool done = false;
+
+
+				while ( !done )
+				{
+					slot = &m_slots[position & m_mask];
+
+					size_t sequence = slot->m_sequence.load(std::memory_order_acquire);
+					ptrdiff_t difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position);
+
+
+					// If the slot is free for this position, try to claim it.
+					if ( difference == 0 )
+					{
+						if ( m_tail.compare_exchange_weak(position,position+1,std::memory_order_relaxed) )
+						{
+							return_value = true;
+							done = true;
+						}
+					}
+					else if ( difference < 0 ) // If the slot still holds the event of the previous lap, the ring buffer is full.
+						done = true;
+					else // If another producer claimed the position, reload the tail.
+						position = m_tail.load(std::memory_order_relaxed);
+				}
+
+				// If a slot was claimed, store the event and publish it to the consumer.
+				if ( return_value )
+				{
+					slot->m_event = std::move(event);
+					slot->m_sequence.store(position+1,std::memory_order_release);
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of moving a batch of events to consecutive slots of the ring buffer. Returns the amount of events that were pushed.
+		size_t EventQueue::push_ring( Event* events , const size_t count )
+		{
+			size_t return_value = 0;
+
+
+			if ( m_slots != NULL  &&  count > 0 )
+			{
+				size_t position = m_tail.load(std::memory_order_relaxed);
+				bool done = false;
+
+
+				while ( !done )
+				{
+					// The head is read after the tail, so the amount of free slots can only be underestimated.
+					ptrdiff_t used = static_cast<ptrdiff_t>(position) - static_cast<ptrdiff_t>(m_head.load(std::memory_order_acquire));
+
+
+					// If the events of other producers have been popped since the tail was read, reload the tail.
+					if ( used < 0 )
+						position = m_tail.load(std::memory_order_relaxed);
+					else
+					{
+						size_t available = ( static_cast<size_t>(used) < m_capacity  ?  m_capacity - static_cast<size_t>(used) : 0 );
+
+
+						return_value = ( count < available  ?  count : available );
+
+						// If the ring buffer is full, or the range was claimed, exit the loop.
+						if ( return_value == 0  ||  m_tail.compare_exchange_weak(position,position+return_value,std::memory_order_relaxed) )
+							done = true;
+					}
+				}
+
+				// Store the events in the claimed range and publish them to the consumer in order.
+				for ( size_t i = 0;  i < return_value;  ++i )
+				{
+					EventQueueSlot* slot = &m_slots[( position + i ) & m_mask];
+
+
+					// A thread that has claimed the head may not have released the slot yet.
+					while ( slot->m_sequence.load(std::memory_order_acquire) != position + i )
+						std::this_thread::yield();
+
+					slot->m_event = std::move(events[i]);
+					slot->m_sequence.store(position+i+1,std::memory_order_release);
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of moving the oldest event out of the ring buffer. Returns false if the ring buffer is empty.
+		bool EventQueue::pop_ring( Event& event )
+		{
+			bool return_value = false;
+
+
+			if ( m_slots != NULL )
+			{
+				size_t position = m_head.load(std::memory_order_relaxed);
+				EventQueueSlot* slot = NULL;
+				bool done = false;
+
+
+				/*
+					The head is claimed with a compare and exchange since producers that are
+					dropping the oldest event are also popping from the ring buffer.
+				*/
+				while ( !done )
+				{
+					slot = &m_slots[position & m_mask];
+
+					size_t sequence = slot->m_sequence.load(std::memory_order_acquire);
+					ptrdiff_t difference = static_cast<ptrdiff_t>(sequence) - static_cast<ptrdiff_t>(position+1);
+
+
+					// If the slot holds a published event for this position, try to claim it.
+					if ( difference == 0 )
+					{
+						if ( m_head.compare_exchange_weak(position,position+1,std::memory_order_relaxed) )
+						{
+							return_value = true;
+							done = true;
+						}
+					}
+					else if ( difference < 0 ) // If the slot has not been published yet, the ring buffer is empty.
+						done = true;
+					else // If the position was claimed by another thread, reload the head.
+						position = m_head.load(std::memory_order_relaxed);
+				}
+
+				// If a slot was claimed, get the event and release the slot for the next lap.
+				if ( return_value )
+				{
+					event = std::move(slot->m_event);
+					slot->m_sequence.store(position+m_mask+1,std::memory_order_release);
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of moving an event to the overflow list.
+		void EventQueue::push_overflow( Event& event )
+		{
+			m_overflow_lock.lock();
+			m_overflow.push_back(std::move(event));
+			m_overflow_size.store(m_overflow.size(),std::memory_order_release);
+			m_overflow_lock.unlock();
+		}
+
+		// A function responsible of moving the oldest event out of the overflow list. Returns false if the list is empty.
+		bool EventQueue::pop_overflow( Event& event )
+		{
+			bool return_value = false;
+
+
+			m_overflow_lock.lock();
+
+			if ( m_overflow.size() > 0 )
+			{
+				event = std::move(m_overflow.front());
+				m_overflow.pop_front();
+				return_value = true;
+				m_overflow_size.store(m_overflow.size(),std::memory_order_release);
+			}
+
+			m_overflow_lock.unlock();
+
+
+			return return_value;
+		}
+
+		// A function responsible of releasing the memory of the ring buffer.
+		void EventQueue::release()
+		{
+			delete[] m_slots;
+			m_slots = NULL;
+			m_capacity = 0;
+			m_mask = 0;
+			m_tail.store(0,std::memory_order_relaxed);
+			m_head.store(0,std::memory_order_relaxed);
+		}
+
+
+		// The constructor of the class.
+		EventQueue::EventQueue() :
+			m_slots(NULL) ,
+			m_capacity(0) ,
+			m_mask(0) ,
+			m_policy(GrowOnOverflow) ,
+			m_consumer(std::thread::id()) ,
+			m_tail(0) ,
+			m_head(0) ,
+			m_overflow(0) ,
+			m_overflow_size(0) ,
+			m_overflow_lock() ,
+			m_dropped(0)
+		{
+		}
+
+		// The destructor of the class.
+		EventQueue::~EventQueue()
+		{
+			clear();
+			release();
+		}
+
+
+		/*
+			A function responsible of (re)allocating the ring buffer with the given capacity and policy.
+			The capacity is rounded up to the next power of two (2). Any queued events are cleaned up.
+			Must not be called while other threads are using the queue.
+		*/
+		bool EventQueue::initialise( const size_t capacity , const EventQueueOverflowPolicy policy )
+		{
+			size_t actual_capacity = 2;
+			size_t requested_capacity = ( capacity > 0  ?  capacity : s_DEFAULT_CAPACITY );
+			bool return_value = true;
+
+
+			// Round the capacity up to the next power of two (2).
+			while ( actual_capacity < requested_capacity )
+				actual_capacity <<= 1;
+
+			clear();
+			m_policy = policy;
+			m_dropped.store(0,std::memory_order_relaxed);
+
+			// If the capacity has changed, reallocate the ring buffer.
+			if ( actual_capacity != m_capacity )
+			{
+				release();
+				m_slots = new (std::nothrow) EventQueueSlot[actual_capacity];
+
+				if ( m_slots != NULL )
+				{
+					m_capacity = actual_capacity;
+					m_mask = actual_capacity - 1;
+				}
+				else
+					return_value = false;
+			}
+
+			// Reset the positions and mark every slot as free for the first lap.
+			if ( m_slots != NULL )
+			{
+				for ( size_t i = 0;  i < m_capacity;  ++i )
+				{
+					m_slots[i].m_event.clear();
+					m_slots[i].m_sequence.store(i,std::memory_order_relaxed);
+				}
+
+				m_tail.store(0,std::memory_order_relaxed);
+				m_head.store(0,std::memory_order_release);
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of pushing an event to the queue. The event is moved into the queue.
+		void EventQueue::push( Event& event )
+		{
+			bool done = false;
+
+
+			// While the overflow list is in use, keep pushing to it in order to preserve the order of the events.
+			if ( m_slots == NULL  ||  m_overflow_size.load(std::memory_order_acquire) > 0 )
+			{
+				push_overflow(event);
+				done = true;
+			}
+
+			while ( !done )
+			{
+				if ( push_ring(event) )
+					done = true;
+				else
+				{
+					// Depending on the overflow policy perform the necessary actions.
+					switch ( m_policy )
+					{
+						// If the producer should wait for the consumer to free a slot.
+						case BlockOnOverflow:
+
+							// The consumer cannot wait on itself, so spill the event instead.
+							if ( m_consumer.load(std::memory_order_relaxed) == std::this_thread::get_id() )
+							{
+								push_overflow(event);
+								done = true;
+							}
+							else
+								std::this_thread::yield();
+
+							break;
+
+						// If the oldest event should be discarded to make room.
+						case DropOldestOnOverflow:
+							{
+								Event oldest;
+
+
+								if ( pop_ring(oldest) )
+								{
+									// Call the specified callback function that is responsible of performing cleanup for the parameters of the event.
+									oldest.cleanup();
+									m_dropped.fetch_add(1,std::memory_order_relaxed);
+								}
+							}
+
+							break;
+
+						// If the event should be spilled to the overflow list.
+						case GrowOnOverflow:
+
+							push_overflow(event);
+							done = true;
+							break;
+					}
+				}
+			}
+		}
+
+		/*
+			A function responsible of pushing a batch of events to the queue, claiming a single range of slots of the ring buffer.
+			Returns the amount of events that were queued, which are moved into the queue. The overflow policy is not
+			applied, so the remaining events have to be pushed one at a time, after the consumer has been notified.
+		*/
+		size_t EventQueue::push( Event* events , const size_t count )
+		{
+			size_t return_value = 0;
+
+
+			// While the overflow list is in use, keep pushing to it in order to preserve the order of the events.
+			if ( m_slots == NULL  ||  m_overflow_size.load(std::memory_order_acquire) > 0 )
+			{
+				m_overflow_lock.lock();
+
+				for ( size_t i = 0;  i < count;  ++i )
+					m_overflow.push_back(std::move(events[i]));
+
+				m_overflow_size.store(m_overflow.size(),std::memory_order_release);
+				m_overflow_lock.unlock();
+				return_value = count;
+			}
+			else
+				return_value = push_ring(events,count);
+
+
+			return return_value;
+		}
+
+		// A function responsible of moving the oldest event out of the queue. Returns false if the queue is empty.
+		bool EventQueue::pop( Event& event )
+		{
+			bool return_value = pop_ring(event);
+
+
+			// The overflow list is only drained once the ring buffer is empty.
+			if ( !return_value  &&  m_overflow_size.load(std::memory_order_acquire) > 0 )
+				return_value = pop_overflow(event);
+
+
+			return return_value;
+		}
+
+		// A function responsible of cleaning up any queued events.
+		void EventQueue::clear()
+		{
+			Event event;
+
+
+			while ( pop(event) )
+			{
+				// Call the specified callback function that is responsible of performing cleanup for the parameters of the event.
+				event.cleanup();
+			}
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
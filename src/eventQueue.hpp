@@ -0,0 +1,165 @@
+#ifndef ATHENA_CORE_EVENTQUEUE_HPP
+#define ATHENA_CORE_EVENTQUEUE_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <deque>
+#include "event.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			An enumeration holding the possible actions the event queue can take
+			when an event is pushed while the queue is full.
+		*/
+		enum EventQueueOverflowPolicy
+		{
+			BlockOnOverflow = 0 ,
+			DropOldestOnOverflow ,
+			GrowOnOverflow
+		};
+
+
+		/*
+			A bounded lock-free multi-producer single-consumer queue that is used by the event manager.
+			The queue is a ring buffer of sequenced slots that hold the events by value, so queueing an event
+			only moves it and requires no allocation. Producers only contend on a single atomic
+			counter and never on a lock. When the ring is full the configured overflow policy is applied:
+			BlockOnOverflow makes the producer yield until the consumer frees a slot, DropOldestOnOverflow
+			discards (and cleans up) the oldest queued event and GrowOnOverflow spills the event to an
+			unbounded overflow list that is drained after the ring.
+			The consumer thread never blocks on its own queue. A blocking push from the consumer
+			thread is treated as GrowOnOverflow in order to avoid a deadlock.
+		*/
+		class EventQueue
+		{
+			private:
+
+				/*
+					A struct representing a slot of the ring buffer. The sequence of the slot
+					denotes whether the slot is available for writing or for reading.
+				*/
+				struct EventQueueSlot
+				{
+					std::atomic<size_t> m_sequence;
+					Event m_event;
+				};
+
+
+				// The assumed size of a cache line, used to keep the producer and consumer counters apart.
+				static const size_t s_CACHE_LINE_SIZE = 64;
+				// The capacity that is used when a capacity of zero (0) is requested.
+				static const size_t s_DEFAULT_CAPACITY = 4096;
+
+
+				// The slots of the ring buffer.
+				EventQueueSlot* m_slots;
+				// The capacity of the ring buffer. Always a power of two (2).
+				size_t m_capacity;
+				// The mask that is used to map a position to a slot.
+				size_t m_mask;
+				// The policy that is applied when the ring buffer is full.
+				EventQueueOverflowPolicy m_policy;
+				// The id of the thread that consumes the queue.
+				std::atomic<std::thread::id> m_consumer;
+				// Padding that separates the producer counter from the read-mostly members.
+				char m_tail_padding[s_CACHE_LINE_SIZE];
+				// The position that the next event will be pushed to.
+				std::atomic<size_t> m_tail;
+				// Padding that separates the producer counter from the consumer counter.
+				char m_head_padding[s_CACHE_LINE_SIZE];
+				// The position that the next event will be popped from.
+				std::atomic<size_t> m_head;
+				// Padding that separates the consumer counter from the overflow members.
+				char m_overflow_padding[s_CACHE_LINE_SIZE];
+				// The list holding any events that did not fit in the ring buffer.
+				std::deque<Event> m_overflow;
+				// The amount of events in the overflow list.
+				std::atomic<size_t> m_overflow_size;
+				// A lock that is used to handle concurrency issues regarding the overflow list.
+				std::mutex m_overflow_lock;
+				// The amount of events that have been dropped due to the overflow policy.
+				std::atomic<unsigned long long> m_dropped;
+
+
+				// The copy constructor is not available.
+				EventQueue( const EventQueue& );
+				// The assignment operator is not available.
+				EventQueue& operator=( const EventQueue& );
+
+
+				// A function responsible of moving an event to the ring buffer. Returns false if the ring buffer is full.
+				bool push_ring( Event& event );
+				// A function responsible of moving a batch of events to consecutive slots of the ring buffer. Returns the amount of events that were pushed.
+				size_t push_ring( Event* events , const size_t count );
+				// A function responsible of moving the oldest event out of the ring buffer. Returns false if the ring buffer is empty.
+				bool pop_ring( Event& event );
+				// A function responsible of moving an event to the overflow list.
+				void push_overflow( Event& event );
+				// A function responsible of moving the oldest event out of the overflow list. Returns false if the list is empty.
+				bool pop_overflow( Event& event );
+				// A function responsible of releasing the memory of the ring buffer.
+				void release();
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL EventQueue();
+				// The destructor of the class.
+				ATHENA_DLL ~EventQueue();
+
+
+				/*
+					A function responsible of (re)allocating the ring buffer with the given capacity and policy.
+					The capacity is rounded up to the next power of two (2). Any queued events are cleaned up.
+					Must not be called while other threads are using the queue.
+				*/
+				ATHENA_DLL bool initialise( const size_t capacity , const EventQueueOverflowPolicy policy );
+				// A function responsible of setting the thread that consumes the queue.
+				ATHENA_DLL void consumer( const std::thread::id& id );
+				// A function responsible of pushing an event to the queue. The event is moved into the queue.
+				ATHENA_DLL void push( Event& event );
+				/*
+					A function responsible of pushing a batch of events to the queue, claiming a single range of slots of the ring buffer.
+					Returns the amount of events that were queued, which are moved into the queue. The overflow policy is not
+					applied, so the remaining events have to be pushed one at a time, after the consumer has been notified.
+				*/
+				ATHENA_DLL size_t push( Event* events , const size_t count );
+				// A function responsible of moving the oldest event out of the queue. Returns false if the queue is empty.
+				ATHENA_DLL bool pop( Event& event );
+				// A function responsible of cleaning up any queued events.
+				ATHENA_DLL void clear();
+
+
+				// A function returning whether the queue is empty.
+				ATHENA_DLL bool empty() const;
+				// A function returning the approximate amount of queued events.
+				ATHENA_DLL size_t size() const;
+				// A function returning the capacity of the ring buffer.
+				ATHENA_DLL size_t capacity() const;
+				// A function returning the overflow policy of the queue.
+				ATHENA_DLL EventQueueOverflowPolicy policy() const;
+				// A function returning the amount of events that have been dropped due to the overflow policy.
+				ATHENA_DLL unsigned long long dropped() const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "eventQueue.inl"
+
+
+
+#endif /* ATHENA_CORE_EVENTQUEUE_HPP */
\ No newline at end of file
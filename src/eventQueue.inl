@@ -0,0 +1,80 @@
+#ifndef ATHENA_CORE_EVENTQUEUE_INL
+#define ATHENA_CORE_EVENTQUEUE_INL
+
+#ifndef ATHENA_CORE_EVENTQUEUE_HPP
+	#error "eventQueue.hpp must be included before eventQueue.inl"
+#endif /* ATHENA_CORE_EVENTQUEUE_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of setting the thread that consumes the queue.
+		inline void EventQueue::consumer( const std::thread::id& id )
+		{
+			m_consumer.store(id,std::memory_order_relaxed);
+		}
+
+
+		// A function returning whether the queue is empty.
+		inline bool EventQueue::empty() const
+		{
+			bool return_value = true;
+
+
+			if ( m_slots != NULL )
+			{
+				size_t position = m_head.load(std::memory_order_relaxed);
+
+
+				// The slot at the head of the queue holds an event if its sequence is one (1) ahead of the position.
+				return_value = ( m_slots[position & m_mask].m_sequence.load(std::memory_order_acquire) != position + 1 );
+			}
+
+			if ( return_value )
+				return_value = ( m_overflow_size.load(std::memory_order_acquire) == 0 );
+
+
+			return return_value;
+		}
+
+		// A function returning the approximate amount of queued events.
+		inline size_t EventQueue::size() const
+		{
+			size_t tail = m_tail.load(std::memory_order_relaxed);
+			size_t head = m_head.load(std::memory_order_relaxed);
+
+
+			// The counters are read separately, so the head may have moved past the tail that was read.
+			return ( tail > head  ?  tail - head : 0 ) + m_overflow_size.load(std::memory_order_relaxed);
+		}
+
+		// A function returning the capacity of the ring buffer.
+		inline size_t EventQueue::capacity() const
+		{
+			return m_capacity;
+		}
+
+		// A function returning the overflow policy of the queue.
+		inline EventQueueOverflowPolicy EventQueue::policy() const
+		{
+			return m_policy;
+		}
+
+		// A function returning the amount of events that have been dropped due to the overflow policy.
+		inline unsigned long long EventQueue::dropped() const
+		{
+			return m_dropped.load(std::memory_order_relaxed);
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_EVENTQUEUE_INL */
\ No newline at end of file
@@ -0,0 +1,137 @@
+#include "eventRecorder.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the class.
+		EventRecorder::EventRecorder() :
+			m_stream() ,
+			m_buffer(0) ,
+			m_start_time() ,
+			m_lock() ,
+			m_recording(false) ,
+			m_recorded(0)
+		{
+		}
+
+		// The destructor of the class. Any buffered events are written to the file.
+		EventRecorder::~EventRecorder()
+		{
+			close();
+		}
+
+
+		// A function responsible of writing the buffer to the file.
+		void EventRecorder::flush()
+		{
+			if ( m_buffer.size() > 0 )
+			{
+				m_stream.write(&m_buffer[0],static_cast<std::streamsize>(m_buffer.size()));
+				m_buffer.clear();
+			}
+		}
+
+
+		/*
+			A function responsible of starting the recording of the events to the given file, which is truncated.
+			Any recording in progress is stopped first. Returns false if the file cannot be opened.
+		*/
+		bool EventRecorder::open( const std::string& filename )
+		{
+			unsigned int magic = s_MAGIC;
+			unsigned int version = s_VERSION;
+			bool return_value = false;
+
+
+			close();
+
+			m_lock.lock();
+			m_stream.open(filename.c_str(),std::ofstream::binary | std::ofstream::trunc);
+
+			if ( m_stream.is_open() )
+			{
+				m_buffer.reserve(s_FLUSH_SIZE + 256);
+				write(&magic,sizeof(magic));
+				write(&version,sizeof(version));
+				m_start_time = EventClock::now();
+				m_recorded.store(0,std::memory_order_relaxed);
+				m_recording.store(true,std::memory_order_release);
+				return_value = true;
+			}
+
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		// A function responsible of stopping the recording, writing any buffered events to the file.
+		void EventRecorder::close()
+		{
+			m_recording.store(false,std::memory_order_release);
+
+			m_lock.lock();
+
+			if ( m_stream.is_open() )
+			{
+				flush();
+				m_stream.close();
+			}
+
+			m_lock.unlock();
+		}
+
+		// A function responsible of recording an event.
+		void EventRecorder::record( const Event& event )
+		{
+			unsigned long long timestamp = 0;
+			EventCode code = event.code();
+			ListenerIDType initiator_id = event.initiator_id();
+			unsigned int parameter_count = event.parameter_count();
+
+
+			m_lock.lock();
+
+			// The recording may have been stopped after the caller checked whether events are being recorded.
+			if ( m_stream.is_open() )
+			{
+				// The time is taken while holding the lock, so the events of the log are in chronological order.
+				timestamp = static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(EventClock::now() - m_start_time).count());
+				write(&timestamp,sizeof(timestamp));
+				write(&code,sizeof(code));
+				write(&initiator_id,sizeof(initiator_id));
+				write(&parameter_count,sizeof(parameter_count));
+
+				for ( unsigned int i = 0;  i < parameter_count;  ++i )
+				{
+					const Parameter* parameter = event.parameter(i);
+					ParameterType parameter_type = parameter->type();
+					unsigned char type = 0;
+
+
+					// Pointers cannot be replayed, so they are recorded as NULL parameters.
+					if ( parameter_type == Pointer  ||  parameter->data() == NULL )
+						parameter_type = Null;
+
+					type = static_cast<unsigned char>(parameter_type);
+					write(&type,sizeof(type));
+					write(parameter->data(),Parameter::size(parameter_type));
+				}
+
+				if ( m_buffer.size() >= s_FLUSH_SIZE )
+					flush();
+
+				m_recorded.fetch_add(1,std::memory_order_relaxed);
+			}
+
+			m_lock.unlock();
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
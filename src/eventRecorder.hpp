@@ -0,0 +1,106 @@
+#ifndef ATHENA_CORE_EVENTRECORDER_HPP
+#define ATHENA_CORE_EVENTRECORDER_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <string>
+#include <fstream>
+#include <vector>
+#include "event.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A class that is used by the event manager in order to record the triggered events to a binary event log.
+			Every record holds the time the event was triggered, in microseconds since the recording started, the code
+			and the initiator id of the event and the values of its parameters. Parameters that are stored by reference
+			are recorded by value, while pointers are recorded as NULL parameters, since they cannot be replayed.
+			The log is written in the byte order of the platform, so it should be replayed on the same platform.
+			Events are encoded to a buffer which is written to the file once it fills up, so
+			recording an event usually costs an uncontended lock and a few copies.
+		*/
+		class EventRecorder
+		{
+			public:
+
+				// The identifier every event log starts with.
+				static const unsigned int s_MAGIC = 0x52485441;
+				// The version of the event log format.
+				static const unsigned int s_VERSION = 1;
+
+
+			private:
+
+				// The size the buffer may reach before it is written to the file.
+				static const size_t s_FLUSH_SIZE = 65536;
+
+
+				// The file the events are recorded to.
+				std::ofstream m_stream;
+				// The buffer holding the encoded events that have not been written to the file yet.
+				std::vector<char> m_buffer;
+				// The time the recording started.
+				EventClock::time_point m_start_time;
+				// A lock that is used to handle concurrency issues.
+				std::mutex m_lock;
+				// A variable holding whether events are being recorded.
+				std::atomic<bool> m_recording;
+				// The amount of events that have been recorded.
+				std::atomic<unsigned long long> m_recorded;
+
+
+				// The copy constructor is not available.
+				EventRecorder( const EventRecorder& );
+				// The assignment operator is not available.
+				EventRecorder& operator=( const EventRecorder& );
+
+
+				// A function responsible of appending the given bytes to the buffer.
+				void write( const void* data , const size_t size );
+				// A function responsible of writing the buffer to the file.
+				void flush();
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL EventRecorder();
+				// The destructor of the class. Any buffered events are written to the file.
+				ATHENA_DLL ~EventRecorder();
+
+
+				/*
+					A function responsible of starting the recording of the events to the given file, which is truncated.
+					Any recording in progress is stopped first. Returns false if the file cannot be opened.
+				*/
+				ATHENA_DLL bool open( const std::string& filename );
+				// A function responsible of stopping the recording, writing any buffered events to the file.
+				ATHENA_DLL void close();
+				// A function responsible of recording an event.
+				ATHENA_DLL void record( const Event& event );
+
+
+				// A function returning whether events are being recorded.
+				ATHENA_DLL bool recording() const;
+				// A function returning the amount of events that have been recorded since the recording started.
+				ATHENA_DLL unsigned long long recorded() const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "eventRecorder.inl"
+
+
+
+#endif /* ATHENA_CORE_EVENTRECORDER_HPP */
\ No newline at end of file
@@ -0,0 +1,44 @@
+#ifndef ATHENA_CORE_EVENTRECORDER_INL
+#define ATHENA_CORE_EVENTRECORDER_INL
+
+#ifndef ATHENA_CORE_EVENTRECORDER_HPP
+	#error "eventRecorder.hpp must be included before eventRecorder.inl"
+#endif /* ATHENA_CORE_EVENTRECORDER_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of appending the given bytes to the buffer.
+		inline void EventRecorder::write( const void* data , const size_t size )
+		{
+			const char* bytes = static_cast<const char*>(data);
+
+
+			m_buffer.insert(m_buffer.end(),bytes,bytes + size);
+		}
+
+
+		// A function returning whether events are being recorded.
+		inline bool EventRecorder::recording() const
+		{
+			return m_recording.load(std::memory_order_relaxed);
+		}
+
+		// A function returning the amount of events that have been recorded since the recording started.
+		inline unsigned long long EventRecorder::recorded() const
+		{
+			return m_recorded.load(std::memory_order_relaxed);
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_EVENTRECORDER_INL */
\ No newline at end of file
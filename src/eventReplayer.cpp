@@ -0,0 +1,144 @@
+#include "eventReplayer.hpp"
+#include "eventRecorder.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of reading the timestamp of the next event.
+		void EventReplayer::read_timestamp()
+		{
+			m_pending = read(&m_next_timestamp,sizeof(m_next_timestamp));
+		}
+
+
+		// The constructor of the class.
+		EventReplayer::EventReplayer() :
+			m_stream() ,
+			m_next_timestamp(0) ,
+			m_pending(false) ,
+			m_replayed(0)
+		{
+		}
+
+		// The destructor of the class.
+		EventReplayer::~EventReplayer()
+		{
+			close();
+		}
+
+
+		/*
+			A function responsible of opening the given event log. Any open event log is closed first.
+			Returns false if the file cannot be opened or is not an event log of a supported version.
+		*/
+		bool EventReplayer::open( const std::string& filename )
+		{
+			bool return_value = false;
+
+
+			close();
+			m_stream.open(filename.c_str(),std::ifstream::binary);
+
+			if ( m_stream.is_open() )
+			{
+				unsigned int magic = 0;
+				unsigned int version = 0;
+
+
+				if ( read(&magic,sizeof(magic))  &&  read(&version,sizeof(version))  &&  magic == EventRecorder::s_MAGIC  &&  version == EventRecorder::s_VERSION )
+				{
+					read_timestamp();
+					return_value = true;
+				}
+				else
+					close();
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of closing the event log.
+		void EventReplayer::close()
+		{
+			if ( m_stream.is_open() )
+				m_stream.close();
+
+			m_stream.clear();
+			m_next_timestamp = 0;
+			m_pending = false;
+			m_replayed = 0;
+		}
+
+		/*
+			A function responsible of reading the next event of the event log. Returns false if there are no events left
+			or the event log is corrupted, in which case the event log is closed.
+		*/
+		bool EventReplayer::pop( Event& event )
+		{
+			bool return_value = false;
+
+
+			if ( m_pending )
+			{
+				EventCode code = 0;
+				ListenerIDType initiator_id = 0;
+				unsigned int parameter_count = 0;
+
+
+				return_value = read(&code,sizeof(code))  &&  read(&initiator_id,sizeof(initiator_id))  &&  read(&parameter_count,sizeof(parameter_count));
+
+				if ( return_value )
+				{
+					event.clear();
+					event.code(code);
+					event.initiator_id(initiator_id);
+
+					for ( unsigned int i = 0;  i < parameter_count  &&  return_value;  ++i )
+					{
+						unsigned char type = 0;
+						ParameterValue value;
+
+
+						return_value = read(&type,sizeof(type))  &&  type <= Pointer;
+
+						if ( return_value )
+						{
+							ParameterType parameter_type = static_cast<ParameterType>(type);
+
+
+							return_value = read(&value,Parameter::size(parameter_type));
+
+							// Pointers cannot be replayed, so they are replayed as NULL parameters.
+							if ( parameter_type == Null  ||  parameter_type == Pointer )
+								event.parameter(i,Null,NULL);
+							else
+								event.parameter_value(i,parameter_type,&value);
+						}
+					}
+				}
+
+				if ( return_value )
+				{
+					++m_replayed;
+					read_timestamp();
+				}
+				else
+				{
+					event.clear();
+					close();
+				}
+			}
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
@@ -0,0 +1,99 @@
+#ifndef ATHENA_CORE_EVENTREPLAYER_HPP
+#define ATHENA_CORE_EVENTREPLAYER_HPP
+
+#include "definitions.hpp"
+#include <string>
+#include <fstream>
+#include "event.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// An enumeration containing the ways an event log can be replayed.
+		enum EventReplayMode
+		{
+			// The recorded events are triggered as fast as the event manager can dispatch them.
+			FastReplay = 0 ,
+			// The recorded events are triggered with the same timing they were recorded with.
+			RealTimeReplay
+		};
+
+
+		/*
+			A class that is used by the event manager in order to read the events of an event log that was written by an event recorder.
+			The events are read one at a time, so the event log does not have to fit in memory.
+		*/
+		class EventReplayer
+		{
+			private:
+
+				// The file the events are read from.
+				std::ifstream m_stream;
+				// The time the next event was triggered, in microseconds since the recording started.
+				unsigned long long m_next_timestamp;
+				// A variable holding whether there is an event left to read.
+				bool m_pending;
+				// The amount of events that have been read.
+				unsigned long long m_replayed;
+
+
+				// The copy constructor is not available.
+				EventReplayer( const EventReplayer& );
+				// The assignment operator is not available.
+				EventReplayer& operator=( const EventReplayer& );
+
+
+				// A function responsible of reading the given amount of bytes from the file. Returns false if the file ended.
+				bool read( void* data , const size_t size );
+				// A function responsible of reading the timestamp of the next event.
+				void read_timestamp();
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL EventReplayer();
+				// The destructor of the class.
+				ATHENA_DLL ~EventReplayer();
+
+
+				/*
+					A function responsible of opening the given event log. Any open event log is closed first.
+					Returns false if the file cannot be opened or is not an event log of a supported version.
+				*/
+				ATHENA_DLL bool open( const std::string& filename );
+				// A function responsible of closing the event log.
+				ATHENA_DLL void close();
+				/*
+					A function responsible of reading the next event of the event log. Returns false if there are no events left
+					or the event log is corrupted, in which case the event log is closed.
+				*/
+				ATHENA_DLL bool pop( Event& event );
+
+
+				/*
+					A function returning whether there is an event left to read. If there is, the time the
+					event was triggered, in microseconds since the recording started, is returned through the parameter.
+				*/
+				ATHENA_DLL bool peek( unsigned long long& timestamp ) const;
+				// A function returning whether there is an event left to read.
+				ATHENA_DLL bool pending() const;
+				// A function returning the amount of events that have been read since the event log was opened.
+				ATHENA_DLL unsigned long long replayed() const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "eventReplayer.inl"
+
+
+
+#endif /* ATHENA_CORE_EVENTREPLAYER_HPP */
\ No newline at end of file
@@ -0,0 +1,57 @@
+#ifndef ATHENA_CORE_EVENTREPLAYER_INL
+#define ATHENA_CORE_EVENTREPLAYER_INL
+
+#ifndef ATHENA_CORE_EVENTREPLAYER_HPP
+	#error "eventReplayer.hpp must be included before eventReplayer.inl"
+#endif /* ATHENA_CORE_EVENTREPLAYER_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of reading the given amount of bytes from the file. Returns false if the file ended.
+		inline bool EventReplayer::read( void* data , const size_t size )
+		{
+			m_stream.read(static_cast<char*>(data),static_cast<std::streamsize>(size));
+
+
+			return ( static_cast<size_t>(m_stream.gcount()) == size );
+		}
+
+
+		/*
+			A function returning whether there is an event left to read. If there is, the time the
+			event was triggered, in microseconds since the recording started, is returned through the parameter.
+		*/
+		inline bool EventReplayer::peek( unsigned long long& timestamp ) const
+		{
+			if ( m_pending )
+				timestamp = m_next_timestamp;
+
+
+			return m_pending;
+		}
+
+		// A function returning whether there is an event left to read.
+		inline bool EventReplayer::pending() const
+		{
+			return m_pending;
+		}
+
+		// A function returning the amount of events that have been read since the event log was opened.
+		inline unsigned long long EventReplayer::replayed() const
+		{
+			return m_replayed;
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_EVENTREPLAYER_INL */
\ No newline at end of file
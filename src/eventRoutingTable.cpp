@@ -0,0 +1,140 @@
+#include "eventRoutingTable.hpp"
+#include "eventCodes.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the class.
+		EventRoutingTable::EventRoutingTable() :
+			m_routes(0) ,
+			m_listeners(0,NULL) ,
+			m_mailboxes(0,NULL) ,
+			m_mask(0) ,
+			m_shift(0)
+		{
+			m_all_route.m_code = EVENT_ALL;
+			m_all_route.m_offset = 0;
+			m_all_route.m_count = 0;
+		}
+
+		// The destructor of the class.
+		EventRoutingTable::~EventRoutingTable()
+		{
+		}
+
+
+		// A function responsible of compiling the table from the given registry of events and listeners, along with the mailboxes of the listeners.
+		void EventRoutingTable::build( const std::map<EventCode,std::vector<Listener*> >& event_list , const std::map<Listener*,ListenerMailbox*>& mailbox_list )
+		{
+			unsigned int route_count = 0;
+			unsigned int listener_count = 0;
+			unsigned int size = s_MIN_ROUTES;
+			unsigned int bits = 4;
+
+
+			// Count the routes and the listeners that will be stored.
+			for (
+					std::map<EventCode,std::vector<Listener*> >::const_iterator event_iterator = event_list.begin();
+					event_iterator != event_list.end();
+					++event_iterator
+				)
+			{
+				if ( event_iterator->second.size() > 0 )
+				{
+					if ( event_iterator->first != EVENT_ALL )
+						++route_count;
+
+					listener_count += event_iterator->second.size();
+				}
+			}
+
+			// Keep the load factor of the hash table at or below one half (1/2).
+			while ( size < route_count*2 )
+			{
+				size <<= 1;
+				++bits;
+			}
+
+			clear();
+			m_routes.resize(size);
+			m_listeners.reserve(listener_count);
+			m_mailboxes.reserve(listener_count);
+			m_mask = size - 1;
+			m_shift = 32 - bits;
+
+			for ( unsigned int i = 0;  i < size;  ++i )
+			{
+				m_routes[i].m_code = EVENT_ALL;
+				m_routes[i].m_offset = 0;
+				m_routes[i].m_count = 0;
+			}
+
+			// For every event of the registry.
+			for (
+					std::map<EventCode,std::vector<Listener*> >::const_iterator event_iterator = event_list.begin();
+					event_iterator != event_list.end();
+					++event_iterator
+				)
+			{
+				if ( event_iterator->second.size() > 0 )
+				{
+					EventRoute route;
+
+
+					route.m_code = event_iterator->first;
+					route.m_offset = m_listeners.size();
+					route.m_count = event_iterator->second.size();
+
+					// Store the listeners of the event contiguously.
+					m_listeners.insert(m_listeners.end(),event_iterator->second.begin(),event_iterator->second.end());
+
+					// Store the mailbox of every listener at the same position as the listener.
+					for (
+							std::vector<Listener*>::const_iterator listener_iterator = event_iterator->second.begin();
+							listener_iterator != event_iterator->second.end();
+							++listener_iterator
+						)
+					{
+						std::map<Listener*,ListenerMailbox*>::const_iterator mailbox_iterator = mailbox_list.find((*listener_iterator));
+
+
+						m_mailboxes.push_back(( mailbox_iterator != mailbox_list.end()  ?  mailbox_iterator->second : NULL ));
+					}
+
+					if ( route.m_code == EVENT_ALL )
+						m_all_route = route;
+					else
+					{
+						unsigned int index = slot(route.m_code);
+
+
+						// Find the first empty slot.
+						while ( m_routes[index].m_count > 0 )
+							index = ( index + 1 ) & m_mask;
+
+						m_routes[index] = route;
+					}
+				}
+			}
+		}
+
+		// A function responsible of clearing the table.
+		void EventRoutingTable::clear()
+		{
+			m_routes.clear();
+			m_listeners.clear();
+			m_mailboxes.clear();
+			m_all_route.m_offset = 0;
+			m_all_route.m_count = 0;
+			m_mask = 0;
+			m_shift = 0;
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef ATHENA_CORE_EVENTROUTINGTABLE_HPP
+#define ATHENA_CORE_EVENTROUTINGTABLE_HPP
+
+#include "definitions.hpp"
+#include <map>
+#include <vector>
+#include "event.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// Forward declaration of the listener class.
+		class Listener;
+		// Forward declaration of the listener mailbox class.
+		class ListenerMailbox;
+
+
+		/*
+			A class representing the flat routing table that is used by the event manager to dispatch events.
+			The table is compiled from the registry of the event manager. The listeners of every event code are
+			stored contiguously in a single array and the span of each code is located through an open-addressed
+			hash table, so routing an event costs a single probe in the common case and no pointer chasing.
+			The listeners of the virtual EVENT_ALL event are kept in a separate span that needs no lookup.
+			The mailbox of every listener is stored in a parallel array, so the dispatch does not need any lookup either.
+		*/
+		class EventRoutingTable
+		{
+			private:
+
+				/*
+					A struct representing the span of listeners of a single event code.
+					A route with no listeners marks an empty slot of the hash table.
+				*/
+				struct EventRoute
+				{
+					EventCode m_code;
+					unsigned int m_offset;
+					unsigned int m_count;
+				};
+
+
+				// The minimum amount of slots of the hash table.
+				static const unsigned int s_MIN_ROUTES = 16;
+
+
+				// The open-addressed hash table holding the routes.
+				std::vector<EventRoute> m_routes;
+				// The listeners of every route, stored contiguously.
+				std::vector<Listener*> m_listeners;
+				// The mailboxes of the listeners, stored in the same order as the listeners.
+				std::vector<ListenerMailbox*> m_mailboxes;
+				// The route of the virtual EVENT_ALL event.
+				EventRoute m_all_route;
+				// The mask that is used to map a hash value to a slot.
+				unsigned int m_mask;
+				// The shift that is used to reduce the hash value to the size of the table.
+				unsigned int m_shift;
+
+
+				// A function responsible of calculating the slot of the given code.
+				unsigned int slot( const EventCode& code ) const;
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL EventRoutingTable();
+				// The destructor of the class.
+				ATHENA_DLL ~EventRoutingTable();
+
+
+				// A function responsible of compiling the table from the given registry of events and listeners, along with the mailboxes of the listeners.
+				ATHENA_DLL void build( const std::map<EventCode,std::vector<Listener*> >& event_list , const std::map<Listener*,ListenerMailbox*>& mailbox_list );
+				// A function responsible of clearing the table.
+				ATHENA_DLL void clear();
+
+
+				// A function returning the listeners of the given event code and their mailboxes. Returns the amount of listeners.
+				ATHENA_DLL unsigned int route( const EventCode& code , Listener* const*& listeners , ListenerMailbox* const*& mailboxes ) const;
+				// A function returning the listeners of the virtual EVENT_ALL event and their mailboxes. Returns the amount of listeners.
+				ATHENA_DLL unsigned int route_all( Listener* const*& listeners , ListenerMailbox* const*& mailboxes ) const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "eventRoutingTable.inl"
+
+
+
+#endif /* ATHENA_CORE_EVENTROUTINGTABLE_HPP */
\ No newline at end of file
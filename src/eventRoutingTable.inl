@@ -0,0 +1,73 @@
+#ifndef ATHENA_CORE_EVENTROUTINGTABLE_INL
+#define ATHENA_CORE_EVENTROUTINGTABLE_INL
+
+#ifndef ATHENA_CORE_EVENTROUTINGTABLE_HPP
+	#error "eventRoutingTable.hpp must be included before eventRoutingTable.inl"
+#endif /* ATHENA_CORE_EVENTROUTINGTABLE_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of calculating the slot of the given code.
+		inline unsigned int EventRoutingTable::slot( const EventCode& code ) const
+		{
+			// Fibonacci hashing spreads the dense per-manager code ranges over the whole table.
+			return ( static_cast<unsigned int>(code*2654435769U) >> m_shift ) & m_mask;
+		}
+
+
+		// A function returning the listeners of the given event code and their mailboxes. Returns the amount of listeners.
+		inline unsigned int EventRoutingTable::route( const EventCode& code , Listener* const*& listeners , ListenerMailbox* const*& mailboxes ) const
+		{
+			unsigned int return_value = 0;
+
+
+			listeners = NULL;
+			mailboxes = NULL;
+
+			if ( m_routes.size() > 0 )
+			{
+				unsigned int index = slot(code);
+
+
+				// Probe linearly until the code or an empty slot is found.
+				while ( m_routes[index].m_count > 0 )
+				{
+					if ( m_routes[index].m_code == code )
+					{
+						listeners = &m_listeners[m_routes[index].m_offset];
+						mailboxes = &m_mailboxes[m_routes[index].m_offset];
+						return_value = m_routes[index].m_count;
+						break;
+					}
+
+					index = ( index + 1 ) & m_mask;
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function returning the listeners of the virtual EVENT_ALL event and their mailboxes. Returns the amount of listeners.
+		inline unsigned int EventRoutingTable::route_all( Listener* const*& listeners , ListenerMailbox* const*& mailboxes ) const
+		{
+			listeners = ( m_all_route.m_count > 0  ?  &m_listeners[m_all_route.m_offset] : NULL );
+			mailboxes = ( m_all_route.m_count > 0  ?  &m_mailboxes[m_all_route.m_offset] : NULL );
+
+
+			return m_all_route.m_count;
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_EVENTROUTINGTABLE_INL */
\ No newline at end of file
@@ -0,0 +1,141 @@
+#include "eventStatistics.hpp"
+#include "logManager.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the class.
+		EventStatistics::EventStatistics() :
+			m_codes() ,
+			m_lock() ,
+			m_handler_budget(s_DEFAULT_HANDLER_BUDGET)
+		{
+		}
+
+		// The destructor of the class.
+		EventStatistics::~EventStatistics()
+		{
+		}
+
+
+		// A function responsible of writing the given histogram as a JSON object.
+		void EventStatistics::write_histogram( std::ostream& stream , const utility::Histogram& histogram )
+		{
+			stream << "{\"count\":" << histogram.count();
+			stream << ",\"mean\":" << histogram.mean();
+			stream << ",\"p50\":" << histogram.percentile(50);
+			stream << ",\"p90\":" << histogram.percentile(90);
+			stream << ",\"p99\":" << histogram.percentile(99);
+			stream << ",\"max\":" << histogram.maximum() << "}";
+		}
+
+
+		// A function responsible of recording the dispatch of an event. The wait time is only recorded for triggered events.
+		void EventStatistics::record_dispatch( const EventCode code , const bool triggered , const unsigned long long wait_time , const unsigned long long dispatch_time )
+		{
+			m_lock.lock();
+
+			EventCodeStatistics& statistics = m_codes[code];
+
+
+			++statistics.m_count;
+
+			if ( triggered )
+				statistics.m_wait_time.record(wait_time);
+
+			statistics.m_dispatch_time.record(dispatch_time);
+			m_lock.unlock();
+		}
+
+		// A function responsible of reporting that a listener has taken the given time to handle an event, for the given amount of times.
+		void EventStatistics::report_slow_handler( const Listener* listener , const EventCode code , const unsigned long long handler_time , const unsigned long long count ) const
+		{
+			io::LogManager* log_manager = io::LogManager::get();
+
+
+			if ( log_manager != NULL )
+			{
+				log_manager->log_warning(
+					"Listener %u (%p) took %llu us to handle event %u, over the budget of %llu us. The budget has been exceeded %llu times.",
+					listener->id(),
+					static_cast<const void*>(listener),
+					handler_time,
+					code,
+					handler_budget(),
+					count
+				);
+			}
+		}
+
+		// A function responsible of clearing the statistics of every event code.
+		void EventStatistics::reset()
+		{
+			m_lock.lock();
+			m_codes.clear();
+			m_lock.unlock();
+		}
+
+		// A function responsible of writing the statistics of every event code as the members of a JSON object, keyed by the event code.
+		void EventStatistics::write_json( std::ostream& stream ) const
+		{
+			bool first = true;
+
+
+			m_lock.lock();
+			stream << "{";
+
+			for (
+					std::unordered_map<EventCode,EventCodeStatistics>::const_iterator code_iterator = m_codes.begin();
+					code_iterator != m_codes.end();
+					++code_iterator
+				)
+			{
+				if ( !first )
+					stream << ",";
+
+				stream << "\"" << code_iterator->first << "\":{\"count\":" << code_iterator->second.m_count << ",\"wait_time\":";
+				write_histogram(stream,code_iterator->second.m_wait_time);
+				stream << ",\"dispatch_time\":";
+				write_histogram(stream,code_iterator->second.m_dispatch_time);
+				stream << "}";
+				first = false;
+			}
+
+			stream << "}";
+			m_lock.unlock();
+		}
+
+
+		/*
+			A function responsible of copying the statistics of the given event code.
+			Returns false if no event of the code has been dispatched.
+		*/
+		bool EventStatistics::code_statistics( const EventCode code , EventCodeStatistics& statistics ) const
+		{
+			std::unordered_map<EventCode,EventCodeStatistics>::const_iterator code_iterator;
+			bool return_value = false;
+
+
+			m_lock.lock();
+			code_iterator = m_codes.find(code);
+
+			if ( code_iterator != m_codes.end() )
+			{
+				statistics = code_iterator->second;
+				return_value = true;
+			}
+
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
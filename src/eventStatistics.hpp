@@ -0,0 +1,112 @@
+#ifndef ATHENA_CORE_EVENTSTATISTICS_HPP
+#define ATHENA_CORE_EVENTSTATISTICS_HPP
+
+#include "definitions.hpp"
+#include <atomic>
+#include <mutex>
+#include <ostream>
+#include <unordered_map>
+#include "event.hpp"
+#include "listener.hpp"
+#include "histogram.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A struct holding the dispatch statistics of an event code.
+		struct EventCodeStatistics
+		{
+			// The amount of times events of the code have been dispatched.
+			unsigned long long m_count;
+			// The histogram of the time the triggered events have waited between being queued and being dispatched, in microseconds.
+			utility::Histogram m_wait_time;
+			// The histogram of the time the event manager has spent notifying the listeners of the events, in microseconds.
+			utility::Histogram m_dispatch_time;
+
+			EventCodeStatistics() :
+				m_count(0) ,
+				m_wait_time() ,
+				m_dispatch_time()
+			{
+			};
+		};
+
+
+		/*
+			A class that is used by the event manager in order to collect the dispatch statistics of the event codes
+			and to report listeners that take longer than the handler budget to handle an event.
+			The statistics of the event codes are only recorded by the thread of the event manager, so the lock
+			is never contended by the dispatch itself, only by the threads that read the statistics.
+			Slow listeners are reported as warnings to the log manager, on the 1st, 2nd, 4th, 8th and so on
+			occurrence, so that a listener that is always slow does not flood the log.
+		*/
+		class EventStatistics
+		{
+			private:
+
+				// The default handler budget, in microseconds.
+				static const unsigned long long s_DEFAULT_HANDLER_BUDGET = 16000;
+
+
+				// The statistics of every event code that has been dispatched.
+				std::unordered_map<EventCode,EventCodeStatistics> m_codes;
+				// A lock that is used to handle concurrency issues regarding the statistics of the event codes.
+				mutable std::mutex m_lock;
+				// The time a listener may take to handle an event before it is reported, in microseconds. Zero (0) disables the reports.
+				std::atomic<unsigned long long> m_handler_budget;
+
+
+				// The copy constructor is not available.
+				EventStatistics( const EventStatistics& );
+				// The assignment operator is not available.
+				EventStatistics& operator=( const EventStatistics& );
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL EventStatistics();
+				// The destructor of the class.
+				ATHENA_DLL ~EventStatistics();
+
+
+				// A function responsible of writing the given histogram as a JSON object.
+				ATHENA_DLL static void write_histogram( std::ostream& stream , const utility::Histogram& histogram );
+
+
+				// A function responsible of recording the dispatch of an event. The wait time is only recorded for triggered events.
+				ATHENA_DLL void record_dispatch( const EventCode code , const bool triggered , const unsigned long long wait_time , const unsigned long long dispatch_time );
+				// A function responsible of reporting that a listener has taken the given time to handle an event, for the given amount of times.
+				ATHENA_DLL void report_slow_handler( const Listener* listener , const EventCode code , const unsigned long long handler_time , const unsigned long long count ) const;
+				// A function responsible of setting the handler budget, in microseconds. Zero (0) disables the reports.
+				ATHENA_DLL void handler_budget( const unsigned long long value );
+				// A function responsible of clearing the statistics of every event code.
+				ATHENA_DLL void reset();
+				// A function responsible of writing the statistics of every event code as the members of a JSON object, keyed by the event code.
+				ATHENA_DLL void write_json( std::ostream& stream ) const;
+
+
+				// A function returning the handler budget, in microseconds.
+				ATHENA_DLL unsigned long long handler_budget() const;
+				/*
+					A function responsible of copying the statistics of the given event code.
+					Returns false if no event of the code has been dispatched.
+				*/
+				ATHENA_DLL bool code_statistics( const EventCode code , EventCodeStatistics& statistics ) const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "eventStatistics.inl"
+
+
+
+#endif /* ATHENA_CORE_EVENTSTATISTICS_HPP */
\ No newline at end of file
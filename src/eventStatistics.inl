@@ -0,0 +1,35 @@
+#ifndef ATHENA_CORE_EVENTSTATISTICS_INL
+#define ATHENA_CORE_EVENTSTATISTICS_INL
+
+#ifndef ATHENA_CORE_EVENTSTATISTICS_HPP
+	#error "eventStatistics.hpp must be included before eventStatistics.inl"
+#endif /* ATHENA_CORE_EVENTSTATISTICS_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of setting the handler budget, in microseconds. Zero (0) disables the reports.
+		inline void EventStatistics::handler_budget( const unsigned long long value )
+		{
+			m_handler_budget.store(value,std::memory_order_relaxed);
+		}
+
+
+		// A function returning the handler budget, in microseconds.
+		inline unsigned long long EventStatistics::handler_budget() const
+		{
+			return m_handler_budget.load(std::memory_order_relaxed);
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_EVENTSTATISTICS_INL */
\ No newline at end of file
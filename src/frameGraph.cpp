@@ -0,0 +1,552 @@
+#include "frameGraph.hpp"
+#include <algorithm>
+#include <new>
+#include "threadPool.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The value that is returned instead of a node or a resource when it cannot be added.
+		const unsigned int FrameGraph::s_INVALID_INDEX;
+
+
+		// The function that is used by the thread pool tasks in order to run a node.
+		int FrameGraph::node_function( void* parameter )
+		{
+			Node* node = static_cast<Node*>(parameter);
+
+
+			if ( node != NULL )
+				node->m_graph->run_node(node->m_index);
+
+
+			return 0;
+		}
+
+		// A function responsible of writing the given string as a JSON string.
+		void FrameGraph::write_string( std::ostream& stream , const std::string& value )
+		{
+			stream << "\"";
+
+			for (
+					std::string::const_iterator character_iterator = value.begin();
+					character_iterator != value.end();
+					++character_iterator
+				)
+			{
+				if ( (*character_iterator) == '"'  ||  (*character_iterator) == '\\' )
+					stream << "\\";
+
+				stream << (*character_iterator);
+			}
+
+			stream << "\"";
+		}
+
+		// A function responsible of adding the given dependency to the dependencies of the given node, unless it is already there.
+		void FrameGraph::add_dependency( std::vector< std::vector<unsigned int> >& dependencies , const unsigned int node , const unsigned int dependency )
+		{
+			if ( dependency != node  &&  std::find(dependencies[node].begin(),dependencies[node].end(),dependency) == dependencies[node].end() )
+				dependencies[node].push_back(dependency);
+		}
+
+
+		// A function responsible of running the node at the given index on the calling thread, followed by any successor it readies that the calling thread can run.
+		void FrameGraph::run_node( unsigned int index )
+		{
+			while ( index != s_INVALID_INDEX )
+			{
+				Node& node = m_nodes[index];
+
+
+				index = s_INVALID_INDEX;
+				node.m_start_time = TaskClock::now();
+
+				if ( node.m_function != NULL )
+					node.m_function(node.m_parameter);
+
+				node.m_end_time = TaskClock::now();
+
+				// For every successor of the node.
+				for ( size_t i = node.m_first_successor;  i < node.m_first_successor + node.m_successor_count;  ++i )
+				{
+					unsigned int successor = m_successors[i];
+
+
+					// The successor is ready once its last predecessor has finished.
+					if ( m_pending[successor].fetch_sub(1,std::memory_order_acq_rel) == 1 )
+					{
+						m_nodes[successor].m_ready_time = node.m_end_time;
+
+						// The calling thread continues with the first successor it can run, instead of queuing it.
+						if ( index == s_INVALID_INDEX  &&  !m_nodes[successor].m_main_thread )
+							index = successor;
+						else
+							dispatch_node(successor);
+					}
+				}
+
+				finish_node();
+			}
+		}
+
+		/*
+			A function responsible of counting a node as finished and waking up the thread executing the graph once every node has finished.
+			The last node is counted and the thread is woken up while holding the lock, since the graph may be destroyed as soon as the lock is released.
+		*/
+		void FrameGraph::finish_node()
+		{
+			size_t remaining = m_remaining.load(std::memory_order_relaxed);
+
+
+			// Any node but the last one is counted without the lock.
+			while ( remaining > 1  &&  !m_remaining.compare_exchange_weak(remaining,remaining - 1,std::memory_order_acq_rel,std::memory_order_relaxed) );
+
+			if ( remaining <= 1 )
+			{
+				m_lock.lock();
+
+				if ( m_remaining.fetch_sub(1,std::memory_order_acq_rel) == 1 )
+					m_condition_variable.notify_all();
+
+				m_lock.unlock();
+			}
+		}
+
+		// A function responsible of handing the ready node at the given index over to the thread that should run it.
+		void FrameGraph::dispatch_node( const unsigned int index )
+		{
+			if ( m_nodes[index].m_main_thread )
+			{
+				m_lock.lock();
+				m_main_thread_nodes.push_back(index);
+				m_condition_variable.notify_all();
+				m_lock.unlock();
+			}
+			else
+			{
+				ThreadPool* thread_pool = ThreadPool::get();
+
+
+				// If the node cannot be queued, run it on the calling thread.
+				if ( thread_pool == NULL  ||  !thread_pool->add_task(node_function,static_cast<void*>(&m_nodes[index]),NULL,NULL,TaskOptions(m_priority)) )
+					run_node(index);
+			}
+		}
+
+
+		// The constructor of the class.
+		FrameGraph::FrameGraph() :
+			m_resources() ,
+			m_nodes() ,
+			m_successors() ,
+			m_predecessors() ,
+			m_pending(NULL) ,
+			m_remaining(0) ,
+			m_main_thread_nodes() ,
+			m_lock() ,
+			m_condition_variable() ,
+			m_priority(CriticalTaskPriority) ,
+			m_frame_start() ,
+			m_frame_end() ,
+			m_frames(0) ,
+			m_compiled(false)
+		{
+		}
+
+		// The destructor of the class.
+		FrameGraph::~FrameGraph()
+		{
+			delete[] m_pending;
+		}
+
+
+		/*
+			A function responsible of returning the index of the resource with the given name, adding the resource if it does not exist.
+			Resources only exist to order the nodes, so any name can be used for any data the nodes share.
+		*/
+		unsigned int FrameGraph::resource( const std::string& name )
+		{
+			std::vector<std::string>::iterator resource_iterator = std::find(m_resources.begin(),m_resources.end(),name);
+			unsigned int return_value = static_cast<unsigned int>(resource_iterator - m_resources.begin());
+
+
+			if ( resource_iterator == m_resources.end() )
+				m_resources.push_back(name);
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of adding a node that calls the given function with the given parameter, and returning its index.
+			A node that is marked to run on the main thread is run by the thread executing the graph.
+		*/
+		unsigned int FrameGraph::add_node( const std::string& name , TaskFunction function , void* parameter , const bool main_thread )
+		{
+			Node node;
+
+
+			node.m_graph = this;
+			node.m_index = static_cast<unsigned int>(m_nodes.size());
+			node.m_name = name;
+			node.m_function = function;
+			node.m_parameter = parameter;
+			node.m_main_thread = main_thread;
+			node.m_first_successor = 0;
+			node.m_successor_count = 0;
+			node.m_first_predecessor = 0;
+			node.m_predecessor_count = 0;
+			m_nodes.push_back(node);
+			m_compiled = false;
+
+
+			return node.m_index;
+		}
+
+		// A function responsible of declaring that the given node reads the given resource. Returns false if either of them does not exist.
+		bool FrameGraph::reads( const unsigned int node , const unsigned int resource )
+		{
+			bool return_value = false;
+
+
+			if ( node < m_nodes.size()  &&  resource < m_resources.size() )
+			{
+				m_nodes[node].m_reads.push_back(resource);
+				m_compiled = false;
+				return_value = true;
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of declaring that the given node writes the given resource. Returns false if either of them does not exist.
+		bool FrameGraph::writes( const unsigned int node , const unsigned int resource )
+		{
+			bool return_value = false;
+
+
+			if ( node < m_nodes.size()  &&  resource < m_resources.size() )
+			{
+				m_nodes[node].m_writes.push_back(resource);
+				m_compiled = false;
+				return_value = true;
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of removing every node and resource.
+		void FrameGraph::clear()
+		{
+			m_resources.clear();
+			m_nodes.clear();
+			m_successors.clear();
+			m_predecessors.clear();
+			m_main_thread_nodes.clear();
+			delete[] m_pending;
+			m_pending = NULL;
+			m_compiled = false;
+		}
+
+		/*
+			A function responsible of building the dependencies of the nodes from their declarations. The graph is compiled
+			by the first execution after a change, so compiling in advance only moves the work out of the frame.
+			Returns false if the graph could not be allocated.
+		*/
+		bool FrameGraph::compile()
+		{
+			std::vector< std::vector<unsigned int> > predecessors(m_nodes.size());
+			std::vector< std::vector<unsigned int> > successors(m_nodes.size());
+			std::vector<unsigned int> writers(m_resources.size(),s_INVALID_INDEX);
+			std::vector< std::vector<unsigned int> > readers(m_resources.size());
+			bool return_value = false;
+
+
+			// The nodes are visited in the order they were added, which is the order their accesses to each resource are serialised in.
+			for ( unsigned int node = 0;  node < m_nodes.size();  ++node )
+			{
+				// A read follows the last write of the resource.
+				for (
+						std::vector<unsigned int>::iterator resource_iterator = m_nodes[node].m_reads.begin();
+						resource_iterator != m_nodes[node].m_reads.end();
+						++resource_iterator
+					)
+				{
+					if ( writers[(*resource_iterator)] != s_INVALID_INDEX )
+						add_dependency(predecessors,node,writers[(*resource_iterator)]);
+				}
+
+				// A write follows the last write of the resource and every read since.
+				for (
+						std::vector<unsigned int>::iterator resource_iterator = m_nodes[node].m_writes.begin();
+						resource_iterator != m_nodes[node].m_writes.end();
+						++resource_iterator
+					)
+				{
+					if ( writers[(*resource_iterator)] != s_INVALID_INDEX )
+						add_dependency(predecessors,node,writers[(*resource_iterator)]);
+
+					for (
+							std::vector<unsigned int>::iterator reader_iterator = readers[(*resource_iterator)].begin();
+							reader_iterator != readers[(*resource_iterator)].end();
+							++reader_iterator
+						)
+					{
+						add_dependency(predecessors,node,(*reader_iterator));
+					}
+				}
+
+				for (
+						std::vector<unsigned int>::iterator resource_iterator = m_nodes[node].m_reads.begin();
+						resource_iterator != m_nodes[node].m_reads.end();
+						++resource_iterator
+					)
+				{
+					readers[(*resource_iterator)].push_back(node);
+				}
+
+				// A node that writes a resource becomes its last writer, so the later nodes only depend on it.
+				for (
+						std::vector<unsigned int>::iterator resource_iterator = m_nodes[node].m_writes.begin();
+						resource_iterator != m_nodes[node].m_writes.end();
+						++resource_iterator
+					)
+				{
+					writers[(*resource_iterator)] = node;
+					readers[(*resource_iterator)].clear();
+				}
+			}
+
+			for ( unsigned int node = 0;  node < m_nodes.size();  ++node )
+			{
+				for (
+						std::vector<unsigned int>::iterator predecessor_iterator = predecessors[node].begin();
+						predecessor_iterator != predecessors[node].end();
+						++predecessor_iterator
+					)
+				{
+					successors[(*predecessor_iterator)].push_back(node);
+				}
+			}
+
+			delete[] m_pending;
+			m_pending = new (std::nothrow) std::atomic<size_t>[m_nodes.size() > 0  ?  m_nodes.size() : 1];
+
+			if ( m_pending != NULL )
+			{
+				// Flatten the dependencies, so that executing the graph only walks contiguous arrays.
+				m_successors.clear();
+				m_predecessors.clear();
+
+				for ( unsigned int node = 0;  node < m_nodes.size();  ++node )
+				{
+					m_nodes[node].m_first_successor = m_successors.size();
+					m_nodes[node].m_successor_count = successors[node].size();
+					m_successors.insert(m_successors.end(),successors[node].begin(),successors[node].end());
+					m_nodes[node].m_first_predecessor = m_predecessors.size();
+					m_nodes[node].m_predecessor_count = predecessors[node].size();
+					m_predecessors.insert(m_predecessors.end(),predecessors[node].begin(),predecessors[node].end());
+				}
+
+				m_main_thread_nodes.reserve(m_nodes.size());
+				m_compiled = true;
+				return_value = true;
+			}
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of running every node of the graph once and returning once every node has finished.
+			The calling thread runs the nodes that are marked to run on the main thread. Returns false if the graph could not be compiled.
+		*/
+		bool FrameGraph::execute()
+		{
+			bool return_value = ( m_compiled  ||  compile() );
+
+
+			if ( return_value )
+			{
+				m_frame_start = TaskClock::now();
+				m_main_thread_nodes.clear();
+				m_remaining.store(m_nodes.size(),std::memory_order_relaxed);
+
+				// Every counter is reset before any node is dispatched, since the nodes start running as soon as they are dispatched.
+				for ( unsigned int node = 0;  node < m_nodes.size();  ++node )
+					m_pending[node].store(m_nodes[node].m_predecessor_count,std::memory_order_relaxed);
+
+				std::atomic_thread_fence(std::memory_order_release);
+
+				for ( unsigned int node = 0;  node < m_nodes.size();  ++node )
+				{
+					if ( m_nodes[node].m_predecessor_count == 0 )
+					{
+						m_nodes[node].m_ready_time = m_frame_start;
+						dispatch_node(node);
+					}
+				}
+
+				// Run the nodes of the main thread as they become ready, until every node has finished.
+				m_lock.lock();
+
+				while ( m_remaining.load(std::memory_order_acquire) > 0 )
+				{
+					if ( m_main_thread_nodes.size() > 0 )
+					{
+						unsigned int node = m_main_thread_nodes.back();
+
+
+						m_main_thread_nodes.pop_back();
+						m_lock.unlock();
+						run_node(node);
+						m_lock.lock();
+					}
+					else
+						m_condition_variable.wait(m_lock);
+				}
+
+				m_lock.unlock();
+				m_frame_end = TaskClock::now();
+				++m_frames;
+			}
+
+
+			return return_value;
+		}
+
+
+		// A function returning the name of the given node.
+		const std::string& FrameGraph::node_name( const unsigned int node ) const
+		{
+			static const std::string empty_name;
+
+
+			return ( node < m_nodes.size()  ?  m_nodes[node].m_name : empty_name );
+		}
+
+		// A function returning the time the given node ran for during the last frame.
+		TaskClock::duration FrameGraph::node_duration( const unsigned int node ) const
+		{
+			TaskClock::duration return_value = TaskClock::duration::zero();
+
+
+			if ( node < m_nodes.size() )
+				return_value = m_nodes[node].m_end_time - m_nodes[node].m_start_time;
+
+
+			return return_value;
+		}
+
+		// A function returning the duration of the last frame.
+		TaskClock::duration FrameGraph::frame_duration() const
+		{
+			return m_frame_end - m_frame_start;
+		}
+
+		/*
+			A function responsible of finding the critical path of the last frame, the chain of nodes that ends with the node
+			that finished last, in which every node is preceded by its predecessor that finished last. The nodes are stored in the
+			given vector in the order they ran. Returns the time the path spent running, as opposed to waiting for a thread.
+		*/
+		TaskClock::duration FrameGraph::critical_path( std::vector<unsigned int>& nodes ) const
+		{
+			TaskClock::duration return_value = TaskClock::duration::zero();
+
+
+			nodes.clear();
+
+			if ( m_frames > 0  &&  m_compiled  &&  m_nodes.size() > 0 )
+			{
+				unsigned int node = 0;
+
+
+				for ( unsigned int i = 1;  i < m_nodes.size();  ++i )
+				{
+					if ( m_nodes[i].m_end_time > m_nodes[node].m_end_time )
+						node = i;
+				}
+
+				while ( node != s_INVALID_INDEX )
+				{
+					const Node& current = m_nodes[node];
+
+
+					nodes.push_back(node);
+					return_value += current.m_end_time - current.m_start_time;
+					node = s_INVALID_INDEX;
+
+					for ( size_t i = current.m_first_predecessor;  i < current.m_first_predecessor + current.m_predecessor_count;  ++i )
+					{
+						if ( node == s_INVALID_INDEX  ||  m_nodes[m_predecessors[i]].m_end_time > m_nodes[node].m_end_time )
+							node = m_predecessors[i];
+					}
+				}
+
+				std::reverse(nodes.begin(),nodes.end());
+			}
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of writing a report of the last frame as a JSON object, holding the duration of the frame, the time every
+			node ran for and the critical path, with the time every node on the path became ready, started and finished. Times are in microseconds.
+		*/
+		void FrameGraph::write_report_json( std::ostream& stream ) const
+		{
+			std::vector<unsigned int> path;
+			TaskClock::duration path_time = critical_path(path);
+
+
+			stream << "{\"frame\":" << m_frames;
+			stream << ",\"duration\":" << std::chrono::duration_cast<std::chrono::microseconds>(frame_duration()).count();
+			stream << ",\"nodes\":[";
+
+			for ( unsigned int node = 0;  node < m_nodes.size();  ++node )
+			{
+				if ( node > 0 )
+					stream << ",";
+
+				stream << "{\"name\":";
+				write_string(stream,m_nodes[node].m_name);
+				stream << ",\"time\":" << std::chrono::duration_cast<std::chrono::microseconds>(node_duration(node)).count() << "}";
+			}
+
+			stream << "],\"critical_path_time\":" << std::chrono::duration_cast<std::chrono::microseconds>(path_time).count();
+			stream << ",\"critical_path\":[";
+
+			for (
+					std::vector<unsigned int>::iterator node_iterator = path.begin();
+					node_iterator != path.end();
+					++node_iterator
+				)
+			{
+				const Node& node = m_nodes[(*node_iterator)];
+
+
+				if ( node_iterator != path.begin() )
+					stream << ",";
+
+				stream << "{\"name\":";
+				write_string(stream,node.m_name);
+				stream << ",\"ready\":" << std::chrono::duration_cast<std::chrono::microseconds>(node.m_ready_time - m_frame_start).count();
+				stream << ",\"start\":" << std::chrono::duration_cast<std::chrono::microseconds>(node.m_start_time - m_frame_start).count();
+				stream << ",\"end\":" << std::chrono::duration_cast<std::chrono::microseconds>(node.m_end_time - m_frame_start).count() << "}";
+			}
+
+			stream << "]}";
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
@@ -0,0 +1,211 @@
+#ifndef ATHENA_CORE_FRAMEGRAPH_HPP
+#define ATHENA_CORE_FRAMEGRAPH_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <string>
+#include <vector>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <ostream>
+#include "threadTask.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A class representing a graph of the work that is performed every frame. Every node is a function that declares
+			the resources it reads and writes, and the graph orders the nodes by their declarations: a node that reads
+			a resource follows the last node declared before it that writes the resource, while a node that writes a resource
+			follows the last node that writes it and every node that reads it since. Nodes that do not depend on each other
+			run in parallel on the thread pool, and nodes that must run on the thread executing the graph, such as rendering,
+			can be marked as such.
+			The graph is compiled once, into flat arrays of dependencies, and every execution only resets the counters
+			of the nodes, so executing a compiled graph every frame allocates nothing besides the tasks of the pool.
+			The time every node became ready, started and finished is kept for the last frame, which is used to find the critical path
+			of the frame, the chain of dependent nodes that determined its duration.
+			The graph must not be changed or executed by more than one thread at a time.
+		*/
+		class FrameGraph
+		{
+			public:
+
+				// The value that is returned instead of a node or a resource when it cannot be added.
+				static const unsigned int s_INVALID_INDEX = ~0U;
+
+
+			private:
+
+				// A struct holding a node of the graph.
+				struct Node
+				{
+					// The graph the node belongs to.
+					FrameGraph* m_graph;
+					// The index of the node.
+					unsigned int m_index;
+					// The name of the node.
+					std::string m_name;
+					// The function that is called when the node runs.
+					TaskFunction m_function;
+					// The parameter of the function.
+					void* m_parameter;
+					// A variable holding whether the node must run on the thread executing the graph.
+					bool m_main_thread;
+					// The resources the node reads.
+					std::vector<unsigned int> m_reads;
+					// The resources the node writes.
+					std::vector<unsigned int> m_writes;
+					// The position of the first successor of the node in the compiled successors.
+					size_t m_first_successor;
+					// The amount of successors of the node.
+					size_t m_successor_count;
+					// The position of the first predecessor of the node in the compiled predecessors.
+					size_t m_first_predecessor;
+					// The amount of predecessors of the node.
+					size_t m_predecessor_count;
+					// The time the node became ready during the last frame.
+					TaskClock::time_point m_ready_time;
+					// The time the node started during the last frame.
+					TaskClock::time_point m_start_time;
+					// The time the node finished during the last frame.
+					TaskClock::time_point m_end_time;
+				};
+
+
+				// The names of the resources.
+				std::vector<std::string> m_resources;
+				// The nodes of the graph, in the order they were added.
+				std::vector<Node> m_nodes;
+				// The successors of every node, stored consecutively for each node.
+				std::vector<unsigned int> m_successors;
+				// The predecessors of every node, stored consecutively for each node.
+				std::vector<unsigned int> m_predecessors;
+				// The amount of predecessors of every node that have not finished during the current frame.
+				std::atomic<size_t>* m_pending;
+				// The amount of nodes that have not finished during the current frame.
+				std::atomic<size_t> m_remaining;
+				// The nodes that must run on the thread executing the graph and are ready.
+				std::vector<unsigned int> m_main_thread_nodes;
+				// A lock that is used to handle concurrency issues.
+				std::mutex m_lock;
+				// The condition variable that the thread executing the graph waits on.
+				std::condition_variable_any m_condition_variable;
+				// The priority class of the tasks of the nodes.
+				TaskPriority m_priority;
+				// The time the last frame started.
+				TaskClock::time_point m_frame_start;
+				// The time the last frame finished.
+				TaskClock::time_point m_frame_end;
+				// The amount of frames the graph has executed.
+				unsigned long long m_frames;
+				// A variable holding whether the graph has been compiled since it was last changed.
+				bool m_compiled;
+
+
+				// The copy constructor is not available.
+				FrameGraph( const FrameGraph& );
+				// The assignment operator is not available.
+				FrameGraph& operator=( const FrameGraph& );
+
+
+				// The function that is used by the thread pool tasks in order to run a node.
+				static int node_function( void* parameter );
+				// A function responsible of writing the given string as a JSON string.
+				static void write_string( std::ostream& stream , const std::string& value );
+
+
+				// A function responsible of adding the given dependency to the dependencies of the given node, unless it is already there.
+				static void add_dependency( std::vector< std::vector<unsigned int> >& dependencies , const unsigned int node , const unsigned int dependency );
+
+
+				// A function responsible of running the node at the given index on the calling thread, followed by any successor it readies that the calling thread can run.
+				void run_node( unsigned int index );
+				/*
+					A function responsible of counting a node as finished and waking up the thread executing the graph once every node has finished.
+					The last node is counted and the thread is woken up while holding the lock, since the graph may be destroyed as soon as the lock is released.
+				*/
+				void finish_node();
+				// A function responsible of handing the ready node at the given index over to the thread that should run it.
+				void dispatch_node( const unsigned int index );
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL FrameGraph();
+				// The destructor of the class.
+				ATHENA_DLL ~FrameGraph();
+
+
+				/*
+					A function responsible of returning the index of the resource with the given name, adding the resource if it does not exist.
+					Resources only exist to order the nodes, so any name can be used for any data the nodes share.
+				*/
+				ATHENA_DLL unsigned int resource( const std::string& name );
+				/*
+					A function responsible of adding a node that calls the given function with the given parameter, and returning its index.
+					A node that is marked to run on the main thread is run by the thread executing the graph.
+				*/
+				ATHENA_DLL unsigned int add_node( const std::string& name , TaskFunction function , void* parameter , const bool main_thread = false );
+				// A function responsible of declaring that the given node reads the given resource. Returns false if either of them does not exist.
+				ATHENA_DLL bool reads( const unsigned int node , const unsigned int resource );
+				// A function responsible of declaring that the given node writes the given resource. Returns false if either of them does not exist.
+				ATHENA_DLL bool writes( const unsigned int node , const unsigned int resource );
+				// A function responsible of removing every node and resource.
+				ATHENA_DLL void clear();
+				/*
+					A function responsible of building the dependencies of the nodes from their declarations. The graph is compiled
+					by the first execution after a change, so compiling in advance only moves the work out of the frame.
+					Returns false if the graph could not be allocated.
+				*/
+				ATHENA_DLL bool compile();
+				/*
+					A function responsible of running every node of the graph once and returning once every node has finished.
+					The calling thread runs the nodes that are marked to run on the main thread. Returns false if the graph could not be compiled.
+				*/
+				ATHENA_DLL bool execute();
+				// A function responsible of setting the priority class of the tasks of the nodes. The default is the critical class.
+				ATHENA_DLL void priority( const TaskPriority priority );
+
+
+				// A function returning the amount of nodes.
+				ATHENA_DLL unsigned int node_count() const;
+				// A function returning the name of the given node.
+				ATHENA_DLL const std::string& node_name( const unsigned int node ) const;
+				// A function returning the time the given node ran for during the last frame.
+				ATHENA_DLL TaskClock::duration node_duration( const unsigned int node ) const;
+				// A function returning the duration of the last frame.
+				ATHENA_DLL TaskClock::duration frame_duration() const;
+				// A function returning the amount of frames the graph has executed.
+				ATHENA_DLL unsigned long long frame_count() const;
+				// A function returning the priority class of the tasks of the nodes.
+				ATHENA_DLL TaskPriority priority() const;
+				/*
+					A function responsible of finding the critical path of the last frame, the chain of nodes that ends with the node
+					that finished last, in which every node is preceded by its predecessor that finished last. The nodes are stored in the
+					given vector in the order they ran. Returns the time the path spent running, as opposed to waiting for a thread.
+				*/
+				ATHENA_DLL TaskClock::duration critical_path( std::vector<unsigned int>& nodes ) const;
+				/*
+					A function responsible of writing a report of the last frame as a JSON object, holding the duration of the frame, the time every
+					node ran for and the critical path, with the time every node on the path became ready, started and finished. Times are in microseconds.
+				*/
+				ATHENA_DLL void write_report_json( std::ostream& stream ) const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "frameGraph.inl"
+
+
+
+#endif /* ATHENA_CORE_FRAMEGRAPH_HPP */
\ No newline at end of file
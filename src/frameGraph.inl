@@ -0,0 +1,47 @@
+#ifndef ATHENA_CORE_FRAMEGRAPH_INL
+#define ATHENA_CORE_FRAMEGRAPH_INL
+
+#ifndef ATHENA_CORE_FRAMEGRAPH_HPP
+	#error "frameGraph.hpp must be included before frameGraph.inl"
+#endif /* ATHENA_CORE_FRAMEGRAPH_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of setting the priority class of the tasks of the nodes. The default is the critical class.
+		inline void FrameGraph::priority( const TaskPriority priority )
+		{
+			m_priority = priority;
+		}
+
+
+		// A function returning the amount of nodes.
+		inline unsigned int FrameGraph::node_count() const
+		{
+			return static_cast<unsigned int>(m_nodes.size());
+		}
+
+		// A function returning the amount of frames the graph has executed.
+		inline unsigned long long FrameGraph::frame_count() const
+		{
+			return m_frames;
+		}
+
+		// A function returning the priority class of the tasks of the nodes.
+		inline TaskPriority FrameGraph::priority() const
+		{
+			return m_priority;
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_FRAMEGRAPH_INL */
\ No newline at end of file
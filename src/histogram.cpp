@@ -0,0 +1,136 @@
+#include "histogram.hpp"
+
+
+
+namespace athena
+{
+
+	namespace utility
+	{
+
+		// The constructor of the class.
+		Histogram::Histogram() :
+			m_count(0) ,
+			m_sum(0) ,
+			m_maximum(0)
+		{
+			for ( unsigned int i = 0;  i < s_BUCKET_COUNT;  ++i )
+				m_buckets[i].store(0,std::memory_order_relaxed);
+		}
+
+		// The copy constructor of the class. The copy is a snapshot of the given histogram.
+		Histogram::Histogram( const Histogram& histogram ) :
+			m_count(histogram.count()) ,
+			m_sum(histogram.sum()) ,
+			m_maximum(histogram.maximum())
+		{
+			for ( unsigned int i = 0;  i < s_BUCKET_COUNT;  ++i )
+				m_buckets[i].store(histogram.bucket(i),std::memory_order_relaxed);
+		}
+
+		// The destructor of the class.
+		Histogram::~Histogram()
+		{
+		}
+
+
+		// The assignment operator. The histogram becomes a snapshot of the given histogram.
+		Histogram& Histogram::operator=( const Histogram& histogram )
+		{
+			if ( this != &histogram )
+			{
+				for ( unsigned int i = 0;  i < s_BUCKET_COUNT;  ++i )
+					m_buckets[i].store(histogram.bucket(i),std::memory_order_relaxed);
+
+				m_count.store(histogram.count(),std::memory_order_relaxed);
+				m_sum.store(histogram.sum(),std::memory_order_relaxed);
+				m_maximum.store(histogram.maximum(),std::memory_order_relaxed);
+			}
+
+			return *this;
+		}
+
+
+		// A function responsible of recording a value.
+		void Histogram::record( const unsigned long long value )
+		{
+			unsigned long long maximum = m_maximum.load(std::memory_order_relaxed);
+
+
+			m_buckets[bucket_index(value)].fetch_add(1,std::memory_order_relaxed);
+			m_count.fetch_add(1,std::memory_order_relaxed);
+			m_sum.fetch_add(value,std::memory_order_relaxed);
+
+			// Raise the maximum, unless another thread has recorded a larger value in the meantime.
+			while ( value > maximum  &&  !m_maximum.compare_exchange_weak(maximum,value,std::memory_order_relaxed) );
+		}
+
+		// A function responsible of clearing the recorded values.
+		void Histogram::reset()
+		{
+			for ( unsigned int i = 0;  i < s_BUCKET_COUNT;  ++i )
+				m_buckets[i].store(0,std::memory_order_relaxed);
+
+			m_count.store(0,std::memory_order_relaxed);
+			m_sum.store(0,std::memory_order_relaxed);
+			m_maximum.store(0,std::memory_order_relaxed);
+		}
+
+
+		// A function returning the mean of the recorded values.
+		double Histogram::mean() const
+		{
+			unsigned long long values = count();
+			double return_value = 0;
+
+
+			if ( values > 0 )
+				return_value = static_cast<double>(sum()) / static_cast<double>(values);
+
+
+			return return_value;
+		}
+
+		// A function returning an upper bound of the given percentile (0-100) of the recorded values.
+		unsigned long long Histogram::percentile( const double value ) const
+		{
+			unsigned long long return_value = 0;
+			unsigned long long values = 0;
+
+
+			for ( unsigned int i = 0;  i < s_BUCKET_COUNT;  ++i )
+				values += bucket(i);
+
+			if ( values > 0 )
+			{
+				// The rank of the requested value among the recorded values.
+				unsigned long long rank = static_cast<unsigned long long>(( value / 100.0 ) * static_cast<double>(values));
+				unsigned long long accumulated = 0;
+
+
+				if ( rank < 1 )
+					rank = 1;
+
+				for ( unsigned int i = 0;  i < s_BUCKET_COUNT;  ++i )
+				{
+					accumulated += bucket(i);
+
+					if ( accumulated >= rank )
+					{
+						return_value = bucket_limit(i);
+						break;
+					}
+				}
+
+				// The last bucket is unbounded, so the maximum is a tighter bound.
+				if ( return_value > maximum()  ||  accumulated < rank )
+					return_value = maximum();
+			}
+
+
+			return return_value;
+		}
+
+	} /* utility */
+
+} /* athena */
\ No newline at end of file
@@ -0,0 +1,90 @@
+#ifndef ATHENA_UTILITY_HISTOGRAM_HPP
+#define ATHENA_UTILITY_HISTOGRAM_HPP
+
+#include "definitions.hpp"
+#include <atomic>
+
+
+
+namespace athena
+{
+
+	namespace utility
+	{
+
+		/*
+			A class representing a histogram with logarithmic buckets that can be updated concurrently.
+			Bucket 0 counts the zero (0) values and bucket i counts the values in [2^(i-1),2^i).
+			The last bucket also counts every larger value. Recording a value costs a few relaxed atomic
+			operations and never blocks, so the histogram can be updated from any thread.
+		*/
+		class Histogram
+		{
+			public:
+
+				// The amount of buckets of the histogram.
+				static const unsigned int s_BUCKET_COUNT = 32;
+
+
+			private:
+
+				// The amount of values that fall in each bucket.
+				std::atomic<unsigned long long> m_buckets[s_BUCKET_COUNT];
+				// The amount of recorded values.
+				std::atomic<unsigned long long> m_count;
+				// The sum of the recorded values.
+				std::atomic<unsigned long long> m_sum;
+				// The largest recorded value.
+				std::atomic<unsigned long long> m_maximum;
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL Histogram();
+				// The copy constructor of the class. The copy is a snapshot of the given histogram.
+				ATHENA_DLL Histogram( const Histogram& histogram );
+				// The destructor of the class.
+				ATHENA_DLL ~Histogram();
+
+
+				// The assignment operator. The histogram becomes a snapshot of the given histogram.
+				ATHENA_DLL Histogram& operator=( const Histogram& histogram );
+
+
+				// A function responsible of recording a value.
+				ATHENA_DLL void record( const unsigned long long value );
+				// A function responsible of clearing the recorded values.
+				ATHENA_DLL void reset();
+
+
+				// A function returning the bucket the given value falls in.
+				ATHENA_DLL static unsigned int bucket_index( const unsigned long long value );
+				// A function returning the largest value that falls in the given bucket.
+				ATHENA_DLL static unsigned long long bucket_limit( const unsigned int index );
+
+
+				// A function returning the amount of values that fall in the given bucket.
+				ATHENA_DLL unsigned long long bucket( const unsigned int index ) const;
+				// A function returning the amount of recorded values.
+				ATHENA_DLL unsigned long long count() const;
+				// A function returning the sum of the recorded values.
+				ATHENA_DLL unsigned long long sum() const;
+				// A function returning the largest recorded value.
+				ATHENA_DLL unsigned long long maximum() const;
+				// A function returning the mean of the recorded values.
+				ATHENA_DLL double mean() const;
+				// A function returning an upper bound of the given percentile (0-100) of the recorded values.
+				ATHENA_DLL unsigned long long percentile( const double value ) const;
+		};
+
+	} /* utility */
+
+} /* athena */
+
+
+#include "histogram.inl"
+
+
+
+#endif /* ATHENA_UTILITY_HISTOGRAM_HPP */
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef ATHENA_UTILITY_HISTOGRAM_INL
+#define ATHENA_UTILITY_HISTOGRAM_INL
+
+#ifndef ATHENA_UTILITY_HISTOGRAM_HPP
+	#error "histogram.hpp must be included before histogram.inl"
+#endif /* ATHENA_UTILITY_HISTOGRAM_HPP */
+
+
+
+namespace athena
+{
+
+	namespace utility
+	{
+
+		// A function returning the bucket the given value falls in.
+		inline unsigned int Histogram::bucket_index( const unsigned long long value )
+		{
+			unsigned int return_value = 0;
+			unsigned long long remainder = value;
+
+
+			while ( remainder > 0  &&  return_value < s_BUCKET_COUNT - 1 )
+			{
+				remainder >>= 1;
+				++return_value;
+			}
+
+
+			return return_value;
+		}
+
+		// A function returning the largest value that falls in the given bucket.
+		inline unsigned long long Histogram::bucket_limit( const unsigned int index )
+		{
+			return ( index > 0  ?  ( 1ULL << index ) - 1 : 0 );
+		}
+
+
+		// A function returning the amount of values that fall in the given bucket.
+		inline unsigned long long Histogram::bucket( const unsigned int index ) const
+		{
+			return ( index < s_BUCKET_COUNT  ?  m_buckets[index].load(std::memory_order_relaxed) : 0 );
+		}
+
+		// A function returning the amount of recorded values.
+		inline unsigned long long Histogram::count() const
+		{
+			return m_count.load(std::memory_order_relaxed);
+		}
+
+		// A function returning the sum of the recorded values.
+		inline unsigned long long Histogram::sum() const
+		{
+			return m_sum.load(std::memory_order_relaxed);
+		}
+
+		// A function returning the largest recorded value.
+		inline unsigned long long Histogram::maximum() const
+		{
+			return m_maximum.load(std::memory_order_relaxed);
+		}
+
+	} /* utility */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_UTILITY_HISTOGRAM_INL */
\ No newline at end of file
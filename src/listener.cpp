@@ -36,6 +36,17 @@ namespace athena
 		{
 		}
 
+		/*
+			A function returning whether the listener can be notified on a thread pool thread
+			when the parallel dispatch of the event manager is enabled. A listener is never
+			notified concurrently with itself and always receives its events in order.
+			By default listeners are notified on the thread of the event manager.
+		*/
+		bool Listener::thread_safe() const
+		{
+			return false;
+		}
+
 		// A function responsible of registering an event for the listener.
 		void Listener::register_event( const EventCode& code )
 		{
@@ -46,6 +46,13 @@ namespace athena
 				ATHENA_DLL virtual void on_destroy();
 				// A function to be called when an event occurs.
 				ATHENA_DLL virtual void on_event( const Event& event );
+				/*
+					A function returning whether the listener can be notified on a thread pool thread
+					when the parallel dispatch of the event manager is enabled. A listener is never
+					notified concurrently with itself and always receives its events in order.
+					By default listeners are notified on the thread of the event manager.
+				*/
+				ATHENA_DLL virtual bool thread_safe() const;
 				// A function responsible of registering an event for the listener.
 				ATHENA_DLL void register_event( const EventCode& code );
 				/*
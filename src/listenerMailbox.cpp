@@ -0,0 +1,248 @@
+#include "listenerMailbox.hpp"
+#include "threadPool.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			The pool the dispatched events are allocated from. Dispatched events are allocated
+			by the event manager and usually deallocated by a thread pool thread.
+		*/
+		utility::ObjectPool DispatchedEvent::s_pool(sizeof(DispatchedEvent));
+
+
+		// A constructor of the class that takes over a triggered event. The event is cleaned up once it is released.
+		DispatchedEvent::DispatchedEvent( Event&& event , const DispatchClock::time_point& dispatch_time ) :
+			m_event(std::move(event)) ,
+			m_triggered(true) ,
+			m_dispatch_time(dispatch_time) ,
+			m_references(1)
+		{
+		}
+
+		// A constructor of the class that copies a periodic event, along with the time that has passed since its last trigger.
+		DispatchedEvent::DispatchedEvent( const Event& event , const DispatchClock::time_point& dispatch_time ) :
+			m_event(event) ,
+			m_triggered(false) ,
+			m_dispatch_time(dispatch_time) ,
+			m_references(1)
+		{
+			const Parameter* parameter = event.parameter(0);
+
+
+			/*
+				The first parameter of a periodic event is overwritten on every trigger,
+				so the copy keeps its own value of the elapsed time.
+			*/
+			if ( parameter != NULL  &&  !parameter->stored_inline()  &&  parameter->data() != NULL )
+				m_event.parameter_value(0,DoubleReal,parameter->data());
+		}
+
+		// The destructor of the class.
+		DispatchedEvent::~DispatchedEvent()
+		{
+			// Call the specified callback function that is responsible of performing cleanup for the parameters of a triggered event.
+			if ( m_triggered )
+				m_event.cleanup();
+		}
+
+		// The allocation function of the class, which allocates the object from the pool of the class.
+		void* DispatchedEvent::operator new( size_t size , const std::nothrow_t& ) throw()
+		{
+			return s_pool.allocate(size);
+		}
+
+		// The deallocation function of the class, which returns the object to the pool of the class.
+		void DispatchedEvent::operator delete( void* pointer , size_t size )
+		{
+			s_pool.deallocate(pointer,size);
+		}
+
+		// The deallocation function that is called if the constructor throws after the object was allocated from the pool of the class.
+		void DispatchedEvent::operator delete( void* pointer , const std::nothrow_t& ) throw()
+		{
+			s_pool.deallocate(pointer,sizeof(DispatchedEvent));
+		}
+
+		// A function returning the pool the objects of the class are allocated from.
+		const utility::ObjectPool& DispatchedEvent::pool()
+		{
+			return s_pool;
+		}
+
+
+		// The function that is used by the thread pool task in order to deliver the posted events.
+		int ListenerMailbox::deliver_function( void* parameter )
+		{
+			ListenerMailbox* mailbox = static_cast<ListenerMailbox*>(parameter);
+
+
+			if ( mailbox != NULL )
+				mailbox->deliver_posted_events();
+
+
+			return 0;
+		}
+
+
+		// A function responsible of delivering the posted events.
+		void ListenerMailbox::deliver_posted_events()
+		{
+			unsigned int delivered = 0;
+			bool done = false;
+
+
+			while ( !done )
+			{
+				DispatchedEvent* event = NULL;
+
+
+				m_lock.lock();
+
+				// If every posted event has been delivered, the mailbox is idle.
+				if ( m_events.size() == 0 )
+				{
+					m_scheduled = false;
+					done = true;
+				}
+				else if ( delivered >= s_BATCH_SIZE )
+				{
+					ThreadPool* thread_pool = ThreadPool::get();
+
+
+					// Queue another task for the remaining events so that other tasks are not starved.
+					if ( thread_pool != NULL  &&  thread_pool->add_task(deliver_function,static_cast<void*>(this),NULL,NULL) )
+						done = true;
+					else
+						delivered = 0;
+				}
+				else
+				{
+					event = m_events.front();
+					m_events.pop_front();
+				}
+
+				m_lock.unlock();
+
+				if ( event != NULL )
+				{
+					notify(event->event());
+					record_latency(event->dispatch_time());
+					m_queued.fetch_sub(1,std::memory_order_release);
+					event->release();
+					++delivered;
+				}
+			}
+		}
+
+
+		// The constructor of the class.
+		ListenerMailbox::ListenerMailbox( Listener* listener ) :
+			m_listener(listener) ,
+			m_events(0) ,
+			m_lock() ,
+			m_queued(0) ,
+			m_scheduled(false) ,
+			m_parallel(false) ,
+
+			#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+				m_statistics(NULL) ,
+				m_handler_time() ,
+				m_slow_handlers(0) ,
+
+			#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+			m_latency()
+		{
+		}
+
+		// The destructor of the class. Any posted events are released.
+		ListenerMailbox::~ListenerMailbox()
+		{
+			for (
+					std::deque<DispatchedEvent*>::iterator event_iterator = m_events.begin();
+					event_iterator != m_events.end();
+					++event_iterator
+				)
+			{
+				(*event_iterator)->release();
+			}
+
+			m_events.clear();
+		}
+
+
+		/*
+			A function responsible of posting an event to the mailbox. Returns false if no thread pool
+			task could be queued, in which case the event is not posted.
+		*/
+		bool ListenerMailbox::post( DispatchedEvent* event )
+		{
+			bool schedule = false;
+			bool return_value = true;
+
+
+			event->acquire();
+			m_queued.fetch_add(1,std::memory_order_relaxed);
+
+			m_lock.lock();
+			m_events.push_back(event);
+
+			// If no task is delivering the events of the mailbox, a new one has to be queued.
+			if ( !m_scheduled )
+			{
+				m_scheduled = true;
+				schedule = true;
+			}
+
+			m_lock.unlock();
+
+			if ( schedule )
+			{
+				ThreadPool* thread_pool = ThreadPool::get();
+
+
+				if ( thread_pool == NULL  ||  !thread_pool->add_task(deliver_function,static_cast<void*>(this),NULL,NULL) )
+				{
+					/*
+						Since no task was delivering the events, the mailbox was empty before
+						the event was posted, so taking the event back preserves the order.
+					*/
+					m_lock.lock();
+					m_events.pop_back();
+					m_scheduled = false;
+					m_lock.unlock();
+
+					m_queued.fetch_sub(1,std::memory_order_relaxed);
+					event->release();
+					return_value = false;
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function returning whether there are no posted events and no queued task.
+		bool ListenerMailbox::idle()
+		{
+			bool return_value = false;
+
+
+			m_lock.lock();
+			return_value = ( !m_scheduled  &&  m_events.size() == 0 );
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
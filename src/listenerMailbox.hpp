@@ -0,0 +1,213 @@
+#ifndef ATHENA_CORE_LISTENERMAILBOX_HPP
+#define ATHENA_CORE_LISTENERMAILBOX_HPP
+
+#include "definitions.hpp"
+#include <atomic>
+#include <mutex>
+#include <chrono>
+#include <deque>
+#include <new>
+#include "event.hpp"
+#include "listener.hpp"
+#include "timer.hpp"
+#include "histogram.hpp"
+#include "objectPool.hpp"
+
+#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+	#include "eventStatistics.hpp"
+
+#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A type definition that defines the clock that is used to measure the dispatch latency.
+		typedef std::chrono::steady_clock DispatchClock;
+
+
+		/*
+			A class representing an event that is shared between the listeners it has been posted to.
+			The event is reference counted, so the cleanup of a triggered event is performed
+			once every listener has been notified, regardless of the thread that notified it last.
+		*/
+		class DispatchedEvent
+		{
+			private:
+
+				/*
+					The pool the dispatched events are allocated from. Dispatched events are allocated
+					by the event manager and usually deallocated by a thread pool thread.
+				*/
+				static utility::ObjectPool s_pool;
+
+
+				// The event that is dispatched.
+				Event m_event;
+				// A variable holding whether the event is a triggered event that has to be cleaned up, or a copy of a periodic event.
+				bool m_triggered;
+				// The time the event was dispatched.
+				DispatchClock::time_point m_dispatch_time;
+				// The amount of references to the event.
+				std::atomic<unsigned int> m_references;
+
+
+			public:
+
+				// A constructor of the class that takes over a triggered event. The event is cleaned up once it is released.
+				ATHENA_DLL DispatchedEvent( Event&& event , const DispatchClock::time_point& dispatch_time );
+				// A constructor of the class that copies a periodic event, along with the time that has passed since its last trigger.
+				ATHENA_DLL DispatchedEvent( const Event& event , const DispatchClock::time_point& dispatch_time );
+				// The destructor of the class.
+				ATHENA_DLL ~DispatchedEvent();
+
+				// The allocation function of the class, which allocates the object from the pool of the class.
+				ATHENA_DLL static void* operator new( size_t size , const std::nothrow_t& ) throw();
+				// The deallocation function of the class, which returns the object to the pool of the class.
+				ATHENA_DLL static void operator delete( void* pointer , size_t size );
+				// The deallocation function that is called if the constructor throws after the object was allocated from the pool of the class.
+				ATHENA_DLL static void operator delete( void* pointer , const std::nothrow_t& ) throw();
+				// A function returning the pool the objects of the class are allocated from.
+				ATHENA_DLL static const utility::ObjectPool& pool();
+
+
+				// A function responsible of acquiring a reference to the event.
+				ATHENA_DLL void acquire();
+				// A function responsible of releasing a reference to the event. The event is deallocated when the last reference is released.
+				ATHENA_DLL void release();
+
+
+				// A function returning the event that is dispatched.
+				ATHENA_DLL const Event& event() const;
+				// A function returning the time the event was dispatched.
+				ATHENA_DLL const DispatchClock::time_point& dispatch_time() const;
+		};
+
+
+		/*
+			A class representing the mailbox of a listener, which is used by the event manager
+			in order to notify thread-safe listeners on the thread pool.
+			Events that are posted to the mailbox are delivered one at a time, in the order they were
+			posted, by a single thread pool task. Therefore a listener is never notified concurrently
+			with itself and sees its events in FIFO order, while different listeners run in parallel.
+			The mailbox also keeps the dispatch latency histogram of its listener, in microseconds.
+			If the macro ATHENA_EVENTMANAGER_STATISTICS is defined, the mailbox also times every call
+			to the handler of its listener and reports the calls that exceed the handler budget.
+		*/
+		class ListenerMailbox
+		{
+			private:
+
+				// The maximum amount of events that a task delivers before yielding the thread to other tasks.
+				static const unsigned int s_BATCH_SIZE = 64;
+
+
+				// The listener of the mailbox.
+				Listener* m_listener;
+				// The events that have been posted and not yet delivered.
+				std::deque<DispatchedEvent*> m_events;
+				// A lock that is used to handle concurrency issues.
+				std::mutex m_lock;
+				// The amount of events that have been posted and not yet delivered.
+				std::atomic<unsigned int> m_queued;
+				// A variable holding whether a task is queued or delivering the events.
+				bool m_scheduled;
+				// A variable holding whether the events should be delivered on the thread pool.
+				bool m_parallel;
+
+				#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+					// The statistics the slow handlers of the listener are reported to.
+					EventStatistics* m_statistics;
+					// The histogram of the time the listener has taken to handle each event, in microseconds.
+					utility::Histogram m_handler_time;
+					// The amount of times the listener has exceeded the handler budget.
+					std::atomic<unsigned long long> m_slow_handlers;
+
+				#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+				// The histogram of the time between the dispatch of an event and the return of the listener, in microseconds.
+				utility::Histogram m_latency;
+
+
+				// The function that is used by the thread pool task in order to deliver the posted events.
+				static int deliver_function( void* parameter );
+
+
+				// A function responsible of delivering the posted events.
+				void deliver_posted_events();
+				// A function responsible of recording the dispatch latency of an event.
+				void record_latency( const DispatchClock::time_point& dispatch_time );
+				// A function responsible of notifying the listener of an event.
+				void notify( const Event& event );
+
+				#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+					// A function responsible of recording the time the listener has taken to handle an event, reporting it if it exceeds the handler budget.
+					void record_handler_time( const EventCode code , const DispatchClock::time_point& start_time );
+
+				#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL explicit ListenerMailbox( Listener* listener );
+				// The destructor of the class. Any posted events are released.
+				ATHENA_DLL ~ListenerMailbox();
+
+
+				// A function responsible of setting whether the events should be delivered on the thread pool.
+				ATHENA_DLL void parallel( const bool value );
+				/*
+					A function responsible of posting an event to the mailbox. Returns false if no thread pool
+					task could be queued, in which case the event is not posted.
+				*/
+				ATHENA_DLL bool post( DispatchedEvent* event );
+				// A function responsible of notifying the listener directly on the calling thread.
+				ATHENA_DLL void deliver( const Event& event , const DispatchClock::time_point& dispatch_time );
+
+
+				// A function returning the listener of the mailbox.
+				ATHENA_DLL Listener* listener() const;
+				// A function returning whether the events should be delivered on the thread pool.
+				ATHENA_DLL bool parallel() const;
+				/*
+					A function returning whether the next event has to be posted, either because the
+					mailbox is parallel or because previously posted events have not been delivered yet.
+				*/
+				ATHENA_DLL bool deferred() const;
+				// A function returning whether there are no posted events and no queued task.
+				ATHENA_DLL bool idle();
+				// A function returning the dispatch latency histogram of the listener.
+				ATHENA_DLL const utility::Histogram& latency() const;
+
+				#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+					// A function responsible of setting the statistics the slow handlers of the listener are reported to.
+					ATHENA_DLL void statistics( EventStatistics* statistics );
+
+
+					// A function returning the histogram of the time the listener has taken to handle each event, in microseconds.
+					ATHENA_DLL const utility::Histogram& handler_time() const;
+					// A function returning the amount of times the listener has exceeded the handler budget.
+					ATHENA_DLL unsigned long long slow_handlers() const;
+
+				#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "listenerMailbox.inl"
+
+
+
+#endif /* ATHENA_CORE_LISTENERMAILBOX_HPP */
\ No newline at end of file
@@ -0,0 +1,162 @@
+#ifndef ATHENA_CORE_LISTENERMAILBOX_INL
+#define ATHENA_CORE_LISTENERMAILBOX_INL
+
+#ifndef ATHENA_CORE_LISTENERMAILBOX_HPP
+	#error "listenerMailbox.hpp must be included before listenerMailbox.inl"
+#endif /* ATHENA_CORE_LISTENERMAILBOX_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of acquiring a reference to the event.
+		inline void DispatchedEvent::acquire()
+		{
+			m_references.fetch_add(1,std::memory_order_relaxed);
+		}
+
+		// A function responsible of releasing a reference to the event. The event is deallocated when the last reference is released.
+		inline void DispatchedEvent::release()
+		{
+			if ( m_references.fetch_sub(1,std::memory_order_acq_rel) == 1 )
+				delete this;
+		}
+
+
+		// A function returning the event that is dispatched.
+		inline const Event& DispatchedEvent::event() const
+		{
+			return m_event;
+		}
+
+		// A function returning the time the event was dispatched.
+		inline const DispatchClock::time_point& DispatchedEvent::dispatch_time() const
+		{
+			return m_dispatch_time;
+		}
+
+
+		// A function responsible of recording the dispatch latency of an event.
+		inline void ListenerMailbox::record_latency( const DispatchClock::time_point& dispatch_time )
+		{
+			m_latency.record(static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(DispatchClock::now() - dispatch_time).count()));
+		}
+
+		// A function responsible of notifying the listener of an event.
+		inline void ListenerMailbox::notify( const Event& event )
+		{
+			#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+				DispatchClock::time_point start_time = DispatchClock::now();
+
+
+				m_listener->on_event(event);
+				record_handler_time(event.code(),start_time);
+
+			#else
+
+				m_listener->on_event(event);
+
+			#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+		}
+
+		#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+			// A function responsible of recording the time the listener has taken to handle an event, reporting it if it exceeds the handler budget.
+			inline void ListenerMailbox::record_handler_time( const EventCode code , const DispatchClock::time_point& start_time )
+			{
+				unsigned long long handler_time = static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(DispatchClock::now() - start_time).count());
+				unsigned long long budget = ( m_statistics != NULL  ?  m_statistics->handler_budget() : 0 );
+
+
+				m_handler_time.record(handler_time);
+
+				if ( budget > 0  &&  handler_time > budget )
+				{
+					unsigned long long count = m_slow_handlers.fetch_add(1,std::memory_order_relaxed) + 1;
+
+
+					// Only every power of two (2) occurrence is reported.
+					if ( ( count & ( count - 1 ) ) == 0 )
+						m_statistics->report_slow_handler(m_listener,code,handler_time,count);
+				}
+			}
+
+		#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+
+		// A function responsible of setting whether the events should be delivered on the thread pool.
+		inline void ListenerMailbox::parallel( const bool value )
+		{
+			m_parallel = value;
+		}
+
+		// A function responsible of notifying the listener directly on the calling thread.
+		inline void ListenerMailbox::deliver( const Event& event , const DispatchClock::time_point& dispatch_time )
+		{
+			notify(event);
+			record_latency(dispatch_time);
+		}
+
+
+		// A function returning the listener of the mailbox.
+		inline Listener* ListenerMailbox::listener() const
+		{
+			return m_listener;
+		}
+
+		// A function returning whether the events should be delivered on the thread pool.
+		inline bool ListenerMailbox::parallel() const
+		{
+			return m_parallel;
+		}
+
+		/*
+			A function returning whether the next event has to be posted, either because the
+			mailbox is parallel or because previously posted events have not been delivered yet.
+		*/
+		inline bool ListenerMailbox::deferred() const
+		{
+			return ( m_parallel  ||  m_queued.load(std::memory_order_acquire) > 0 );
+		}
+
+		// A function returning the dispatch latency histogram of the listener.
+		inline const utility::Histogram& ListenerMailbox::latency() const
+		{
+			return m_latency;
+		}
+
+		#ifdef ATHENA_EVENTMANAGER_STATISTICS
+
+			// A function responsible of setting the statistics the slow handlers of the listener are reported to.
+			inline void ListenerMailbox::statistics( EventStatistics* statistics )
+			{
+				m_statistics = statistics;
+			}
+
+
+			// A function returning the histogram of the time the listener has taken to handle each event, in microseconds.
+			inline const utility::Histogram& ListenerMailbox::handler_time() const
+			{
+				return m_handler_time;
+			}
+
+			// A function returning the amount of times the listener has exceeded the handler budget.
+			inline unsigned long long ListenerMailbox::slow_handlers() const
+			{
+				return m_slow_handlers.load(std::memory_order_relaxed);
+			}
+
+		#endif /* ATHENA_EVENTMANAGER_STATISTICS */
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_LISTENERMAILBOX_INL */
\ No newline at end of file
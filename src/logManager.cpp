@@ -2,6 +2,9 @@
 #include <cstring>
 #include <iostream>
 #include <cwchar>
+#include <algorithm>
+#include <chrono>
+#include <thread>
 #include "athena.hpp"
 #include "eventCodes.hpp"
 
@@ -24,6 +27,34 @@ namespace athena
 		std::mutex LogManager::s_instance_lock;
 		// The maximum possible size for the buffer that is used in the functions of the class.
 		const unsigned int LogManager::s_MAX_BUFFER_SIZE = 1024;
+		// The longest time that a record waits for the writer thread, in milliseconds.
+		const unsigned int LogManager::s_WRITER_PERIOD = 10;
+		// The amount of log managers that have been created, which is used to tell apart the ring buffers of different instances.
+		std::atomic<unsigned long long> LogManager::s_instance_count(0);
+		// The ring buffer of the current thread.
+		ATHENA_THREAD_LOCAL LogRingBuffer* LogManager::s_thread_ring_buffer = NULL;
+		// The identifier of the log manager that the ring buffer of the current thread belongs to.
+		ATHENA_THREAD_LOCAL unsigned long long LogManager::s_thread_ring_buffer_owner = 0;
+
+
+		// The function that is run by the writer thread.
+		int LogManager::writer_function( void* parameter )
+		{
+			LogManager* manager = static_cast<LogManager*>(parameter);
+
+
+			if ( manager != NULL )
+				manager->write_loop();
+
+
+			return 0;
+		}
+
+		// Function returning whether the first record was written before the second one, which is used to order the records of a batch.
+		bool LogManager::earlier( const LogRecord* first , const LogRecord* second )
+		{
+			return ( first->m_time < second->m_time );
+		}
 
 
 		// The constructor of the class.
@@ -48,40 +79,79 @@ namespace athena
 			m_auto_dump_offset(0),
 			m_auto_purge(false),
 			m_auto_dump(false),
-			m_echo(false)
+			m_echo(false),
+			m_timestamp_time(static_cast<time_t>(-1)),
+			m_timestamp(),
+			m_identifier(s_instance_count.fetch_add(1,std::memory_order_relaxed)+1),
+			m_ring_buffers(),
+			m_released_ring_buffers(),
+			m_free_ring_buffers(),
+			m_ring_buffer_lock(),
+			m_writer_ring_buffers(),
+			m_writer_released_ring_buffers(),
+			m_writer_counts(),
+			m_writer_records(),
+			m_writer_events(),
+			m_writer(),
+			m_writer_lock(),
+			m_writer_condition_variable(),
+			m_flush_requests(0),
+			m_flushed(0),
+			m_writer_signalled(false),
+			m_writer_run(false),
+			m_writer_active(false),
+			m_asynchronous(false),
+			m_logging_threads(0),
+			m_dropped_records(0)
 		{
 		}
 
 		// The destructor of the class.
 		LogManager::~LogManager()
 		{
+			// Stop the writer thread, which adds the pending records to the log.
+			asynchronous(false);
+
 			if ( m_auto_dump_filestream.is_open() )
 				m_auto_dump_filestream.close();
 
 			cleanup();
+
+			// The released ring buffers are still listed along with the ring buffers in use, so they are only deleted once.
+			for ( std::vector<LogRingBuffer*>::iterator ring_buffer_iterator = m_ring_buffers.begin();  ring_buffer_iterator != m_ring_buffers.end();  ++ring_buffer_iterator )
+				delete (*ring_buffer_iterator);
+
+			for ( std::vector<LogRingBuffer*>::iterator ring_buffer_iterator = m_free_ring_buffers.begin();  ring_buffer_iterator != m_free_ring_buffers.end();  ++ring_buffer_iterator )
+				delete (*ring_buffer_iterator);
+
+			m_ring_buffers.clear();
+			m_released_ring_buffers.clear();
+			m_free_ring_buffers.clear();
 		}
 
 
-		// Function responsible of generating a string with the current timestamp.
-		std::string LogManager::generate_timestamp()
+		// Function responsible of generating a string with the timestamp of the given time.
+		const std::string& LogManager::generate_timestamp( const time_t time )
 		{
-			// The current time.
-			time_t now = time(NULL);
 			// The struct that is used to store the date and time.
 			struct tm date;
 			// The stream that is used to buffer the output stream.
 			std::stringstream return_value_buffer;
 
 
+			// Entries are written in bursts, so the timestamp is only generated again when the time changes.
+			if ( time == m_timestamp_time )
+				return m_timestamp;
+
 			// Setting the date struct to zero.
 			memset(&date,'\0',sizeof(date));
 
-			// Get the current local time and date from the time_t value.
+			// Get the local time and date from the time_t value. The reentrant variants are used, since entries are also timestamped by the writer thread.
 
 			#ifdef _WIN32
-				localtime_s(&date,&now);
+				localtime_s(&date,&time);
 			#else
-				memcpy(&date,localtime(&now),sizeof(tm));
+				localtime_r(&time,&date);
 			#endif /* _WIN32 */
 
 			// Append a zero to the day of the month if it is less than 10.
@@ -122,8 +192,12 @@ namespace athena
 			return_value_buffer << date.tm_sec;
 
 
-			// Output the buffer as a string.
-			return return_value_buffer.str();
+			// Keep the timestamp for the entries that are written during the same second.
+			m_timestamp_time = time;
+			m_timestamp = return_value_buffer.str();
+
+
+			return m_timestamp;
 		}
 
 		// Function responsible of updating the timestamps of the log with the new separator.
@@ -183,8 +257,8 @@ namespace athena
 					break;
 			}
 
-			// Output the message separator and the message of the entry.
-			(*stream) << m_message_separator << entry.message() << std::endl;
+			// Output the message separator and the message of the entry. The stream is flushed by the caller, once for every batch of entries.
+			(*stream) << m_message_separator << entry.message() << '\n';
 		}
 
 		// Function dumping the contents from the log to the given stream starting from offset.
@@ -200,6 +274,8 @@ namespace athena
 				for ( std::deque<LogEntryA*>::iterator log_iterator = m_log.begin()+offset;  log_iterator != m_log.end();  ++log_iterator )
 					post_entry(stream,(*(*log_iterator)));
 
+				stream->flush();
+
 				// If the stream is in a good condition at the end of the output.
 				if ( stream->good() )
 					return_value = true;	// The log was dumped successfully.
@@ -318,35 +394,349 @@ namespace athena
 			return buffer;
 		}
 
+		// Function responsible of adding the given entry to the log and performing the echo, auto-dump and auto-purge functionalities. Must be called with the lock held.
+		void LogManager::add_entry( LogEntryA* entry )
+		{
+			// Insert the new entry to the log.
+			m_log.push_back(entry);
+			// Increase the auto dump counter.
+			++m_auto_dump_count;
+
+			// If echoing is enabled.
+			if ( m_echo )
+				post_entry(m_echo_stream,(*entry)); // Output the new entry to the echo stream.
+
+			// Manage the size of the log and perform the auto-dump and auto-purge functionality if needed.
+			manage_log_size();
+		}
+
 		// Function responsible of adding a new entry of the given type and with the given message to the log.
 		void LogManager::log_entry( const LogEntryType& type , const std::string& message )
 		{
-			LogEntryA* entry = new (std::nothrow) LogEntryA(type,message,generate_timestamp());
+			log_entry(type,message.c_str(),message.size());
+		}
+
+		// Function responsible of adding a new entry of the given type and with the given message of the given length to the log.
+		void LogManager::log_entry( const LogEntryType& type , const char* message , const size_t length )
+		{
+			LogRingBuffer* ring_buffer = NULL;
+			bool done = false;
+
+
+			// The thread is counted before the mode is read, so that disabling the mode waits for its record to be committed.
+			m_logging_threads.fetch_add(1,std::memory_order_seq_cst);
+
+			if ( m_asynchronous.load(std::memory_order_seq_cst) )
+				ring_buffer = thread_ring_buffer();
+
+			// In asynchronous mode, the message is copied to the ring buffer of the thread and the writer thread does the rest.
+			if ( ring_buffer != NULL )
+			{
+				LogRecord* record = ring_buffer->reserve();
+
+
+				if ( record != NULL )
+				{
+					size_t record_length = std::min<size_t>(length,LogRecord::s_MESSAGE_SIZE-1);
+
+
+					record->m_time = std::chrono::steady_clock::now();
+					record->m_type = type;
+					record->m_length = static_cast<unsigned int>(record_length);
+					memcpy(record->m_message,message,record_length);
+					record->m_message[record_length] = '\0';
+
+					if ( ring_buffer->commit() )
+						wake_writer();
+
+					done = true;
+				}
+				// An error that does not fit in the ring buffer is added synchronously instead, since it must not be lost.
+				else if ( type != Error )
+				{
+					m_dropped_records.fetch_add(1,std::memory_order_relaxed);
+					done = true;
+				}
+			}
+
+			m_logging_threads.fetch_sub(1,std::memory_order_seq_cst);
+
+			if ( !done )
+			{
+				LogEntryA* entry = NULL;
+
+
+				m_lock.lock();
+				entry = new (std::nothrow) LogEntryA(type,std::string(message,length),generate_timestamp(time(NULL)));
+
+				if ( entry != NULL )
+				{
+					add_entry(entry);
+
+					if ( m_echo )
+						m_echo_stream->flush();
+				}
+
+				m_lock.unlock();
+
+				if ( entry != NULL )
+				{
+					// Create the event that will be fired when a new entry is inserted.
+					core::Event event(EVENT_LOG_NEW_ENTRY);
+
+
+					// Set the first parameter of the event to the new entry.
+					event.parameter(0,core::ParameterType::Pointer,static_cast<void*>(entry));
+					// Trigger the event.
+					athena::trigger_event(event);
+				}
+			}
+		}
+
+		// Function responsible of adding a new entry of the given type and with the message formatted from the given parameters to the log.
+		void LogManager::log_formatted_entry( const LogEntryType& type , const char* format , va_list parameters )
+		{
+			LogRingBuffer* ring_buffer = NULL;
+			bool done = false;
 
 
-			if ( entry != NULL )
+			// The thread is counted before the mode is read, so that disabling the mode waits for its record to be committed.
+			m_logging_threads.fetch_add(1,std::memory_order_seq_cst);
+
+			if ( m_asynchronous.load(std::memory_order_seq_cst) )
+				ring_buffer = thread_ring_buffer();
+
+			// In asynchronous mode, the message is formatted straight into the ring buffer of the thread.
+			if ( ring_buffer != NULL )
 			{
-				// Create the event that will be fired when a new entry is inserted.
-				core::Event event(EVENT_LOG_NEW_ENTRY);
+				LogRecord* record = ring_buffer->reserve();
+
 
+				if ( record != NULL )
+				{
+					record->m_message[0] = '\0';
+
+					#ifdef _WIN32
+						vsnprintf_s(record->m_message,LogRecord::s_MESSAGE_SIZE,_TRUNCATE,format,parameters);
+					#else
+						vsnprintf(record->m_message,LogRecord::s_MESSAGE_SIZE,format,parameters);
+					#endif
+
+					record->m_time = std::chrono::steady_clock::now();
+					record->m_type = type;
+					record->m_length = static_cast<unsigned int>(strlen(record->m_message));
+
+					if ( ring_buffer->commit() )
+						wake_writer();
 
-				// Insert the new entry to the log.
-				m_log.push_back(entry);
-				// Increase the auto dump counter.
-				++m_auto_dump_count;
+					done = true;
+				}
+				// An error that does not fit in the ring buffer is added synchronously instead, since it must not be lost.
+				else if ( type != Error )
+				{
+					m_dropped_records.fetch_add(1,std::memory_order_relaxed);
+					done = true;
+				}
+			}
+
+			m_logging_threads.fetch_sub(1,std::memory_order_seq_cst);
+
+			if ( !done )
+				log_entry(type,parse_parameters(format,parameters));
+		}
+
+		// Function returning the ring buffer of the calling thread, or NULL if it could not be allocated.
+		LogRingBuffer* LogManager::thread_ring_buffer()
+		{
+			// The ring buffer of the thread is only assigned the first time the thread logs in asynchronous mode.
+			if ( s_thread_ring_buffer_owner != m_identifier )
+			{
+				LogRingBuffer* ring_buffer = NULL;
+
+
+				// A ring buffer that has been released by another thread is reused before a new one is allocated.
+				m_ring_buffer_lock.lock();
+
+				if ( m_free_ring_buffers.size() > 0 )
+				{
+					ring_buffer = m_free_ring_buffers.back();
+					m_free_ring_buffers.pop_back();
+					m_ring_buffers.push_back(ring_buffer);
+				}
+
+				m_ring_buffer_lock.unlock();
+
+				if ( ring_buffer == NULL )
+				{
+					ring_buffer = new (std::nothrow) LogRingBuffer(s_RING_BUFFER_CAPACITY);
+
+					if ( ring_buffer != NULL  &&  ring_buffer->valid() )
+					{
+						m_ring_buffer_lock.lock();
+						m_ring_buffers.push_back(ring_buffer);
+						m_ring_buffer_lock.unlock();
+					}
+					else
+					{
+						delete ring_buffer;
+						ring_buffer = NULL;
+					}
+				}
+
+				if ( ring_buffer != NULL )
+				{
+					s_thread_ring_buffer = ring_buffer;
+					s_thread_ring_buffer_owner = m_identifier;
+				}
+				else
+					s_thread_ring_buffer = NULL;
+			}
+
+
+			return ( s_thread_ring_buffer_owner == m_identifier  ?  s_thread_ring_buffer : NULL );
+		}
+
+		// Function responsible of waking up the writer thread.
+		void LogManager::wake_writer()
+		{
+			m_writer_lock.lock();
+			m_writer_signalled = true;
+			m_writer_condition_variable.notify_all();
+			m_writer_lock.unlock();
+		}
+
+		// Function responsible of adding the records of every ring buffer to the log. Returns the amount of records that were added.
+		size_t LogManager::write_records()
+		{
+			size_t return_value = 0;
+
+
+			/*
+				Take a snapshot of the ring buffers, since threads may register new ones while the records are written.
+				The ring buffers that have been released by then hold their last records, so they are reclaimed once this pass has added them.
+			*/
+			m_ring_buffer_lock.lock();
+			m_writer_ring_buffers.assign(m_ring_buffers.begin(),m_ring_buffers.end());
+			m_writer_released_ring_buffers.swap(m_released_ring_buffers);
+			m_ring_buffer_lock.unlock();
+
+			m_writer_counts.clear();
+			m_writer_records.clear();
+			m_writer_events.clear();
+
+			// Gather the records that are available in every ring buffer. They are read in place and released once they have been added.
+			for ( std::vector<LogRingBuffer*>::iterator ring_buffer_iterator = m_writer_ring_buffers.begin();  ring_buffer_iterator != m_writer_ring_buffers.end();  ++ring_buffer_iterator )
+			{
+				size_t count = (*ring_buffer_iterator)->size();
+
+
+				m_writer_counts.push_back(count);
+
+				for ( size_t i = 0;  i < count;  ++i )
+					m_writer_records.push_back(&(*ring_buffer_iterator)->record(i));
+			}
+
+			if ( m_writer_records.size() > 0 )
+			{
+				// The records are written by the steady clock, which is mapped to the system clock once for the whole batch.
+				std::chrono::steady_clock::time_point steady_now = std::chrono::steady_clock::now();
+				std::chrono::system_clock::time_point system_now = std::chrono::system_clock::now();
+
+
+				// Merge the records of the threads in the order they were written.
+				std::stable_sort(m_writer_records.begin(),m_writer_records.end(),earlier);
+
+				m_lock.lock();
+
+				for ( std::vector<const LogRecord*>::iterator record_iterator = m_writer_records.begin();  record_iterator != m_writer_records.end();  ++record_iterator )
+				{
+					const LogRecord& record = *(*record_iterator);
+					time_t record_time = std::chrono::system_clock::to_time_t(system_now - std::chrono::duration_cast<std::chrono::system_clock::duration>(steady_now - record.m_time));
+					LogEntryA* entry = new (std::nothrow) LogEntryA(record.m_type,std::string(record.m_message,record.m_length),generate_timestamp(record_time));
+
+
+					if ( entry != NULL )
+					{
+						core::Event event(EVENT_LOG_NEW_ENTRY);
+
+
+						add_entry(entry);
+						event.parameter(0,core::ParameterType::Pointer,static_cast<void*>(entry));
+						m_writer_events.push_back(event);
+					}
+				}
 
-				// If echoing is enabled.
 				if ( m_echo )
-					post_entry(m_echo_stream,(*entry)); // Output the new entry to the echo stream.
+					m_echo_stream->flush();
+
+				m_lock.unlock();
 
-				// Manage the size of the log and perform the auto-dump and auto-purge functionality if needed.
-				manage_log_size();
+				// Release the records that were added.
+				for ( size_t i = 0;  i < m_writer_ring_buffers.size();  ++i )
+					m_writer_ring_buffers[i]->pop(m_writer_counts[i]);
 
-				// Set the first parameter of the event to the new entry.
-				event.parameter(0,core::ParameterType::Pointer,static_cast<void*>(entry));
-				// Trigger the event.
-				athena::trigger_event(event);
+				// Trigger the new entry events of the whole batch at once.
+				if ( m_writer_events.size() > 0 )
+					athena::trigger_events(&m_writer_events[0],&m_writer_events[0]+m_writer_events.size());
+
+				return_value = m_writer_records.size();
 			}
+
+			// Move the released ring buffers, which are now empty, to the free ring buffers.
+			if ( m_writer_released_ring_buffers.size() > 0 )
+			{
+				m_ring_buffer_lock.lock();
+
+				for ( std::vector<LogRingBuffer*>::iterator ring_buffer_iterator = m_writer_released_ring_buffers.begin();  ring_buffer_iterator != m_writer_released_ring_buffers.end();  ++ring_buffer_iterator )
+				{
+					m_ring_buffers.erase(std::find(m_ring_buffers.begin(),m_ring_buffers.end(),(*ring_buffer_iterator)));
+					m_free_ring_buffers.push_back(*ring_buffer_iterator);
+				}
+
+				m_ring_buffer_lock.unlock();
+				m_writer_released_ring_buffers.clear();
+			}
+
+
+			return return_value;
+		}
+
+		// Function responsible of writing the records as they arrive, until the asynchronous mode is disabled.
+		void LogManager::write_loop()
+		{
+			m_writer_lock.lock();
+
+			while ( m_writer_run )
+			{
+				unsigned long long flush_requests = 0;
+
+
+				// Wait until a ring buffer becomes half full, a flush is requested or the period elapses.
+				if ( !m_writer_signalled  &&  m_flush_requests == m_flushed )
+					m_writer_condition_variable.wait_for(m_writer_lock,std::chrono::milliseconds(s_WRITER_PERIOD));
+
+				flush_requests = m_flush_requests;
+				m_writer_signalled = false;
+				m_writer_lock.unlock();
+
+				// Every record that was committed before the flush requests were read is written by this pass.
+				write_records();
+
+				m_writer_lock.lock();
+				m_flushed = flush_requests;
+				m_writer_condition_variable.notify_all();
+			}
+
+			m_writer_lock.unlock();
+
+			// Write the records that are still pending before the thread exits.
+			write_records();
+
+			m_writer_lock.lock();
+			m_flushed = m_flush_requests;
+			m_writer_active = false;
+			m_writer_condition_variable.notify_all();
+			m_writer_lock.unlock();
 		}
 
 
@@ -394,6 +784,7 @@ namespace athena
 		// Function responsible of perfoming any actions needed on termination.
 		void LogManager::terminate()
 		{
+			asynchronous(false);
 			unregister_all_events();
 		}
 
@@ -549,9 +940,100 @@ namespace athena
 		{
 			m_lock.lock();
 			update_timestamps(separator);
+			m_timestamp_time = static_cast<time_t>(-1);
 			m_lock.unlock();
 		}
 
+		/*
+			Function responsible of enabling or disabling the asynchronous mode. Enabling the mode spawns the writer thread,
+			and disabling it adds every pending record to the log before the writer thread exits.
+			The mode must not be changed by more than one thread at a time.
+		*/
+		void LogManager::asynchronous( const bool value )
+		{
+			bool stop = false;
+
+
+			m_writer_lock.lock();
+
+			if ( value  &&  !m_writer_run  &&  !m_writer_active )
+			{
+				m_writer_run = true;
+				m_writer_active = true;
+
+				// The writer thread waits for the lock before it starts writing, so it is safe to spawn it while holding the lock.
+				if ( m_writer.start("athena-log",writer_function,static_cast<void*>(this)) )
+					m_asynchronous.store(true,std::memory_order_release);
+				else
+				{
+					m_writer_run = false;
+					m_writer_active = false;
+				}
+			}
+			else if ( !value  &&  m_writer_run )
+			{
+				m_asynchronous.store(false,std::memory_order_seq_cst);
+				stop = true;
+			}
+
+			m_writer_lock.unlock();
+
+			if ( stop )
+			{
+				/*
+					Wait for the threads that are still writing a record to their ring buffer, without the lock, since they may need it to wake up the writer thread.
+					Only then is the writer thread stopped, so that its final pass adds their records and no ring buffer is in use once it exits.
+				*/
+				while ( m_logging_threads.load(std::memory_order_seq_cst) > 0 )
+					std::this_thread::yield();
+
+				m_writer_lock.lock();
+				m_writer_run = false;
+				m_writer_condition_variable.notify_all();
+				m_writer_lock.unlock();
+
+				// The writer thread is joined without the lock, since it needs it in order to finish.
+				m_writer.join();
+			}
+		}
+
+		// Function responsible of blocking until every record that has been written in asynchronous mode before the call has been added to the log.
+		void LogManager::flush_log()
+		{
+			m_writer_lock.lock();
+
+			if ( m_writer_active )
+			{
+				unsigned long long flush_request = ++m_flush_requests;
+
+
+				m_writer_condition_variable.notify_all();
+
+				while ( m_writer_active  &&  m_flushed < flush_request )
+					m_writer_condition_variable.wait(m_writer_lock);
+			}
+
+			m_writer_lock.unlock();
+		}
+
+		/*
+			Function responsible of releasing the ring buffer of the calling thread, so that it can be reused by another thread once
+			its records have been added to the log. Should be called by threads that have logged in asynchronous mode before they exit.
+			A thread that logs again afterwards is given a ring buffer anew.
+		*/
+		void LogManager::release_thread_buffer()
+		{
+			if ( s_thread_ring_buffer_owner == m_identifier )
+			{
+				m_ring_buffer_lock.lock();
+				m_released_ring_buffers.push_back(s_thread_ring_buffer);
+				m_ring_buffer_lock.unlock();
+
+				s_thread_ring_buffer = NULL;
+				s_thread_ring_buffer_owner = 0;
+			}
+		}
+
 		// Function responsible of logging an error formatted as the given string. The format has the same functionality as printf.
 		void LogManager::log_error( const char* format , ... )
 		{
@@ -559,7 +1041,7 @@ namespace athena
 
 
 			va_start(arguments,format);
-			log_entry(Error,parse_parameters(format,arguments));
+			log_formatted_entry(Error,format,arguments);
 			va_end(arguments);
 		}
 
@@ -581,7 +1063,7 @@ namespace athena
 
 
 			va_start(arguments,format);
-			log_entry(Warning,parse_parameters(format,arguments));
+			log_formatted_entry(Warning,format,arguments);
 			va_end(arguments);
 		}
 
@@ -603,7 +1085,7 @@ namespace athena
 
 
 			va_start(arguments,format);
-			log_entry(Message,parse_parameters(format,arguments));
+			log_formatted_entry(Message,format,arguments);
 			va_end(arguments);
 		}
 
@@ -624,13 +1106,21 @@ namespace athena
 			std::ofstream stream(filename,( mode == Append  ?  std::ofstream::ate : std::ofstream::trunc ));
 
 
+			// The entries that are pending in asynchronous mode are added to the log first, since the writer thread may be changing it.
+			flush_log();
+
 			if ( stream.is_open() )
+			{
+				m_lock.lock();
 				dump_log(&stream,0);
+				m_lock.unlock();
+			}
 		}
 
 		// Function responsible of purging the log. If the auto dump mode is enabled, the contents of the log are dumped to the auto-dump file.
 		void LogManager::purge_log()
 		{
+			flush_log();
 			m_lock.lock();
 			manage_log_size();
 			cleanup();
@@ -852,6 +1342,18 @@ namespace athena
 			return return_value;
 		}
 
+		// Function returning whether the asynchronous mode is enabled.
+		bool LogManager::asynchronous() const
+		{
+			return m_asynchronous.load(std::memory_order_acquire);
+		}
+
+		// Function returning the amount of records that have been dropped because the ring buffer of their thread was full.
+		unsigned long long LogManager::dropped_log_records() const
+		{
+			return m_dropped_records.load(std::memory_order_relaxed);
+		}
+
 		// Function returning the size of the log.
 		unsigned int LogManager::log_size() const
 		{
@@ -2,14 +2,20 @@
 #define ATHENA_IO_LOGMANAGER_HPP
 
 #include "definitions.hpp"
+#include <atomic>
 #include <mutex>
+#include <condition_variable>
 #include <deque>
+#include <vector>
+#include <ctime>
 #include <exception>
 #include <fstream>
 #include <cstdarg>
 #include "logEntry.hpp"
+#include "logRingBuffer.hpp"
 #include "athena.hpp"
 #include "listener.hpp"
+#include "serviceThread.hpp"
 
 
 
@@ -31,6 +37,14 @@ namespace athena
 
 		/*
 			A singleton class responsible of handling an ASCII log for the application.
+			In asynchronous mode, every thread writes its entries as fixed-size records to its own lock-free ring buffer,
+			and a dedicated writer thread adds them to the log in batches, ordered by the time they were written, so logging
+			neither allocates nor takes a lock on the calling thread. The echo, auto-dump and auto-purge functionalities
+			and the new entry events are then performed by the writer thread. A record that does not fit in the ring buffer
+			of its thread is dropped and counted, instead of blocking the thread, unless it is an error, which is added synchronously
+			instead and may therefore precede records that were written before it. Longer messages are truncated.
+			A thread that stops logging, such as a thread that is about to exit, should release its ring buffer, which is then
+			reused by the next thread that needs one, once the writer thread has added its records. The threads of the pool do so on their own.
 		*/
 		class LogManager : public core::Listener
 		{
@@ -42,6 +56,16 @@ namespace athena
 				static std::mutex s_instance_lock;
 				// The maximum possible size for the buffer that is used in the functions of the class.
 				static const unsigned int s_MAX_BUFFER_SIZE;
+				// The capacity of the ring buffer of every thread in asynchronous mode.
+				static const size_t s_RING_BUFFER_CAPACITY = 1024;
+				// The longest time that a record waits for the writer thread, in milliseconds.
+				static const unsigned int s_WRITER_PERIOD;
+				// The amount of log managers that have been created, which is used to tell apart the ring buffers of different instances.
+				static std::atomic<unsigned long long> s_instance_count;
+				// The ring buffer of the current thread.
+				static ATHENA_THREAD_LOCAL LogRingBuffer* s_thread_ring_buffer;
+				// The identifier of the log manager that the ring buffer of the current thread belongs to.
+				static ATHENA_THREAD_LOCAL unsigned long long s_thread_ring_buffer_owner;
 
 
 				// A list of the entries that represent the log.
@@ -84,6 +108,52 @@ namespace athena
 				bool m_auto_dump;
 				// Whether echoing is enabled.
 				bool m_echo;
+				// The time of the last generated timestamp.
+				time_t m_timestamp_time;
+				// The last generated timestamp.
+				std::string m_timestamp;
+				// The identifier of the log manager.
+				unsigned long long m_identifier;
+				// The ring buffers of the threads that have logged in asynchronous mode.
+				std::vector<LogRingBuffer*> m_ring_buffers;
+				// The ring buffers that have been released by their threads and not yet reclaimed by the writer thread.
+				std::vector<LogRingBuffer*> m_released_ring_buffers;
+				// The ring buffers that have been reclaimed and can be given to other threads.
+				std::vector<LogRingBuffer*> m_free_ring_buffers;
+				// A lock that is used to handle concurrency issues regarding the ring buffers.
+				std::mutex m_ring_buffer_lock;
+				// The ring buffers that are being written by the writer thread.
+				std::vector<LogRingBuffer*> m_writer_ring_buffers;
+				// The released ring buffers that are reclaimed by the current pass of the writer thread.
+				std::vector<LogRingBuffer*> m_writer_released_ring_buffers;
+				// The amount of records that are being written from each ring buffer by the writer thread.
+				std::vector<size_t> m_writer_counts;
+				// The records that are being written by the writer thread.
+				std::vector<const LogRecord*> m_writer_records;
+				// The new entry events of the records that are being written by the writer thread.
+				std::vector<core::Event> m_writer_events;
+				// The writer thread.
+				core::ServiceThread m_writer;
+				// A lock that is used to handle concurrency issues regarding the writer thread.
+				std::mutex m_writer_lock;
+				// The condition variable that the writer thread waits on.
+				std::condition_variable_any m_writer_condition_variable;
+				// The amount of times the records have been requested to be written.
+				unsigned long long m_flush_requests;
+				// The amount of requests that the writer thread has completed.
+				unsigned long long m_flushed;
+				// Whether the writer thread has been woken up.
+				bool m_writer_signalled;
+				// Whether the writer thread should keep running.
+				bool m_writer_run;
+				// Whether the writer thread is running.
+				bool m_writer_active;
+				// Whether the asynchronous mode is enabled.
+				std::atomic<bool> m_asynchronous;
+				// The amount of threads that are writing a record while the asynchronous mode may be enabled. Disabling the mode waits for them.
+				std::atomic<unsigned int> m_logging_threads;
+				// The amount of records that have been dropped because the ring buffer of their thread was full. Errors are never dropped.
+				std::atomic<unsigned long long> m_dropped_records;
 
 
 				// The constructor of the class.
@@ -92,8 +162,14 @@ namespace athena
 				~LogManager();
 
 
-				// Function responsible of generating a string with the current timestamp.
-				std::string generate_timestamp();
+				// The function that is run by the writer thread.
+				static int writer_function( void* parameter );
+				// Function returning whether the first record was written before the second one, which is used to order the records of a batch.
+				static bool earlier( const LogRecord* first , const LogRecord* second );
+
+
+				// Function responsible of generating a string with the timestamp of the given time.
+				const std::string& generate_timestamp( const time_t time );
 				// Function responsible of updating the timestamps of the log with the new separator.
 				void update_timestamps( const std::string& new_separator );
 				// Function posting an entry to the given stream.
@@ -110,8 +186,22 @@ namespace athena
 				std::string parse_parameters( const char* input , va_list parameters );
 				// Function responsible of parsing the parameters that were given to the log functions.
 				std::wstring parse_wide_parameters( const wchar_t* input , va_list parameters );
+				// Function responsible of adding the given entry to the log and performing the echo, auto-dump and auto-purge functionalities. Must be called with the lock held.
+				void add_entry( LogEntryA* entry );
 				// Function responsible of adding a new entry of the given type and with the given message to the log.
 				void log_entry( const LogEntryType& type , const std::string& message );
+				// Function responsible of adding a new entry of the given type and with the given message of the given length to the log.
+				void log_entry( const LogEntryType& type , const char* message , const size_t length );
+				// Function responsible of adding a new entry of the given type and with the message formatted from the given parameters to the log.
+				void log_formatted_entry( const LogEntryType& type , const char* format , va_list parameters );
+				// Function returning the ring buffer of the calling thread, or NULL if it could not be allocated.
+				LogRingBuffer* thread_ring_buffer();
+				// Function responsible of waking up the writer thread.
+				void wake_writer();
+				// Function responsible of adding the records of every ring buffer to the log. Returns the amount of records that were added.
+				size_t write_records();
+				// Function responsible of writing the records as they arrive, until the asynchronous mode is disabled.
+				void write_loop();
 
 
 			protected:
@@ -169,6 +259,20 @@ namespace athena
 				ATHENA_DLL void message_separator( const std::string& separator );
 				// Function responsible of setting the timestamp separator.
 				ATHENA_DLL void timestamp_separator( const std::string& separator );
+				/*
+					Function responsible of enabling or disabling the asynchronous mode. Enabling the mode spawns the writer thread,
+					and disabling it adds every pending record to the log before the writer thread exits.
+					The mode must not be changed by more than one thread at a time.
+				*/
+				ATHENA_DLL void asynchronous( const bool value );
+				// Function responsible of blocking until every record that has been written in asynchronous mode before the call has been added to the log.
+				ATHENA_DLL void flush_log();
+				/*
+					Function responsible of releasing the ring buffer of the calling thread, so that it can be reused by another thread once
+					its records have been added to the log. Should be called by threads that have logged in asynchronous mode before they exit.
+					A thread that logs again afterwards is given a ring buffer anew.
+				*/
+				ATHENA_DLL void release_thread_buffer();
 				// Function responsible of logging an error with the given message.
 				ATHENA_DLL void log_error( const std::string& message );
 				// Function responsible of logging an error with converted contents of the given message.
@@ -235,6 +339,10 @@ namespace athena
 				ATHENA_DLL std::string message_separator() const;
 				// Function returning the timestamp separator.
 				ATHENA_DLL std::string timestamp_separator() const;
+				// Function returning whether the asynchronous mode is enabled.
+				ATHENA_DLL bool asynchronous() const;
+				// Function returning the amount of records that have been dropped because the ring buffer of their thread was full. Errors are never dropped.
+				ATHENA_DLL unsigned long long dropped_log_records() const;
 				// Function returning the size of the log.
 				ATHENA_DLL unsigned int log_size() const;
 				// Function returning the entry at the given index. Returns true on success.
@@ -6,6 +6,7 @@
 #endif /* ATHENA_IO_LOGMANAGER_HPP */
 
 #include <ctime>
+#include <cstring>
 #include <sstream>
 #include "stringUtilities.hpp"
 
@@ -37,7 +38,7 @@ namespace athena
 		// Function responsible of logging an error with the contents of the given exception.
 		inline void LogManager::log_error( const std::exception& exception )
 		{
-			log_entry(Error,exception.what());
+			log_entry(Error,exception.what(),strlen(exception.what()));
 		}
 
 		// Function responsible of logging a warning with the given message.
@@ -55,7 +56,7 @@ namespace athena
 		// Function responsible of logging a warning with the contents of the given exception.
 		inline void LogManager::log_warning( const std::exception& exception )
 		{
-			log_entry(Warning,exception.what());
+			log_entry(Warning,exception.what(),strlen(exception.what()));
 		}
 
 		// Function responsible of logging a message with the given message.
@@ -73,7 +74,7 @@ namespace athena
 		// Function responsible of logging a message with the contents of the given exception.
 		inline void LogManager::log_message( const std::exception& exception )
 		{
-			log_entry(Message,exception.what());
+			log_entry(Message,exception.what(),strlen(exception.what()));
 		}
 
 	} /* io */
@@ -0,0 +1,44 @@
+#include "logRingBuffer.hpp"
+#include <new>
+
+
+
+namespace athena
+{
+
+	namespace io
+	{
+
+		// The constructor of the class. The capacity is rounded up to a power of two (2).
+		LogRingBuffer::LogRingBuffer( const size_t capacity ) :
+			m_records(NULL) ,
+			m_capacity(0) ,
+			m_mask(0) ,
+			m_tail(0) ,
+			m_cached_head(0) ,
+			m_head(0)
+		{
+			size_t actual_capacity = 2;
+
+
+			while ( actual_capacity < capacity )
+				actual_capacity <<= 1;
+
+			m_records = new (std::nothrow) LogRecord[actual_capacity];
+
+			if ( m_records != NULL )
+			{
+				m_capacity = actual_capacity;
+				m_mask = actual_capacity - 1;
+			}
+		}
+
+		// The destructor of the class.
+		LogRingBuffer::~LogRingBuffer()
+		{
+			delete[] m_records;
+		}
+
+	} /* io */
+
+} /* athena */
\ No newline at end of file
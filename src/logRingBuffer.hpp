@@ -0,0 +1,119 @@
+#ifndef ATHENA_IO_LOGRINGBUFFER_HPP
+#define ATHENA_IO_LOGRINGBUFFER_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <atomic>
+#include <chrono>
+#include "logEntry.hpp"
+
+
+
+namespace athena
+{
+
+	namespace io
+	{
+
+		/*
+			A struct holding a log entry that has been written by a thread and not yet added to the log.
+			The struct has a fixed size, so that writing a record requires no allocation. Longer messages are truncated.
+		*/
+		struct LogRecord
+		{
+			// The maximum length of the message of a record, including the terminating character.
+			static const unsigned int s_MESSAGE_SIZE = 240;
+
+
+			// The time the record was written.
+			std::chrono::steady_clock::time_point m_time;
+			// The type of the entry.
+			LogEntryType m_type;
+			// The length of the message.
+			unsigned int m_length;
+			// The message of the entry.
+			char m_message[s_MESSAGE_SIZE];
+		};
+
+
+		/*
+			A bounded lock-free single-producer single-consumer ring buffer of log records. Every thread that logs
+			while the log manager is asynchronous writes to its own ring buffer, and the writer thread of the log manager
+			consumes them all. A record is written in place, by reserving the next slot, filling it and committing it,
+			so the producer never copies a record and never blocks: if the ring buffer is full, the reservation fails.
+			The producer keeps a private copy of the position of the consumer, so it only reads the counter of the consumer
+			when the ring buffer appears to be at least half full.
+		*/
+		class LogRingBuffer
+		{
+			private:
+
+				// The assumed size of a cache line, used to keep the producer and consumer counters apart.
+				static const size_t s_CACHE_LINE_SIZE = 64;
+
+
+				// The slots of the ring buffer.
+				LogRecord* m_records;
+				// The capacity of the ring buffer. Always a power of two (2).
+				size_t m_capacity;
+				// The mask that is used to map a position to a slot.
+				size_t m_mask;
+				// Padding that separates the producer members from the read-mostly members.
+				char m_tail_padding[s_CACHE_LINE_SIZE];
+				// The position that the next record will be written to.
+				std::atomic<size_t> m_tail;
+				// The position of the consumer, as last read by the producer.
+				size_t m_cached_head;
+				// Padding that separates the producer members from the consumer counter.
+				char m_head_padding[s_CACHE_LINE_SIZE];
+				// The position that the next record will be read from.
+				std::atomic<size_t> m_head;
+				// Padding that separates the consumer counter from any following data.
+				char m_end_padding[s_CACHE_LINE_SIZE];
+
+
+				// The copy constructor is not available.
+				LogRingBuffer( const LogRingBuffer& );
+				// The assignment operator is not available.
+				LogRingBuffer& operator=( const LogRingBuffer& );
+
+
+			public:
+
+				// The constructor of the class. The capacity is rounded up to a power of two (2).
+				ATHENA_DLL explicit LogRingBuffer( const size_t capacity );
+				// The destructor of the class.
+				ATHENA_DLL ~LogRingBuffer();
+
+
+				// A function returning the slot the next record should be written to, or NULL if the ring buffer is full. Must only be called by the producer.
+				ATHENA_DLL LogRecord* reserve();
+				/*
+					A function responsible of publishing the record that was written to the reserved slot. Must only be called by the producer.
+					Returns true if the ring buffer has just become half full, which is when the consumer should be woken up.
+				*/
+				ATHENA_DLL bool commit();
+				// A function returning the record at the given offset from the oldest record. Must only be called by the consumer.
+				ATHENA_DLL const LogRecord& record( const size_t offset ) const;
+				// A function responsible of releasing the given amount of the oldest records. Must only be called by the consumer.
+				ATHENA_DLL void pop( const size_t count );
+
+
+				// A function returning whether the ring buffer could be allocated.
+				ATHENA_DLL bool valid() const;
+				// A function returning the amount of records that can be read. Must only be called by the consumer.
+				ATHENA_DLL size_t size() const;
+				// A function returning the capacity of the ring buffer.
+				ATHENA_DLL size_t capacity() const;
+		};
+
+	} /* io */
+
+} /* athena */
+
+
+#include "logRingBuffer.inl"
+
+
+
+#endif /* ATHENA_IO_LOGRINGBUFFER_HPP */
\ No newline at end of file
@@ -0,0 +1,98 @@
+#ifndef ATHENA_IO_LOGRINGBUFFER_INL
+#define ATHENA_IO_LOGRINGBUFFER_INL
+
+#ifndef ATHENA_IO_LOGRINGBUFFER_HPP
+	#error "logRingBuffer.hpp must be included before logRingBuffer.inl"
+#endif /* ATHENA_IO_LOGRINGBUFFER_HPP */
+
+
+
+namespace athena
+{
+
+	namespace io
+	{
+
+		// A function returning the slot the next record should be written to, or NULL if the ring buffer is full. Must only be called by the producer.
+		inline LogRecord* LogRingBuffer::reserve()
+		{
+			size_t tail = m_tail.load(std::memory_order_relaxed);
+			LogRecord* return_value = NULL;
+
+
+			// The position of the consumer is only read again when the ring buffer appears to be full.
+			if ( tail - m_cached_head >= m_capacity )
+				m_cached_head = m_head.load(std::memory_order_acquire);
+
+			if ( tail - m_cached_head < m_capacity )
+				return_value = &m_records[tail & m_mask];
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of publishing the record that was written to the reserved slot. Must only be called by the producer.
+			Returns true if the ring buffer has just become half full, which is when the consumer should be woken up.
+		*/
+		inline bool LogRingBuffer::commit()
+		{
+			size_t tail = m_tail.load(std::memory_order_relaxed) + 1;
+			bool return_value = false;
+
+
+			m_tail.store(tail,std::memory_order_release);
+
+			/*
+				The private copy only overestimates how full the ring buffer is, so the position of the consumer is read again
+				once the ring buffer appears to be half full. Since a commit adds a single record, the fresh count equals the half mark
+				whenever the ring buffer has just crossed it.
+			*/
+			if ( tail - m_cached_head >= ( m_capacity >> 1 ) )
+			{
+				m_cached_head = m_head.load(std::memory_order_acquire);
+				return_value = ( tail - m_cached_head == ( m_capacity >> 1 ) );
+			}
+
+
+			return return_value;
+		}
+
+		// A function returning the record at the given offset from the oldest record. Must only be called by the consumer.
+		inline const LogRecord& LogRingBuffer::record( const size_t offset ) const
+		{
+			return m_records[( m_head.load(std::memory_order_relaxed) + offset ) & m_mask];
+		}
+
+		// A function responsible of releasing the given amount of the oldest records. Must only be called by the consumer.
+		inline void LogRingBuffer::pop( const size_t count )
+		{
+			m_head.store(m_head.load(std::memory_order_relaxed) + count,std::memory_order_release);
+		}
+
+
+		// A function returning whether the ring buffer could be allocated.
+		inline bool LogRingBuffer::valid() const
+		{
+			return ( m_records != NULL );
+		}
+
+		// A function returning the amount of records that can be read. Must only be called by the consumer.
+		inline size_t LogRingBuffer::size() const
+		{
+			return m_tail.load(std::memory_order_acquire) - m_head.load(std::memory_order_relaxed);
+		}
+
+		// A function returning the capacity of the ring buffer.
+		inline size_t LogRingBuffer::capacity() const
+		{
+			return m_capacity;
+		}
+
+	} /* io */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_IO_LOGRINGBUFFER_INL */
\ No newline at end of file
@@ -4,6 +4,7 @@
 #include <cmath>
 #include <limits>
 #include "athena.hpp"
+#include "eventManager.hpp"
 
 #ifdef _WIN32
 	#pragma warning(disable:4505)
@@ -84,71 +85,14 @@ namespace athena
 		{
 			if ( static_cast<unsigned int>(abs(x) + abs(y)) >= s_deadzone )
 			{
-				int* new_x = new (std::nothrow) int(x);
+				// The coordinates are stored inline, so the events need no allocation and no cleanup.
+				core::Event events[2] = { MousePositionEvent(x,y).event() , MousePositionDifferenceEvent(x-s_position[0],y-s_position[1]).event() };
 
 
-				if ( new_x != NULL )
-				{
-					int* new_y = new (std::nothrow) int(y);
-
-					if ( new_y != NULL )
-					{
-						int* diff_x = new (std::nothrow) int(x - s_position[0]);
-					
-
-						if ( diff_x != NULL )
-						{
-							int* diff_y = new (std::nothrow) int(y - s_position[1]);
-
-
-							if ( diff_y != NULL )
-							{
-								core::Event event(EVENT_INPUT_MOUSE_POSITION);
-
-
-								s_position[0] = x;
-								s_position[1] = y;
-								event.cleanup_function(cleanup);
-								event.parameter(0,core::ParameterType::Integer,new_x);
-								event.parameter(1,core::ParameterType::Integer,new_y);
-								athena::trigger_event(event);
-
-								event.code(EVENT_INPUT_MOUSE_POSITION_DIFFERENCE);
-								event.parameter(0,core::ParameterType::Integer,diff_x);
-								event.parameter(1,core::ParameterType::Integer,diff_y);
-								athena::trigger_event(event);
-							}
-							else
-							{
-								delete diff_x;
-								delete new_y;
-								delete new_x;
-							}
-						}
-						else
-						{
-							delete new_y;
-							delete new_x;
-						}
-					}
-					else
-						delete new_x;
-				}
-			}
-		}
-
-		// Function responsible of cleaning up any allocated memory for the events.
-		void Mouse::cleanup( const core::Event& event )
-		{
-			for ( unsigned int i = 0;  i < event.parameter_count();  ++i )
-			{
-				const core::Parameter* parameter(event.parameter(i));
-
-
-				if ( parameter != NULL )
-				{
-					delete static_cast<int*>(parameter->data());
-				}
+				s_position[0] = x;
+				s_position[1] = y;
+				// Trigger both events with a single call.
+				athena::trigger_events(events,events+2);
 			}
 		}
 
@@ -169,6 +113,19 @@ namespace athena
 		// Function responsible of performing any setup operations.
 		void Mouse::startup()
 		{
+			core::EventManager* event_manager = core::EventManager::get();
+
+
+			/*
+				Motion is reported far more often than the listeners can use it. Queued position events only
+				need to carry the latest position, while queued difference events have to add up the movement.
+			*/
+			if ( event_manager != NULL )
+			{
+				event_manager->event_coalescing_policy(EVENT_INPUT_MOUSE_POSITION,core::KeepLatestCoalescing);
+				event_manager->event_coalescing_policy(EVENT_INPUT_MOUSE_POSITION_DIFFERENCE,core::SumDeltasCoalescing);
+			}
+
 			glutSetKeyRepeat(GLUT_KEY_REPEAT_OFF);
 			glutMouseFunc(mouse_function);
 			//glutMouseWheelFunc(mousewheel_function);
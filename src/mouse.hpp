@@ -36,8 +36,6 @@ namespace athena
 				static void mouse_function( int button , int state , int x , int y );
 				// Function responsible of handling the mouse position
 				static void mouse_movement_function( int x , int y );
-				// Function responsible of cleaning up any allocated memory for the events.
-				static void cleanup( const core::Event& event );
 
 
 			public:
@@ -0,0 +1,233 @@
+#include "objectPool.hpp"
+#include <new>
+
+
+
+namespace athena
+{
+
+	namespace utility
+	{
+
+		// The amount of pools that have been created, which is used to assign each pool its thread cache.
+		std::atomic<unsigned int> ObjectPool::s_pool_count(0);
+		// The caches of the current thread, one for each pool.
+		ATHENA_THREAD_LOCAL ObjectPoolCache ObjectPool::s_caches[ObjectPool::s_MAX_CACHED_POOLS];
+
+
+		// A function responsible of allocating a new slab and adding its blocks to the shared free list. Must be called with the lock held.
+		bool ObjectPool::grow()
+		{
+			char* slab = new (std::nothrow) char[m_block_size*s_SLAB_SIZE];
+			bool return_value = false;
+
+
+			if ( slab != NULL )
+			{
+				m_slabs.push_back(slab);
+
+				// Link the blocks of the slab in reverse, so that they are handed out in address order.
+				for ( size_t i = s_SLAB_SIZE;  i > 0;  --i )
+					put(slab + ( i - 1 ) * m_block_size);
+
+				return_value = true;
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of taking a block out of the shared free list. Must be called with the lock held.
+		void* ObjectPool::take()
+		{
+			void* return_value = NULL;
+
+
+			if ( m_free_list != NULL  ||  grow() )
+			{
+				size_t high_water_mark = m_high_water_mark.load(std::memory_order_relaxed);
+
+
+				return_value = m_free_list;
+				m_free_list = next(return_value);
+				++m_outstanding;
+
+				if ( m_outstanding > high_water_mark )
+					m_high_water_mark.store(m_outstanding,std::memory_order_relaxed);
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of putting a block back to the shared free list. Must be called with the lock held.
+		void ObjectPool::put( void* block )
+		{
+			next(block) = m_free_list;
+			m_free_list = block;
+		}
+
+		// A function responsible of publishing the hits of the given cache. Must be called with the lock held.
+		void ObjectPool::publish( ObjectPoolCache& cache )
+		{
+			if ( cache.m_hits > 0 )
+			{
+				m_hits.fetch_add(cache.m_hits,std::memory_order_relaxed);
+				cache.m_hits = 0;
+			}
+		}
+
+		// A function responsible of moving a batch of blocks from the shared free list to the given cache.
+		void ObjectPool::refill( ObjectPoolCache& cache )
+		{
+			m_lock.lock();
+			publish(cache);
+
+			for ( size_t i = 0;  i < s_BATCH_SIZE;  ++i )
+			{
+				void* block = take();
+
+
+				if ( block == NULL )
+					break;
+
+				next(block) = cache.m_head;
+				cache.m_head = block;
+				++cache.m_count;
+			}
+
+			m_lock.unlock();
+		}
+
+		// A function responsible of returning the given amount of blocks from the given cache to the shared free list.
+		void ObjectPool::flush( ObjectPoolCache& cache , const size_t count )
+		{
+			m_lock.lock();
+			publish(cache);
+
+			for ( size_t i = 0;  i < count  &&  cache.m_head != NULL;  ++i )
+			{
+				void* block = cache.m_head;
+
+
+				cache.m_head = next(block);
+				--cache.m_count;
+				put(block);
+				--m_outstanding;
+			}
+
+			m_lock.unlock();
+		}
+
+
+		// The constructor of the class.
+		ObjectPool::ObjectPool( const size_t block_size ) :
+			m_block_size(( ( block_size < sizeof(void*)  ?  sizeof(void*) : block_size ) + s_ALIGNMENT - 1 ) / s_ALIGNMENT * s_ALIGNMENT) ,
+			m_index(s_pool_count.fetch_add(1,std::memory_order_relaxed)) ,
+			m_free_list(NULL) ,
+			m_slabs(0) ,
+			m_outstanding(0) ,
+			m_lock() ,
+			m_hits(0) ,
+			m_misses(0) ,
+			m_high_water_mark(0)
+		{
+		}
+
+		// The destructor of the class. Every slab is deallocated, so no block may be in use.
+		ObjectPool::~ObjectPool()
+		{
+			for (
+					std::vector<char*>::iterator slab_iterator = m_slabs.begin();
+					slab_iterator != m_slabs.end();
+					++slab_iterator
+				)
+			{
+				delete[] (*slab_iterator);
+			}
+
+			m_slabs.clear();
+			m_free_list = NULL;
+		}
+
+
+		// A function responsible of allocating a block of the given size. Returns NULL if the allocation fails.
+		void* ObjectPool::allocate( const size_t size )
+		{
+			void* return_value = NULL;
+
+
+			if ( size > m_block_size )
+				return_value = ::operator new(size,std::nothrow);
+			else
+			{
+				ObjectPoolCache* cache = thread_cache();
+
+
+				if ( cache != NULL )
+				{
+					// If the cache of the thread is empty, take a batch of blocks from the shared free list.
+					if ( cache->m_head == NULL )
+					{
+						m_misses.fetch_add(1,std::memory_order_relaxed);
+						refill((*cache));
+					}
+					else
+						++cache->m_hits;
+
+					if ( cache->m_head != NULL )
+					{
+						return_value = cache->m_head;
+						cache->m_head = next(return_value);
+						--cache->m_count;
+					}
+				}
+				else
+				{
+					m_misses.fetch_add(1,std::memory_order_relaxed);
+					m_lock.lock();
+					return_value = take();
+					m_lock.unlock();
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of deallocating a block that was allocated with the given size.
+		void ObjectPool::deallocate( void* block , const size_t size )
+		{
+			if ( block != NULL )
+			{
+				if ( size > m_block_size )
+					::operator delete(block);
+				else
+				{
+					ObjectPoolCache* cache = thread_cache();
+
+
+					if ( cache != NULL )
+					{
+						next(block) = cache->m_head;
+						cache->m_head = block;
+						++cache->m_count;
+
+						// If the cache of the thread has grown too large, return a batch of blocks to the shared free list.
+						if ( cache->m_count >= 2 * s_BATCH_SIZE )
+							flush((*cache),s_BATCH_SIZE);
+					}
+					else
+					{
+						m_lock.lock();
+						put(block);
+						--m_outstanding;
+						m_lock.unlock();
+					}
+				}
+			}
+		}
+
+	} /* utility */
+
+} /* athena */
\ No newline at end of file
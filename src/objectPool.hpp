@@ -0,0 +1,140 @@
+#ifndef ATHENA_UTILITY_OBJECTPOOL_HPP
+#define ATHENA_UTILITY_OBJECTPOOL_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <vector>
+
+
+
+namespace athena
+{
+
+	namespace utility
+	{
+
+		/*
+			A struct holding the blocks that a thread has cached from a pool, along with
+			the amount of allocations that have been served from the cache and not yet been published.
+			The struct is plain data, so that it can be thread local.
+		*/
+		struct ObjectPoolCache
+		{
+			void* m_head;
+			size_t m_count;
+			unsigned long long m_hits;
+		};
+
+
+		/*
+			A class representing a pool of fixed-size blocks that are carved out of larger slabs.
+			Every thread allocates from and frees to its own cache of blocks without any locking.
+			A thread whose cache is empty takes a batch of blocks from the shared free list of the pool,
+			and a thread whose cache has grown too large returns a batch to it, so an object that is
+			allocated on one thread and freed on another returns to its pool in batches instead of going
+			through the heap on every allocation.
+			Blocks that are cached by a thread when it exits are only reclaimed when the pool is destroyed.
+			Requests larger than the block size are served by the heap.
+		*/
+		class ObjectPool
+		{
+			private:
+
+				// The maximum amount of pools that have a thread cache. Any further pools only use the shared free list.
+				static const unsigned int s_MAX_CACHED_POOLS = 16;
+				// The amount of blocks that are moved between a thread cache and the shared free list at once.
+				static const size_t s_BATCH_SIZE = 32;
+				// The amount of blocks in each slab.
+				static const size_t s_SLAB_SIZE = 256;
+				// The alignment of the blocks.
+				static const size_t s_ALIGNMENT = 16;
+
+
+				// The amount of pools that have been created, which is used to assign each pool its thread cache.
+				static std::atomic<unsigned int> s_pool_count;
+				// The caches of the current thread, one for each pool.
+				static ATHENA_THREAD_LOCAL ObjectPoolCache s_caches[s_MAX_CACHED_POOLS];
+
+
+				// The size of the blocks of the pool.
+				size_t m_block_size;
+				// The index of the thread cache of the pool, or s_MAX_CACHED_POOLS if the pool has no thread cache.
+				unsigned int m_index;
+				// The shared list of free blocks.
+				void* m_free_list;
+				// The slabs that the blocks are carved out of.
+				std::vector<char*> m_slabs;
+				// The amount of blocks that have been taken out of the shared free list and have not been returned.
+				size_t m_outstanding;
+				// A lock that is used to handle concurrency issues regarding the shared free list.
+				std::mutex m_lock;
+				// The amount of allocations that were served from a thread cache.
+				std::atomic<unsigned long long> m_hits;
+				// The amount of allocations that had to take blocks from the shared free list.
+				std::atomic<unsigned long long> m_misses;
+				// The largest amount of blocks that have been out of the shared free list at once.
+				std::atomic<size_t> m_high_water_mark;
+
+
+				// The copy constructor is not available.
+				ObjectPool( const ObjectPool& );
+				// The assignment operator is not available.
+				ObjectPool& operator=( const ObjectPool& );
+
+
+				// A function returning the block that follows the given block in a free list.
+				static void*& next( void* block );
+
+
+				// A function responsible of allocating a new slab and adding its blocks to the shared free list. Must be called with the lock held.
+				bool grow();
+				// A function responsible of taking a block out of the shared free list. Must be called with the lock held.
+				void* take();
+				// A function responsible of putting a block back to the shared free list. Must be called with the lock held.
+				void put( void* block );
+				// A function responsible of publishing the hits of the given cache. Must be called with the lock held.
+				void publish( ObjectPoolCache& cache );
+				// A function responsible of moving a batch of blocks from the shared free list to the given cache.
+				void refill( ObjectPoolCache& cache );
+				// A function responsible of returning the given amount of blocks from the given cache to the shared free list.
+				void flush( ObjectPoolCache& cache , const size_t count );
+				// A function returning the cache of the current thread, or NULL if the pool has no thread cache.
+				ObjectPoolCache* thread_cache() const;
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL explicit ObjectPool( const size_t block_size );
+				// The destructor of the class. Every slab is deallocated, so no block may be in use.
+				ATHENA_DLL ~ObjectPool();
+
+
+				// A function responsible of allocating a block of the given size. Returns NULL if the allocation fails.
+				ATHENA_DLL void* allocate( const size_t size );
+				// A function responsible of deallocating a block that was allocated with the given size.
+				ATHENA_DLL void deallocate( void* block , const size_t size );
+
+
+				// A function returning the size of the blocks of the pool.
+				ATHENA_DLL size_t block_size() const;
+				// A function returning the amount of allocations that were served from a thread cache. The hits of each thread are published in batches.
+				ATHENA_DLL unsigned long long hits() const;
+				// A function returning the amount of allocations that had to take blocks from the shared free list.
+				ATHENA_DLL unsigned long long misses() const;
+				// A function returning the largest amount of blocks that have been out of the shared free list at once.
+				ATHENA_DLL size_t high_water_mark() const;
+		};
+
+	} /* utility */
+
+} /* athena */
+
+
+#include "objectPool.inl"
+
+
+
+#endif /* ATHENA_UTILITY_OBJECTPOOL_HPP */
\ No newline at end of file
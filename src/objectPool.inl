@@ -0,0 +1,59 @@
+#ifndef ATHENA_UTILITY_OBJECTPOOL_INL
+#define ATHENA_UTILITY_OBJECTPOOL_INL
+
+#ifndef ATHENA_UTILITY_OBJECTPOOL_HPP
+	#error "objectPool.hpp must be included before objectPool.inl"
+#endif /* ATHENA_UTILITY_OBJECTPOOL_HPP */
+
+
+
+namespace athena
+{
+
+	namespace utility
+	{
+
+		// A function returning the block that follows the given block in a free list.
+		inline void*& ObjectPool::next( void* block )
+		{
+			return *(static_cast<void**>(block));
+		}
+
+		// A function returning the cache of the current thread, or NULL if the pool has no thread cache.
+		inline ObjectPoolCache* ObjectPool::thread_cache() const
+		{
+			return ( m_index < s_MAX_CACHED_POOLS  ?  &s_caches[m_index] : NULL );
+		}
+
+
+		// A function returning the size of the blocks of the pool.
+		inline size_t ObjectPool::block_size() const
+		{
+			return m_block_size;
+		}
+
+		// A function returning the amount of allocations that were served from a thread cache. The hits of each thread are published in batches.
+		inline unsigned long long ObjectPool::hits() const
+		{
+			return m_hits.load(std::memory_order_relaxed);
+		}
+
+		// A function returning the amount of allocations that had to take blocks from the shared free list.
+		inline unsigned long long ObjectPool::misses() const
+		{
+			return m_misses.load(std::memory_order_relaxed);
+		}
+
+		// A function returning the largest amount of blocks that have been out of the shared free list at once.
+		inline size_t ObjectPool::high_water_mark() const
+		{
+			return m_high_water_mark.load(std::memory_order_relaxed);
+		}
+
+	} /* utility */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_UTILITY_OBJECTPOOL_INL */
\ No newline at end of file
@@ -0,0 +1,157 @@
+#include "parallelAlgorithms.hpp"
+#include "threadPool.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The function that is used by the thread pool tasks in order to take part in the work.
+		int ParallelRange::participate_function( void* parameter )
+		{
+			ParallelRange* range = static_cast<ParallelRange*>(parameter);
+
+
+			if ( range != NULL )
+			{
+				range->participate();
+				range->release();
+			}
+
+
+			return 0;
+		}
+
+
+		// A function responsible of blocking until every index of the range has been processed.
+		void ParallelRange::wait()
+		{
+			m_lock.lock();
+
+			while ( m_completed.load(std::memory_order_acquire) < m_size )
+				m_condition_variable.wait(m_lock);
+
+			m_lock.unlock();
+		}
+
+
+		// The constructor of the class.
+		ParallelRange::ParallelRange( const size_t size , const size_t grain ) :
+			m_size(size) ,
+			m_grain(( grain > 0  ?  grain : 1 )) ,
+			m_participants(1) ,
+			m_next(0) ,
+			m_completed(0) ,
+			m_references(0) ,
+			m_lock() ,
+			m_condition_variable()
+		{
+		}
+
+		// The destructor of the class.
+		ParallelRange::~ParallelRange()
+		{
+		}
+
+
+		/*
+			A function responsible of claiming the next chunk of the range. Returns false if every index has been claimed.
+			The data of the calling thread may only be accessed after a successful claim, since the calling thread
+			only returns once every claimed index has been reported as processed.
+		*/
+		bool ParallelRange::claim( size_t& first , size_t& last )
+		{
+			size_t next = m_next.load(std::memory_order_relaxed);
+			bool return_value = false;
+
+
+			if ( next < m_size )
+			{
+				// Claim a share of the remaining indices for each participant, but no less than the grain size.
+				size_t chunk = ( m_size - next ) / ( m_participants * 2 );
+
+
+				if ( chunk < m_grain )
+					chunk = m_grain;
+
+				first = m_next.fetch_add(chunk,std::memory_order_relaxed);
+
+				if ( first < m_size )
+				{
+					last = ( m_size - first > chunk  ?  first + chunk : m_size );
+					return_value = true;
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of reporting the given amount of claimed indices as processed.
+		void ParallelRange::complete( const size_t count )
+		{
+			if ( m_completed.fetch_add(count,std::memory_order_acq_rel) + count == m_size )
+			{
+				m_lock.lock();
+				m_condition_variable.notify_all();
+				m_lock.unlock();
+			}
+		}
+
+
+		// A function responsible of acquiring a reference to the range.
+		void ParallelRange::acquire()
+		{
+			m_references.fetch_add(1,std::memory_order_relaxed);
+		}
+
+		// A function responsible of releasing a reference to the range. The range is deallocated when the last reference is released.
+		void ParallelRange::release()
+		{
+			if ( m_references.fetch_sub(1,std::memory_order_acq_rel) == 1 )
+				delete this;
+		}
+
+		/*
+			A function responsible of processing the range. One task is queued for each thread of the pool,
+			the calling thread takes part in the work and the function returns once every index has been processed.
+		*/
+		void ParallelRange::process()
+		{
+			ThreadPool* thread_pool = ThreadPool::get();
+
+
+			if ( thread_pool != NULL  &&  m_size > m_grain )
+			{
+				size_t chunks = ( m_size - 1 ) / m_grain + 1;
+				size_t helpers = thread_pool->thread_count();
+
+
+				// There is no point in queuing more tasks than there are chunks for the other participants.
+				if ( helpers > chunks - 1 )
+					helpers = chunks - 1;
+
+				m_participants = helpers + 1;
+
+				for ( size_t i = 0;  i < helpers;  ++i )
+				{
+					acquire();
+
+					if ( !thread_pool->add_task(participate_function,static_cast<void*>(this),NULL,NULL) )
+					{
+						release();
+						break;
+					}
+				}
+			}
+
+			participate();
+			wait();
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
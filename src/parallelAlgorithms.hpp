@@ -0,0 +1,221 @@
+#ifndef ATHENA_CORE_PARALLELALGORITHMS_HPP
+#define ATHENA_CORE_PARALLELALGORITHMS_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <new>
+#include <functional>
+#include <type_traits>
+#include <utility>
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A class representing a range of indices that is processed in parallel by the calling thread and the threads of the pool.
+			Every participant repeatedly claims a chunk of the indices that have not been claimed yet. The chunks shrink as the
+			range is consumed, starting from a share of the remaining indices for each participant and ending at the grain size,
+			so that large ranges are claimed with few atomic operations while the last chunks still balance the load.
+			Since the calling thread takes part in the work, it processes the whole range by itself if no thread of the pool is free.
+			The range is reference counted, since a task of the pool may start after the range has been processed.
+		*/
+		class ParallelRange
+		{
+			private:
+
+				// The amount of indices of the range.
+				size_t m_size;
+				// The minimum amount of indices that are claimed at once.
+				size_t m_grain;
+				// The amount of threads that are expected to take part in the work.
+				size_t m_participants;
+				// The first index that has not been claimed yet.
+				std::atomic<size_t> m_next;
+				// The amount of indices that have been processed.
+				std::atomic<size_t> m_completed;
+				// The amount of references to the range.
+				std::atomic<unsigned int> m_references;
+				// A lock that is used to handle concurrency issues.
+				std::mutex m_lock;
+				// The condition variable that the calling thread blocks on until the range is processed.
+				std::condition_variable_any m_condition_variable;
+
+
+				// The copy constructor is not available.
+				ParallelRange( const ParallelRange& );
+				// The assignment operator is not available.
+				ParallelRange& operator=( const ParallelRange& );
+
+
+				// The function that is used by the thread pool tasks in order to take part in the work.
+				static int participate_function( void* parameter );
+
+
+				// A function responsible of blocking until every index of the range has been processed.
+				void wait();
+
+
+			protected:
+
+				// The constructor of the class.
+				ATHENA_DLL ParallelRange( const size_t size , const size_t grain );
+
+
+				/*
+					A function responsible of claiming the next chunk of the range. Returns false if every index has been claimed.
+					The data of the calling thread may only be accessed after a successful claim, since the calling thread
+					only returns once every claimed index has been reported as processed.
+				*/
+				ATHENA_DLL bool claim( size_t& first , size_t& last );
+				// A function responsible of reporting the given amount of claimed indices as processed.
+				ATHENA_DLL void complete( const size_t count );
+
+
+				// A function responsible of claiming and processing chunks of the range until every index has been claimed.
+				virtual void participate() = 0;
+
+
+			public:
+
+				// The destructor of the class.
+				ATHENA_DLL virtual ~ParallelRange();
+
+
+				// A function responsible of acquiring a reference to the range.
+				ATHENA_DLL void acquire();
+				// A function responsible of releasing a reference to the range. The range is deallocated when the last reference is released.
+				ATHENA_DLL void release();
+				/*
+					A function responsible of processing the range. One task is queued for each thread of the pool,
+					the calling thread takes part in the work and the function returns once every index has been processed.
+				*/
+				ATHENA_DLL void process();
+		};
+
+
+		// A class representing a range that calls a function for every index.
+		template <typename Index , typename Function>
+		class ParallelForRange : public ParallelRange
+		{
+			private:
+
+				// The first index of the range.
+				Index m_begin;
+				// The function that is called for every index.
+				const Function* m_function;
+
+
+			protected:
+
+				// A function responsible of claiming and processing chunks of the range until every index has been claimed.
+				void participate();
+
+
+			public:
+
+				// The constructor of the class.
+				ParallelForRange( const Index begin , const size_t size , const size_t grain , const Function& function );
+		};
+
+
+		// A class representing a range that reduces every index to a single value.
+		template <typename Index , typename Value , typename Reduction , typename Combination>
+		class ParallelReduceRange : public ParallelRange
+		{
+			private:
+
+				// The first index of the range.
+				Index m_begin;
+				// The value every participant starts reducing from.
+				const Value* m_identity;
+				// The value the partial values of the participants are combined into.
+				Value* m_result;
+				// The function that reduces an index into a partial value.
+				const Reduction* m_reduction;
+				// The function that combines a partial value into the result.
+				const Combination* m_combination;
+				// A lock that is used to handle concurrency issues while combining the partial values.
+				std::mutex m_result_lock;
+
+
+			protected:
+
+				// A function responsible of claiming and reducing chunks of the range until every index has been claimed, combining the partial value into the result.
+				void participate();
+
+
+			public:
+
+				// The constructor of the class.
+				ParallelReduceRange(
+										const Index begin ,
+										const size_t size ,
+										const size_t grain ,
+										const Value& identity ,
+										Value& result ,
+										const Reduction& reduction ,
+										const Combination& combination
+									);
+		};
+
+
+		// A type definition that is used to define the function that calls one of the functions given to parallel_invoke.
+		typedef void (*ParallelInvokeFunction)( const void* function );
+
+
+		// The function that calls one of the functions given to parallel_invoke, through the wrapper that refers to it.
+		template <typename Wrapper>
+		void parallel_invoke_function( const void* function );
+		/*
+			A function responsible of calling the given wrappers in parallel. The wrappers refer to the functions given to parallel_invoke,
+			so that even plain functions are passed as objects.
+		*/
+		template <typename... Wrappers>
+		void parallel_invoke_wrappers( const Wrappers&... wrappers );
+
+
+		/*
+			A function responsible of calling the given function for every index in [begin,end), in parallel.
+			The index may be an integer or a random access iterator. The indices are claimed in chunks of at least
+			the given grain size, so the grain should be large enough to amortise the claiming of a chunk.
+			The calling thread takes part in the work and the function returns once every index has been processed.
+		*/
+		template <typename Index , typename Function>
+		void parallel_for( const Index begin , const Index end , const size_t grain , const Function& function );
+		/*
+			A function responsible of reducing every index in [begin,end) to a single value, in parallel, and returning the value.
+			Every participant starts from a copy of the identity and calls reduction(value,index) for every index it claims.
+			The partial values are then combined into the result, which also starts from the identity, by calling combination(result,value).
+			Since the partial values are combined in the order the participants finish, the combination should be associative and commutative.
+		*/
+		template <typename Index , typename Value , typename Reduction , typename Combination>
+		Value parallel_reduce(
+								const Index begin ,
+								const Index end ,
+								const size_t grain ,
+								const Value& identity ,
+								const Reduction& reduction ,
+								const Combination& combination
+							);
+		// A function responsible of calling the given functions in parallel. The function returns once every function has returned.
+		template <typename Function , typename... Functions>
+		void parallel_invoke( Function&& function , Functions&&... functions );
+
+	} /* core */
+
+} /* athena */
+
+
+#include "parallelAlgorithms.inl"
+
+
+
+#endif /* ATHENA_CORE_PARALLELALGORITHMS_HPP */
\ No newline at end of file
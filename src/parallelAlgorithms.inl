@@ -0,0 +1,225 @@
+#ifndef ATHENA_CORE_PARALLELALGORITHMS_INL
+#define ATHENA_CORE_PARALLELALGORITHMS_INL
+
+#ifndef ATHENA_CORE_PARALLELALGORITHMS_HPP
+	#error "parallelAlgorithms.hpp must be included before parallelAlgorithms.inl"
+#endif /* ATHENA_CORE_PARALLELALGORITHMS_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the class.
+		template <typename Index , typename Function>
+		ParallelForRange<Index,Function>::ParallelForRange( const Index begin , const size_t size , const size_t grain , const Function& function ) :
+			ParallelRange(size,grain) ,
+			m_begin(begin) ,
+			m_function(&function)
+		{
+		}
+
+
+		// A function responsible of claiming and processing chunks of the range until every index has been claimed.
+		template <typename Index , typename Function>
+		void ParallelForRange<Index,Function>::participate()
+		{
+			size_t first = 0;
+			size_t last = 0;
+
+
+			while ( claim(first,last) )
+			{
+				Index index = static_cast<Index>(m_begin + first);
+
+
+				for ( size_t i = first;  i < last;  ++i , ++index )
+					(*m_function)(index);
+
+				complete(last - first);
+			}
+		}
+
+
+		// The constructor of the class.
+		template <typename Index , typename Value , typename Reduction , typename Combination>
+		ParallelReduceRange<Index,Value,Reduction,Combination>::ParallelReduceRange(
+																						const Index begin ,
+																						const size_t size ,
+																						const size_t grain ,
+																						const Value& identity ,
+																						Value& result ,
+																						const Reduction& reduction ,
+																						const Combination& combination
+																					) :
+			ParallelRange(size,grain) ,
+			m_begin(begin) ,
+			m_identity(&identity) ,
+			m_result(&result) ,
+			m_reduction(&reduction) ,
+			m_combination(&combination) ,
+			m_result_lock()
+		{
+		}
+
+
+		// A function responsible of claiming and reducing chunks of the range until every index has been claimed, combining the partial value into the result.
+		template <typename Index , typename Value , typename Reduction , typename Combination>
+		void ParallelReduceRange<Index,Value,Reduction,Combination>::participate()
+		{
+			size_t first = 0;
+			size_t last = 0;
+
+
+			if ( claim(first,last) )
+			{
+				Value value(*m_identity);
+				size_t processed = 0;
+
+
+				do
+				{
+					Index index = static_cast<Index>(m_begin + first);
+
+
+					for ( size_t i = first;  i < last;  ++i , ++index )
+						(*m_reduction)(value,index);
+
+					processed += last - first;
+				}
+				while ( claim(first,last) );
+
+				// The claimed indices are only reported once the partial value has been combined, so that the result is complete when the calling thread returns.
+				m_result_lock.lock();
+				(*m_combination)(*m_result,static_cast<const Value&>(value));
+				m_result_lock.unlock();
+
+				complete(processed);
+			}
+		}
+
+
+		// The function that calls one of the functions given to parallel_invoke, through the wrapper that refers to it.
+		template <typename Wrapper>
+		void parallel_invoke_function( const void* function )
+		{
+			(*static_cast<const Wrapper*>(function))();
+		}
+
+		/*
+			A function responsible of calling the given wrappers in parallel. The wrappers refer to the functions given to parallel_invoke,
+			so that even plain functions are passed as objects.
+		*/
+		template <typename... Wrappers>
+		void parallel_invoke_wrappers( const Wrappers&... wrappers )
+		{
+			const void* callables[] = { static_cast<const void*>(&wrappers)... };
+			ParallelInvokeFunction invokers[] = { &parallel_invoke_function<Wrappers>... };
+
+
+			parallel_for(
+							static_cast<size_t>(0) ,
+							sizeof(callables) / sizeof(callables[0]) ,
+							1 ,
+							[&callables,&invokers]( const size_t index ) { (*invokers[index])(callables[index]); }
+						);
+		}
+
+
+		/*
+			A function responsible of calling the given function for every index in [begin,end), in parallel.
+			The index may be an integer or a random access iterator. The indices are claimed in chunks of at least
+			the given grain size, so the grain should be large enough to amortise the claiming of a chunk.
+			The calling thread takes part in the work and the function returns once every index has been processed.
+		*/
+		template <typename Index , typename Function>
+		void parallel_for( const Index begin , const Index end , const size_t grain , const Function& function )
+		{
+			if ( begin < end )
+			{
+				ParallelForRange<Index,Function>* range = new (std::nothrow) ParallelForRange<Index,Function>(begin,static_cast<size_t>(end - begin),grain,function);
+
+
+				if ( range != NULL )
+				{
+					range->acquire();
+					range->process();
+					range->release();
+				}
+				else
+				{
+					// If the range could not be allocated, process it on the calling thread.
+					for ( Index index = begin;  index != end;  ++index )
+						function(index);
+				}
+			}
+		}
+
+		/*
+			A function responsible of reducing every index in [begin,end) to a single value, in parallel, and returning the value.
+			Every participant starts from a copy of the identity and calls reduction(value,index) for every index it claims.
+			The partial values are then combined into the result, which also starts from the identity, by calling combination(result,value).
+			Since the partial values are combined in the order the participants finish, the combination should be associative and commutative.
+		*/
+		template <typename Index , typename Value , typename Reduction , typename Combination>
+		Value parallel_reduce(
+								const Index begin ,
+								const Index end ,
+								const size_t grain ,
+								const Value& identity ,
+								const Reduction& reduction ,
+								const Combination& combination
+							)
+		{
+			Value return_value(identity);
+
+
+			if ( begin < end )
+			{
+				ParallelReduceRange<Index,Value,Reduction,Combination>* range = new (std::nothrow) ParallelReduceRange<Index,Value,Reduction,Combination>(
+																																							begin ,
+																																							static_cast<size_t>(end - begin) ,
+																																							grain ,
+																																							identity ,
+																																							return_value ,
+																																							reduction ,
+																																							combination
+																																						);
+
+
+				if ( range != NULL )
+				{
+					range->acquire();
+					range->process();
+					range->release();
+				}
+				else
+				{
+					// If the range could not be allocated, reduce it on the calling thread.
+					for ( Index index = begin;  index != end;  ++index )
+						reduction(return_value,index);
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of calling the given functions in parallel. The function returns once every function has returned.
+		template <typename Function , typename... Functions>
+		void parallel_invoke( Function&& function , Functions&&... functions )
+		{
+			// The wrappers are temporaries, which live until every function has returned.
+			parallel_invoke_wrappers(std::ref(function),std::ref(functions)...);
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_PARALLELALGORITHMS_INL */
\ No newline at end of file
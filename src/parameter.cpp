@@ -11,8 +11,9 @@ namespace athena
 		// The constructor of the class.
 		Parameter::Parameter( const ParameterType& type , void* data ) : 
 			m_type(type) , 
-			m_data(data)
+			m_inline(false)
 		{
+			m_value.m_pointer = data;
 		}
 
 		// The destructor of the class.
@@ -20,6 +21,76 @@ namespace athena
 		{
 		}
 
+
+		// A function returning the size of the value of the given type.
+		size_t Parameter::size( const ParameterType& type )
+		{
+			size_t return_value = 0;
+
+
+			// Depending on the type of the parameter return the appropriate size.
+			switch ( type )
+			{
+				case Boolean:
+					return_value = sizeof(bool);
+					break;
+
+				case Character:
+					return_value = sizeof(char);
+					break;
+
+				case UnsignedCharacter:
+					return_value = sizeof(unsigned char);
+					break;
+
+				case WideCharacter:
+					return_value = sizeof(wchar_t);
+					break;
+
+				case ShortInteger:
+					return_value = sizeof(short);
+					break;
+
+				case UnsignedShortInteger:
+					return_value = sizeof(unsigned short);
+					break;
+
+				case Integer:
+					return_value = sizeof(int);
+					break;
+
+				case UnsignedInteger:
+					return_value = sizeof(unsigned int);
+					break;
+
+				case LongInteger:
+					return_value = sizeof(long);
+					break;
+
+				case UnsignedLongInteger:
+					return_value = sizeof(unsigned long);
+					break;
+
+				case Real:
+					return_value = sizeof(float);
+					break;
+
+				case DoubleReal:
+					return_value = sizeof(double);
+					break;
+
+				case Pointer:
+					return_value = sizeof(void*);
+					break;
+
+				default:
+					break;
+			}
+
+
+			return return_value;
+		}
+
 	} /* core */
 
 } /* athena */
\ No newline at end of file
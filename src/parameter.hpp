@@ -3,6 +3,7 @@
 
 #include "definitions.hpp"
 #include <cstddef>
+#include <cstring>
 
 
 
@@ -32,8 +33,33 @@ namespace athena
 		};
 
 
+		/*
+			A union holding the value of a parameter that is stored by value.
+			Every type of the ParameterType enumeration fits in the union.
+		*/
+		union ParameterValue
+		{
+			bool m_boolean;
+			char m_character;
+			unsigned char m_unsigned_character;
+			wchar_t m_wide_character;
+			short m_short_integer;
+			unsigned short m_unsigned_short_integer;
+			int m_integer;
+			unsigned int m_unsigned_integer;
+			long m_long_integer;
+			unsigned long m_unsigned_long_integer;
+			float m_real;
+			double m_double_real;
+			void* m_pointer;
+		};
+
+
 		/*
 			A class representing and handling a parameter of an event.
+			A parameter either points to data that is owned by the triggering entity or stores its
+			value inline, in which case the data of the parameter points to the value of the parameter itself.
+			Storing the value inline requires no allocation and no cleanup function.
 		*/
 		class Parameter
 		{
@@ -41,15 +67,17 @@ namespace athena
 
 				/*
 					Due to the fact that this class should have fast access to the 
-					type and data of the parameter, public access to the type and data
-					is recommended since the class will be used extensively by the event system
+					type of the parameter, public access to the type is recommended
+					since the class will be used extensively by the event system
 					and using the set/get functions can add up to a significant overhead.
 					However set/get functions are provided if the "typical" OO model is preferred.
 				*/
 				// A variable holding the type of the parameter.
 				ParameterType m_type;
-				// A variable pointing to the data of the parameter.
-				void* m_data;
+				// A variable holding whether the value of the parameter is stored inline.
+				bool m_inline;
+				// A variable holding the value of the parameter, or a pointer to the data of the parameter.
+				ParameterValue m_value;
 
 
 			public:
@@ -60,16 +88,24 @@ namespace athena
 				ATHENA_DLL ~Parameter();
 
 
+				// A function returning the size of the value of the given type.
+				ATHENA_DLL static size_t size( const ParameterType& type );
+
+
 				// A function responsible of setting the type of the parameter.
 				ATHENA_DLL void type( const ParameterType& type );
 				// A function responsible of setting the data of the parameter.
 				ATHENA_DLL void data( void* data );
+				// A function responsible of setting the type of the parameter and copying the given value inline.
+				ATHENA_DLL void value( const ParameterType& type , const void* value );
 
 					
 				// A function returning the type of the parameter.
 				ATHENA_DLL ParameterType type() const;
 				// A function returning the data of the parameter.
 				ATHENA_DLL void* data() const;
+				// A function returning whether the value of the parameter is stored inline.
+				ATHENA_DLL bool stored_inline() const;
 		};
 
 	} /* core */
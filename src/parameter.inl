@@ -22,7 +22,19 @@ namespace athena
 		// A function responsible of setting the data of the parameter.
 		inline void Parameter::data( void* data )
 		{
-			m_data = data;
+			m_inline = false;
+			m_value.m_pointer = data;
+		}
+
+		// A function responsible of setting the type of the parameter and copying the given value inline.
+		inline void Parameter::value( const ParameterType& type , const void* value )
+		{
+			m_type = type;
+			m_inline = true;
+			m_value.m_pointer = NULL;
+
+			if ( value != NULL )
+				memcpy(&m_value,value,size(type));
 		}
 
 					
@@ -35,7 +47,13 @@ namespace athena
 		// A function returning the data of the parameter.
 		inline void* Parameter::data() const
 		{
-			return m_data;
+			return ( m_inline  ?  const_cast<ParameterValue*>(&m_value) : m_value.m_pointer );
+		}
+
+		// A function returning whether the value of the parameter is stored inline.
+		inline bool Parameter::stored_inline() const
+		{
+			return m_inline;
 		}
 
 	} /* core */
@@ -8,19 +8,31 @@ namespace athena
 	namespace core
 	{
 
+		// The pool the periodic events are allocated from.
+		utility::ObjectPool PeriodicEventInfo::s_pool(sizeof(PeriodicEventInfo));
+
+
 		// The constructor of the class.
 		PeriodicEventInfo::PeriodicEventInfo() : 
 			m_event() , 
 			m_period(0) , 
-			m_last_trigger(0)
+			m_last_trigger(0) ,
+			m_deadline(0) ,
+			m_mode(FixedRate) ,
+			m_index(0) ,
+			m_cancelled(false)
 		{
 		}
 
 		// A constructor for the class that performs initialisation.
-		PeriodicEventInfo::PeriodicEventInfo( Event& event , const utility::TimerValueType& period , const utility::TimerValueType& last_trigger ) : 
+		PeriodicEventInfo::PeriodicEventInfo( Event& event , const utility::TimerValueType& period , const utility::TimerValueType& last_trigger , const PeriodicEventMode mode ) : 
 			m_event(event) , 
 			m_period(period) , 
-			m_last_trigger(last_trigger)
+			m_last_trigger(last_trigger) ,
+			m_deadline(last_trigger+period) ,
+			m_mode(mode) ,
+			m_index(0) ,
+			m_cancelled(false)
 		{
 		}
 		
@@ -29,6 +41,30 @@ namespace athena
 		{
 		}
 
+		// The allocation function of the class, which allocates the object from the pool of the class.
+		void* PeriodicEventInfo::operator new( size_t size , const std::nothrow_t& ) throw()
+		{
+			return s_pool.allocate(size);
+		}
+
+		// The deallocation function of the class, which returns the object to the pool of the class.
+		void PeriodicEventInfo::operator delete( void* pointer , size_t size )
+		{
+			s_pool.deallocate(pointer,size);
+		}
+
+		// The deallocation function that is called if the constructor throws after the object was allocated from the pool of the class.
+		void PeriodicEventInfo::operator delete( void* pointer , const std::nothrow_t& ) throw()
+		{
+			s_pool.deallocate(pointer,sizeof(PeriodicEventInfo));
+		}
+
+		// A function returning the pool the objects of the class are allocated from.
+		const utility::ObjectPool& PeriodicEventInfo::pool()
+		{
+			return s_pool;
+		}
+
 	} /* core */
 
 } /* athena */
\ No newline at end of file
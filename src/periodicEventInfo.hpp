@@ -1,8 +1,13 @@
 #ifndef ATHENA_CORE_PERIODICEVENTINFO_HPP
 #define ATHENA_CORE_PERIODICEVENTINFO_HPP
 
+#include "definitions.hpp"
+#include <cstddef>
+#include <new>
+#include <atomic>
 #include "event.hpp"
 #include "timer.hpp"
+#include "objectPool.hpp"
 
 
 
@@ -11,12 +16,30 @@ namespace athena
 
 	namespace core
 	{
+
+		/*
+			An enumeration holding the possible ways a periodic event can be rescheduled.
+			FixedRate keeps the event aligned to multiples of the period since it was registered,
+			skipping any periods that were missed. FixedDelay waits a whole period after each trigger.
+		*/
+		enum PeriodicEventMode
+		{
+			FixedRate = 0 ,
+			FixedDelay
+		};
+
 			
 		/*
 			An utility class that is representing and handling the information of an periodic event.
 		*/
 		class PeriodicEventInfo
 		{
+			private:
+
+				// The pool the periodic events are allocated from.
+				static utility::ObjectPool s_pool;
+
+
 			public:
 
 				// The event that is being triggered periodically.
@@ -25,6 +48,14 @@ namespace athena
 				utility::TimerValueType m_period;
 				// The time the event was last triggered.
 				utility::TimerValueType m_last_trigger;
+				// The time the event is next due.
+				utility::TimerValueType m_deadline;
+				// The way the event is rescheduled after it has been triggered.
+				PeriodicEventMode m_mode;
+				// The position of the event in the heap of the scheduler.
+				size_t m_index;
+				// A variable holding whether the event was unregistered while it was being triggered.
+				std::atomic<bool> m_cancelled;
 
 
 			public:
@@ -32,9 +63,18 @@ namespace athena
 				// The constructor of the class.
 				ATHENA_DLL PeriodicEventInfo();
 				// A constructor for the class that performs initialisation.
-				explicit ATHENA_DLL PeriodicEventInfo( Event& event , const utility::TimerValueType& period = 0 , const utility::TimerValueType& last_trigger = 0 );
+				explicit ATHENA_DLL PeriodicEventInfo( Event& event , const utility::TimerValueType& period = 0 , const utility::TimerValueType& last_trigger = 0 , const PeriodicEventMode mode = FixedRate );
 				// The destructor of the class.
 				ATHENA_DLL ~PeriodicEventInfo();
+
+				// The allocation function of the class, which allocates the object from the pool of the class.
+				ATHENA_DLL static void* operator new( size_t size , const std::nothrow_t& ) throw();
+				// The deallocation function of the class, which returns the object to the pool of the class.
+				ATHENA_DLL static void operator delete( void* pointer , size_t size );
+				// The deallocation function that is called if the constructor throws after the object was allocated from the pool of the class.
+				ATHENA_DLL static void operator delete( void* pointer , const std::nothrow_t& ) throw();
+				// A function returning the pool the objects of the class are allocated from.
+				ATHENA_DLL static const utility::ObjectPool& pool();
 		};
 
 	} /* core */
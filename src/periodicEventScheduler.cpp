@@ -0,0 +1,257 @@
+#include "periodicEventScheduler.hpp"
+#include <cmath>
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of moving the event at the given position towards the root of the heap.
+		void PeriodicEventScheduler::sift_up( size_t index )
+		{
+			PeriodicEventInfo* info = m_heap[index];
+
+
+			while ( index > 0 )
+			{
+				size_t parent = ( index - 1 ) / 2;
+
+
+				if ( m_heap[parent]->m_deadline <= info->m_deadline )
+					break;
+
+				place(index,m_heap[parent]);
+				index = parent;
+			}
+
+			place(index,info);
+		}
+
+		// A function responsible of moving the event at the given position towards the leaves of the heap.
+		void PeriodicEventScheduler::sift_down( size_t index )
+		{
+			PeriodicEventInfo* info = m_heap[index];
+			size_t size = m_heap.size();
+
+
+			while ( index*2 + 1 < size )
+			{
+				size_t child = index*2 + 1;
+
+
+				// Pick the earliest of the two children.
+				if ( child + 1 < size  &&  m_heap[child+1]->m_deadline < m_heap[child]->m_deadline )
+					++child;
+
+				if ( info->m_deadline <= m_heap[child]->m_deadline )
+					break;
+
+				place(index,m_heap[child]);
+				index = child;
+			}
+
+			place(index,info);
+		}
+
+		// A function responsible of inserting an event to the heap.
+		void PeriodicEventScheduler::insert( PeriodicEventInfo* info )
+		{
+			m_heap.push_back(info);
+			sift_up(m_heap.size()-1);
+		}
+
+		// A function responsible of removing an event from the heap.
+		void PeriodicEventScheduler::remove( PeriodicEventInfo* info )
+		{
+			size_t index = info->m_index;
+			PeriodicEventInfo* last = m_heap.back();
+
+
+			m_heap.pop_back();
+			info->m_index = s_IN_FLIGHT;
+
+			// Move the last event of the heap to the freed position, unless the removed event was the last one.
+			if ( last != info )
+			{
+				place(index,last);
+				update(last);
+			}
+		}
+
+		// A function responsible of restoring the heap property after the deadline of an event has changed.
+		void PeriodicEventScheduler::update( PeriodicEventInfo* info )
+		{
+			size_t index = info->m_index;
+
+
+			if ( index > 0  &&  m_heap[( index - 1 ) / 2]->m_deadline > info->m_deadline )
+				sift_up(index);
+			else
+				sift_down(index);
+		}
+
+
+		// The constructor of the class.
+		PeriodicEventScheduler::PeriodicEventScheduler() :
+			m_heap(0) ,
+			m_events()
+		{
+		}
+
+		// The destructor of the class.
+		PeriodicEventScheduler::~PeriodicEventScheduler()
+		{
+			clear();
+		}
+
+
+		// A function returning the registered event with the given code. Returns NULL if the event is not registered.
+		PeriodicEventInfo* PeriodicEventScheduler::find( const EventCode& code ) const
+		{
+			PeriodicEventInfo* return_value = NULL;
+			std::map<EventCode,PeriodicEventInfo*>::const_iterator event_iterator = m_events.find(code);
+
+
+			if ( event_iterator != m_events.end() )
+				return_value = event_iterator->second;
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of registering an event to be triggered every period, starting from the given time.
+			If the event is already registered, its period and mode are updated instead.
+			Returns false if the event could not be registered.
+		*/
+		bool PeriodicEventScheduler::schedule( Event& event , const utility::TimerValueType& period , const PeriodicEventMode mode , const utility::TimerValueType& current_time )
+		{
+			PeriodicEventInfo* info = find(event.code());
+			bool return_value = true;
+
+
+			// If the event is already registered, update it.
+			if ( info != NULL )
+			{
+				info->m_period = period;
+				info->m_mode = mode;
+
+				// An event that is being triggered gets its new deadline when it is rescheduled.
+				if ( info->m_index != s_IN_FLIGHT )
+				{
+					info->m_deadline = info->m_last_trigger + period;
+					update(info);
+				}
+			}
+			else
+			{
+				info = new (std::nothrow) PeriodicEventInfo(event,period,current_time,mode);
+
+				if ( info != NULL )
+				{
+					m_events[event.code()] = info;
+					insert(info);
+				}
+				else
+					return_value = false;
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of unregistering the event with the given code. The cleanup function of the event is called.
+		void PeriodicEventScheduler::cancel( const EventCode& code )
+		{
+			std::map<EventCode,PeriodicEventInfo*>::iterator event_iterator = m_events.find(code);
+
+
+			if ( event_iterator != m_events.end() )
+			{
+				PeriodicEventInfo* info = event_iterator->second;
+
+
+				m_events.erase(event_iterator);
+
+				// If the event is being triggered, it is deallocated once it is rescheduled.
+				if ( info->m_index == s_IN_FLIGHT )
+					info->m_cancelled = true;
+				else
+				{
+					remove(info);
+					// Call the cleanup function of the event.
+					info->m_event.cleanup();
+					delete info;
+				}
+			}
+		}
+
+		// A function responsible of removing every event that is due at the given time from the heap and appending it to the given list.
+		void PeriodicEventScheduler::collect( const utility::TimerValueType& current_time , std::vector<PeriodicEventInfo*>& due_events )
+		{
+			while ( m_heap.size() > 0  &&  m_heap[0]->m_deadline <= current_time )
+			{
+				PeriodicEventInfo* info = m_heap[0];
+
+
+				remove(info);
+				due_events.push_back(info);
+			}
+		}
+
+		/*
+			A function responsible of putting an event that was collected back into the heap.
+			The next deadline is calculated from the given time depending on the mode of the event.
+			If the event was unregistered while it was being triggered, it is deallocated instead.
+		*/
+		void PeriodicEventScheduler::reschedule( PeriodicEventInfo* info , const utility::TimerValueType& current_time )
+		{
+			if ( info->m_cancelled )
+			{
+				// Call the cleanup function of the event.
+				info->m_event.cleanup();
+				delete info;
+			}
+			else
+			{
+				if ( info->m_period <= 0 )
+					info->m_deadline = current_time;
+				else if ( info->m_mode == FixedDelay )
+					info->m_deadline = current_time + info->m_period;
+				else
+				{
+					// Advance the deadline by whole periods so that the event does not drift, skipping any missed periods.
+					info->m_deadline += info->m_period;
+
+					if ( info->m_deadline <= current_time )
+						info->m_deadline += ( std::floor((current_time - info->m_deadline)/info->m_period) + 1 ) * info->m_period;
+				}
+
+				insert(info);
+			}
+		}
+
+		// A function responsible of unregistering and cleaning up every event.
+		void PeriodicEventScheduler::clear()
+		{
+			for (
+					std::map<EventCode,PeriodicEventInfo*>::iterator event_iterator = m_events.begin();
+					event_iterator != m_events.end();
+					++event_iterator
+				)
+			{
+				// Call the cleanup function of the event.
+				event_iterator->second->m_event.cleanup();
+				delete event_iterator->second;
+			}
+
+			m_events.clear();
+			m_heap.clear();
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
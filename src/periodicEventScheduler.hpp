@@ -0,0 +1,101 @@
+#ifndef ATHENA_CORE_PERIODICEVENTSCHEDULER_HPP
+#define ATHENA_CORE_PERIODICEVENTSCHEDULER_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <map>
+#include <vector>
+#include "event.hpp"
+#include "timer.hpp"
+#include "periodicEventInfo.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A class responsible of scheduling the periodic events of the event manager.
+			The events are kept in a binary min-heap ordered by the time they are next due, so finding
+			the due events and the next deadline does not depend on the amount of registered events.
+			Registering, updating and unregistering an event cost O(log n).
+			Due events are taken out of the heap while they are being triggered and are put back
+			through reschedule(), so an event can safely be updated or unregistered by its listeners.
+		*/
+		class PeriodicEventScheduler
+		{
+			private:
+
+				// The value of the heap index of an event that is being triggered.
+				static const size_t s_IN_FLIGHT = static_cast<size_t>(-1);
+
+
+				// The min-heap of the scheduled events, ordered by their deadline.
+				std::vector<PeriodicEventInfo*> m_heap;
+				// The registered events, indexed by their code.
+				std::map<EventCode,PeriodicEventInfo*> m_events;
+
+
+				// A function responsible of placing an event at the given position of the heap.
+				void place( const size_t index , PeriodicEventInfo* info );
+				// A function responsible of moving the event at the given position towards the root of the heap.
+				void sift_up( size_t index );
+				// A function responsible of moving the event at the given position towards the leaves of the heap.
+				void sift_down( size_t index );
+				// A function responsible of inserting an event to the heap.
+				void insert( PeriodicEventInfo* info );
+				// A function responsible of removing an event from the heap.
+				void remove( PeriodicEventInfo* info );
+				// A function responsible of restoring the heap property after the deadline of an event has changed.
+				void update( PeriodicEventInfo* info );
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL PeriodicEventScheduler();
+				// The destructor of the class.
+				ATHENA_DLL ~PeriodicEventScheduler();
+
+
+				// A function returning the registered event with the given code. Returns NULL if the event is not registered.
+				ATHENA_DLL PeriodicEventInfo* find( const EventCode& code ) const;
+				/*
+					A function responsible of registering an event to be triggered every period, starting from the given time.
+					If the event is already registered, its period and mode are updated instead.
+					Returns false if the event could not be registered.
+				*/
+				ATHENA_DLL bool schedule( Event& event , const utility::TimerValueType& period , const PeriodicEventMode mode , const utility::TimerValueType& current_time );
+				// A function responsible of unregistering the event with the given code. The cleanup function of the event is called.
+				ATHENA_DLL void cancel( const EventCode& code );
+				// A function responsible of removing every event that is due at the given time from the heap and appending it to the given list.
+				ATHENA_DLL void collect( const utility::TimerValueType& current_time , std::vector<PeriodicEventInfo*>& due_events );
+				/*
+					A function responsible of putting an event that was collected back into the heap.
+					The next deadline is calculated from the given time depending on the mode of the event.
+					If the event was unregistered while it was being triggered, it is deallocated instead.
+				*/
+				ATHENA_DLL void reschedule( PeriodicEventInfo* info , const utility::TimerValueType& current_time );
+				// A function responsible of unregistering and cleaning up every event.
+				ATHENA_DLL void clear();
+
+
+				// A function returning the time the next event is due. Returns false if there are no scheduled events.
+				ATHENA_DLL bool next_deadline( utility::TimerValueType& deadline ) const;
+				// A function returning the amount of registered events.
+				ATHENA_DLL size_t size() const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "periodicEventScheduler.inl"
+
+
+
+#endif /* ATHENA_CORE_PERIODICEVENTSCHEDULER_HPP */
\ No newline at end of file
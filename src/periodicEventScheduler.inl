@@ -0,0 +1,52 @@
+#ifndef ATHENA_CORE_PERIODICEVENTSCHEDULER_INL
+#define ATHENA_CORE_PERIODICEVENTSCHEDULER_INL
+
+#ifndef ATHENA_CORE_PERIODICEVENTSCHEDULER_HPP
+	#error "periodicEventScheduler.hpp must be included before periodicEventScheduler.inl"
+#endif /* ATHENA_CORE_PERIODICEVENTSCHEDULER_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of placing an event at the given position of the heap.
+		inline void PeriodicEventScheduler::place( const size_t index , PeriodicEventInfo* info )
+		{
+			m_heap[index] = info;
+			info->m_index = index;
+		}
+
+
+		// A function returning the time the next event is due. Returns false if there are no scheduled events.
+		inline bool PeriodicEventScheduler::next_deadline( utility::TimerValueType& deadline ) const
+		{
+			bool return_value = false;
+
+
+			if ( m_heap.size() > 0 )
+			{
+				deadline = m_heap[0]->m_deadline;
+				return_value = true;
+			}
+
+
+			return return_value;
+		}
+
+		// A function returning the amount of registered events.
+		inline size_t PeriodicEventScheduler::size() const
+		{
+			return m_events.size();
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_PERIODICEVENTSCHEDULER_INL */
\ No newline at end of file
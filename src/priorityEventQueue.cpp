@@ -0,0 +1,246 @@
+#include "priorityEventQueue.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the class.
+		PriorityEventQueue::PriorityEventQueue() :
+			m_range_count(0) ,
+			m_range_lock()
+		{
+			// The default weights halve from each class to the next, less urgent, one.
+			for ( unsigned int i = 0;  i < s_LANE_COUNT;  ++i )
+				m_weights[i].store(1U << ( s_LANE_COUNT - 1 - i ),std::memory_order_relaxed);
+
+			for ( unsigned int i = 0;  i < s_MAX_PRIORITY_RANGES;  ++i )
+			{
+				m_ranges[i].m_first = 0;
+				m_ranges[i].m_last = 0;
+				m_ranges[i].m_priority.store(NormalPriority,std::memory_order_relaxed);
+			}
+		}
+
+		// The destructor of the class.
+		PriorityEventQueue::~PriorityEventQueue()
+		{
+		}
+
+
+		/*
+			A function responsible of (re)allocating every lane with the given capacity and policy.
+			Any queued events are cleaned up. Must not be called while other threads are using the queue.
+		*/
+		bool PriorityEventQueue::initialise( const size_t capacity , const EventQueueOverflowPolicy policy )
+		{
+			bool return_value = true;
+
+
+			for ( unsigned int i = 0;  i < s_LANE_COUNT  &&  return_value;  ++i )
+				return_value = m_lanes[i].initialise(capacity,policy);
+
+
+			return return_value;
+		}
+
+		// A function responsible of setting the thread that consumes the queue.
+		void PriorityEventQueue::consumer( const std::thread::id& id )
+		{
+			for ( unsigned int i = 0;  i < s_LANE_COUNT;  ++i )
+				m_lanes[i].consumer(id);
+		}
+
+		// A function responsible of pushing an event to the lane of its priority class. The event is moved into the queue.
+		void PriorityEventQueue::push( Event& event )
+		{
+			event.trigger_time(EventClock::now());
+			m_lanes[priority(event.code())].push(event);
+		}
+
+		/*
+			A function responsible of pushing a batch of events to the lanes of their priority classes, claiming a single range
+			of slots for every run of events that belong to the same class. Returns the amount of events that were queued,
+			which are moved into the queue. The remaining events have to be pushed one at a time.
+		*/
+		size_t PriorityEventQueue::push( Event* events , const size_t count )
+		{
+			EventClock::time_point current_time = EventClock::now();
+			size_t return_value = 0;
+			bool full = false;
+
+
+			for ( size_t i = 0;  i < count;  ++i )
+				events[i].trigger_time(current_time);
+
+			while ( return_value < count  &&  !full )
+			{
+				EventPriority lane = priority(events[return_value].code());
+				size_t run = 1;
+				size_t pushed = 0;
+
+
+				while ( return_value + run < count  &&  priority(events[return_value + run].code()) == lane )
+					++run;
+
+				pushed = m_lanes[lane].push(events + return_value,run);
+				full = ( pushed < run );
+				return_value += pushed;
+			}
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of moving the events of a single weighted round to the given vector.
+			Returns the amount of events that were moved, which is zero (0) only if every lane is empty.
+		*/
+		size_t PriorityEventQueue::pop( std::vector<Event>& events )
+		{
+			EventClock::time_point current_time = EventClock::now();
+			Event event;
+			size_t return_value = 0;
+
+
+			for ( unsigned int lane = 0;  lane < s_LANE_COUNT;  ++lane )
+			{
+				unsigned int budget = m_weights[lane].load(std::memory_order_relaxed);
+
+
+				while ( budget > 0  &&  m_lanes[lane].pop(event) )
+				{
+					record_wait_time(lane,event,current_time);
+					events.push_back(std::move(event));
+					++return_value;
+					--budget;
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of cleaning up any queued events.
+		void PriorityEventQueue::clear()
+		{
+			for ( unsigned int i = 0;  i < s_LANE_COUNT;  ++i )
+				m_lanes[i].clear();
+		}
+
+
+		/*
+			A function responsible of assigning the given priority class to the given range of event codes.
+			Returns false if the class is invalid or no more ranges can be assigned.
+		*/
+		bool PriorityEventQueue::priority( const EventCode first , const EventCode last , const EventPriority priority )
+		{
+			bool return_value = false;
+
+
+			if ( static_cast<unsigned int>(priority) < s_LANE_COUNT  &&  first <= last )
+			{
+				unsigned int count = 0;
+				unsigned int match = s_MAX_PRIORITY_RANGES;
+
+
+				m_range_lock.lock();
+				count = m_range_count.load(std::memory_order_relaxed);
+
+				// An identical range that is the most recent one to cover its codes can be changed in place.
+				for ( unsigned int index = count;  index > 0;  --index )
+				{
+					const EventPriorityRange& range = m_ranges[index - 1];
+
+
+					if ( range.m_first == first  &&  range.m_last == last )
+					{
+						match = index - 1;
+						break;
+					}
+					else if ( range.m_first <= last  &&  first <= range.m_last )
+						break;
+				}
+
+				if ( match < s_MAX_PRIORITY_RANGES )
+				{
+					m_ranges[match].m_priority.store(priority,std::memory_order_relaxed);
+					return_value = true;
+				}
+				else if ( count < s_MAX_PRIORITY_RANGES )
+				{
+					/*
+						The range is written before the count is raised, so a thread that
+						observes the new count also observes the bounds of the range.
+					*/
+					m_ranges[count].m_first = first;
+					m_ranges[count].m_last = last;
+					m_ranges[count].m_priority.store(priority,std::memory_order_relaxed);
+					m_range_count.store(count + 1,std::memory_order_release);
+					return_value = true;
+				}
+
+				m_range_lock.unlock();
+			}
+
+
+			return return_value;
+		}
+
+
+		// A function returning the priority class of the given event code.
+		EventPriority PriorityEventQueue::priority( const EventCode code ) const
+		{
+			unsigned int count = m_range_count.load(std::memory_order_acquire);
+			EventPriority return_value = NormalPriority;
+
+
+			// The most recently assigned range that covers the code determines its class.
+			for ( unsigned int index = count;  index > 0;  --index )
+			{
+				const EventPriorityRange& range = m_ranges[index - 1];
+
+
+				if ( range.m_first <= code  &&  code <= range.m_last )
+				{
+					return_value = static_cast<EventPriority>(range.m_priority.load(std::memory_order_relaxed));
+					break;
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function returning whether every lane is empty.
+		bool PriorityEventQueue::empty() const
+		{
+			bool return_value = true;
+
+
+			for ( unsigned int i = 0;  i < s_LANE_COUNT  &&  return_value;  ++i )
+				return_value = m_lanes[i].empty();
+
+
+			return return_value;
+		}
+
+		// A function returning the amount of events that have been dropped due to the overflow policy.
+		unsigned long long PriorityEventQueue::dropped() const
+		{
+			unsigned long long return_value = 0;
+
+
+			for ( unsigned int i = 0;  i < s_LANE_COUNT;  ++i )
+				return_value += m_lanes[i].dropped();
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
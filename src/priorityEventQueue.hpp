@@ -0,0 +1,160 @@
+#ifndef ATHENA_CORE_PRIORITYEVENTQUEUE_HPP
+#define ATHENA_CORE_PRIORITYEVENTQUEUE_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <vector>
+#include "event.hpp"
+#include "eventQueue.hpp"
+#include "histogram.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// An enumeration holding the priority classes an event can belong to, from the most to the least urgent.
+		enum EventPriority
+		{
+			CriticalPriority = 0 ,
+			InputPriority ,
+			NormalPriority ,
+			BackgroundPriority
+		};
+
+
+		/*
+			A queue that is used by the event manager in order to dispatch the events by priority.
+			Every priority class has its own lane, which is a lock-free event queue, and the class of an event
+			is determined by its code. Codes that have not been assigned a class belong to NormalPriority.
+			The consumer pops the lanes in weighted rounds: on every round each lane, from the most to the least
+			urgent, hands over at most as many events as its weight. Urgent events therefore overtake queued
+			events of lower classes, while every lane is served at least once per round, so lower classes
+			are never starved by a flood of more urgent events.
+			The time each event has waited in its lane is recorded in a per-lane histogram, in microseconds.
+		*/
+		class PriorityEventQueue
+		{
+			public:
+
+				// The amount of priority classes, and therefore lanes, of the queue.
+				static const unsigned int s_LANE_COUNT = 4;
+
+
+			private:
+
+				/*
+					A struct representing a range of event codes that has been assigned a priority class.
+					The bounds of a range never change after it has been published, while its class can be changed in place.
+				*/
+				struct EventPriorityRange
+				{
+					EventCode m_first;
+					EventCode m_last;
+					std::atomic<unsigned int> m_priority;
+				};
+
+
+				// The maximum amount of code ranges that can be assigned a priority class.
+				static const unsigned int s_MAX_PRIORITY_RANGES = 64;
+
+
+				// The lanes of the queue, one for each priority class.
+				EventQueue m_lanes[s_LANE_COUNT];
+				// The weights of the lanes, that is the maximum amount of events each lane hands over on every round.
+				std::atomic<unsigned int> m_weights[s_LANE_COUNT];
+				// The histograms of the time the events have waited in each lane, in microseconds.
+				utility::Histogram m_wait_times[s_LANE_COUNT];
+				// The code ranges that have been assigned a priority class. Later ranges take precedence over earlier ones.
+				EventPriorityRange m_ranges[s_MAX_PRIORITY_RANGES];
+				// The amount of published code ranges.
+				std::atomic<unsigned int> m_range_count;
+				// A lock that is used to handle concurrency issues between threads that assign priority classes.
+				std::mutex m_range_lock;
+
+
+				// The copy constructor is not available.
+				PriorityEventQueue( const PriorityEventQueue& );
+				// The assignment operator is not available.
+				PriorityEventQueue& operator=( const PriorityEventQueue& );
+
+
+				// A function responsible of recording the time an event has waited in the given lane.
+				void record_wait_time( const unsigned int lane , const Event& event , const EventClock::time_point& current_time );
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL PriorityEventQueue();
+				// The destructor of the class.
+				ATHENA_DLL ~PriorityEventQueue();
+
+
+				/*
+					A function responsible of (re)allocating every lane with the given capacity and policy.
+					Any queued events are cleaned up. Must not be called while other threads are using the queue.
+				*/
+				ATHENA_DLL bool initialise( const size_t capacity , const EventQueueOverflowPolicy policy );
+				// A function responsible of setting the thread that consumes the queue.
+				ATHENA_DLL void consumer( const std::thread::id& id );
+				// A function responsible of pushing an event to the lane of its priority class. The event is moved into the queue.
+				ATHENA_DLL void push( Event& event );
+				/*
+					A function responsible of pushing a batch of events to the lanes of their priority classes, claiming a single range
+					of slots for every run of events that belong to the same class. Returns the amount of events that were queued,
+					which are moved into the queue. The remaining events have to be pushed one at a time.
+				*/
+				ATHENA_DLL size_t push( Event* events , const size_t count );
+				/*
+					A function responsible of moving the events of a single weighted round to the given vector.
+					Returns the amount of events that were moved, which is zero (0) only if every lane is empty.
+				*/
+				ATHENA_DLL size_t pop( std::vector<Event>& events );
+				// A function responsible of cleaning up any queued events.
+				ATHENA_DLL void clear();
+
+
+				/*
+					A function responsible of assigning the given priority class to the given range of event codes.
+					Returns false if the class is invalid or no more ranges can be assigned.
+				*/
+				ATHENA_DLL bool priority( const EventCode first , const EventCode last , const EventPriority priority );
+				// A function responsible of setting the weight of the lane of the given priority class. A weight of zero (0) is treated as one (1).
+				ATHENA_DLL void weight( const EventPriority priority , const unsigned int value );
+
+
+				// A function returning the priority class of the given event code.
+				ATHENA_DLL EventPriority priority( const EventCode code ) const;
+				// A function returning the weight of the lane of the given priority class.
+				ATHENA_DLL unsigned int weight( const EventPriority priority ) const;
+				// A function returning the approximate amount of events that are queued in the lane of the given priority class.
+				ATHENA_DLL size_t depth( const EventPriority priority ) const;
+				// A function returning the histogram of the time the events have waited in the lane of the given priority class, in microseconds.
+				ATHENA_DLL const utility::Histogram& wait_time( const EventPriority priority ) const;
+				// A function returning whether every lane is empty.
+				ATHENA_DLL bool empty() const;
+				// A function returning the capacity of each lane.
+				ATHENA_DLL size_t capacity() const;
+				// A function returning the amount of events that have been dropped due to the overflow policy.
+				ATHENA_DLL unsigned long long dropped() const;
+				// A function returning the amount of events of the lane of the given priority class that have been dropped due to the overflow policy.
+				ATHENA_DLL unsigned long long dropped( const EventPriority priority ) const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "priorityEventQueue.inl"
+
+
+
+#endif /* ATHENA_CORE_PRIORITYEVENTQUEUE_HPP */
\ No newline at end of file
@@ -0,0 +1,70 @@
+#ifndef ATHENA_CORE_PRIORITYEVENTQUEUE_INL
+#define ATHENA_CORE_PRIORITYEVENTQUEUE_INL
+
+#ifndef ATHENA_CORE_PRIORITYEVENTQUEUE_HPP
+	#error "priorityEventQueue.hpp must be included before priorityEventQueue.inl"
+#endif /* ATHENA_CORE_PRIORITYEVENTQUEUE_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of recording the time an event has waited in the given lane.
+		inline void PriorityEventQueue::record_wait_time( const unsigned int lane , const Event& event , const EventClock::time_point& current_time )
+		{
+			if ( current_time > event.trigger_time() )
+				m_wait_times[lane].record(static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(current_time - event.trigger_time()).count()));
+			else
+				m_wait_times[lane].record(0);
+		}
+
+
+		// A function responsible of setting the weight of the lane of the given priority class. A weight of zero (0) is treated as one (1).
+		inline void PriorityEventQueue::weight( const EventPriority priority , const unsigned int value )
+		{
+			if ( static_cast<unsigned int>(priority) < s_LANE_COUNT )
+				m_weights[priority].store(( value > 0  ?  value : 1 ),std::memory_order_relaxed);
+		}
+
+
+		// A function returning the weight of the lane of the given priority class.
+		inline unsigned int PriorityEventQueue::weight( const EventPriority priority ) const
+		{
+			return ( static_cast<unsigned int>(priority) < s_LANE_COUNT  ?  m_weights[priority].load(std::memory_order_relaxed) : 0 );
+		}
+
+		// A function returning the approximate amount of events that are queued in the lane of the given priority class.
+		inline size_t PriorityEventQueue::depth( const EventPriority priority ) const
+		{
+			return ( static_cast<unsigned int>(priority) < s_LANE_COUNT  ?  m_lanes[priority].size() : 0 );
+		}
+
+		// A function returning the histogram of the time the events have waited in the lane of the given priority class, in microseconds.
+		inline const utility::Histogram& PriorityEventQueue::wait_time( const EventPriority priority ) const
+		{
+			return m_wait_times[( static_cast<unsigned int>(priority) < s_LANE_COUNT  ?  priority : NormalPriority )];
+		}
+
+		// A function returning the capacity of each lane.
+		inline size_t PriorityEventQueue::capacity() const
+		{
+			return m_lanes[0].capacity();
+		}
+
+		// A function returning the amount of events of the lane of the given priority class that have been dropped due to the overflow policy.
+		inline unsigned long long PriorityEventQueue::dropped( const EventPriority priority ) const
+		{
+			return ( static_cast<unsigned int>(priority) < s_LANE_COUNT  ?  m_lanes[priority].dropped() : 0 );
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_PRIORITYEVENTQUEUE_INL */
\ No newline at end of file
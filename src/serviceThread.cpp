@@ -0,0 +1,98 @@
+#include "serviceThread.hpp"
+#include "threadUtilities.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The function that is run by the service thread.
+		void ServiceThread::thread_functionality( ServiceThread* service )
+		{
+			if ( service != NULL )
+			{
+				utility::set_thread_name(service->m_name);
+				service->m_exit_code.store((*service->m_function)(service->m_parameter),std::memory_order_relaxed);
+				service->m_running.store(false,std::memory_order_release);
+			}
+		}
+
+
+		// The constructor of the class.
+		ServiceThread::ServiceThread() :
+			m_name("") ,
+			m_function(NULL) ,
+			m_parameter(NULL) ,
+			m_thread(NULL) ,
+			m_lock() ,
+			m_exit_code(0) ,
+			m_running(false)
+		{
+		}
+
+		// The destructor of the class. The service thread is joined, so the function of the service must have been told to return.
+		ServiceThread::~ServiceThread()
+		{
+			join();
+		}
+
+
+		/*
+			A function responsible of spawning the service thread, which calls the given function with the given parameter.
+			Returns false if the service is already started or the thread could not be spawned.
+		*/
+		bool ServiceThread::start( const std::string& name , TaskFunction function , void* parameter )
+		{
+			bool return_value = false;
+
+
+			m_lock.lock();
+
+			if ( m_thread == NULL  &&  function != NULL )
+			{
+				m_name = name;
+				m_function = function;
+				m_parameter = parameter;
+				m_exit_code.store(0,std::memory_order_relaxed);
+				// The service is marked as running before the thread is spawned, so that it is never seen as finished before it starts.
+				m_running.store(true,std::memory_order_release);
+				m_thread = new (std::nothrow) std::thread(thread_functionality,this);
+
+				if ( m_thread != NULL )
+					return_value = true;
+				else
+					m_running.store(false,std::memory_order_release);
+			}
+
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of blocking until the function of the service returns and releasing the service thread.
+			Must not be called by the service thread itself.
+		*/
+		void ServiceThread::join()
+		{
+			m_lock.lock();
+
+			if ( m_thread != NULL )
+			{
+				if ( m_thread->joinable() )
+					m_thread->join();
+
+				delete m_thread;
+				m_thread = NULL;
+			}
+
+			m_lock.unlock();
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
@@ -0,0 +1,95 @@
+#ifndef ATHENA_CORE_SERVICETHREAD_HPP
+#define ATHENA_CORE_SERVICETHREAD_HPP
+
+#include "definitions.hpp"
+#include <atomic>
+#include <mutex>
+#include <thread>
+#include <string>
+#include <new>
+#include "threadTask.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A class representing a dedicated thread that runs a long-lived service loop, such as the loop of the event manager.
+			The tasks of the thread pool are expected to return quickly, so a loop that runs for as long as a manager is
+			operational is given its own named thread, instead of permanently occupying a thread of the pool.
+			The function of the service is called once, on the service thread, and the service is stopped by joining
+			the thread after the function has been told to return. The service thread is named after the service,
+			on the platforms that support thread names.
+		*/
+		class ServiceThread
+		{
+			private:
+
+				// The name of the service.
+				std::string m_name;
+				// The function that is run by the service thread.
+				TaskFunction m_function;
+				// The parameter of the function.
+				void* m_parameter;
+				// The service thread.
+				std::thread* m_thread;
+				// A lock that is used to handle concurrency issues.
+				std::mutex m_lock;
+				// The exit code of the function.
+				std::atomic<int> m_exit_code;
+				// A variable holding whether the function of the service is running.
+				std::atomic<bool> m_running;
+
+
+				// The copy constructor is not available.
+				ServiceThread( const ServiceThread& );
+				// The assignment operator is not available.
+				ServiceThread& operator=( const ServiceThread& );
+
+
+				// The function that is run by the service thread.
+				static void thread_functionality( ServiceThread* service );
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL ServiceThread();
+				// The destructor of the class. The service thread is joined, so the function of the service must have been told to return.
+				ATHENA_DLL ~ServiceThread();
+
+
+				/*
+					A function responsible of spawning the service thread, which calls the given function with the given parameter.
+					Returns false if the service is already started or the thread could not be spawned.
+				*/
+				ATHENA_DLL bool start( const std::string& name , TaskFunction function , void* parameter );
+				/*
+					A function responsible of blocking until the function of the service returns and releasing the service thread.
+					Must not be called by the service thread itself.
+				*/
+				ATHENA_DLL void join();
+
+
+				// A function returning the name of the service.
+				ATHENA_DLL const std::string& name() const;
+				// A function returning whether the function of the service is running.
+				ATHENA_DLL bool running() const;
+				// A function returning the exit code of the function of the service, once it has returned.
+				ATHENA_DLL int exit_code() const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "serviceThread.inl"
+
+
+
+#endif /* ATHENA_CORE_SERVICETHREAD_HPP */
\ No newline at end of file
@@ -0,0 +1,40 @@
+#ifndef ATHENA_CORE_SERVICETHREAD_INL
+#define ATHENA_CORE_SERVICETHREAD_INL
+
+#ifndef ATHENA_CORE_SERVICETHREAD_HPP
+	#error "serviceThread.hpp must be included before serviceThread.inl"
+#endif /* ATHENA_CORE_SERVICETHREAD_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function returning the name of the service.
+		inline const std::string& ServiceThread::name() const
+		{
+			return m_name;
+		}
+
+		// A function returning whether the function of the service is running.
+		inline bool ServiceThread::running() const
+		{
+			return m_running.load(std::memory_order_acquire);
+		}
+
+		// A function returning the exit code of the function of the service, once it has returned.
+		inline int ServiceThread::exit_code() const
+		{
+			return m_exit_code.load(std::memory_order_acquire);
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_SERVICETHREAD_INL */
\ No newline at end of file
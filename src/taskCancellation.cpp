@@ -0,0 +1,75 @@
+#include "taskCancellation.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the class.
+		TaskCancellationState::TaskCancellationState() :
+			m_references(0) ,
+			m_cancelled(false)
+		{
+		}
+
+
+		// A function responsible of creating a new cancellation. The handle is invalid if the state could not be allocated.
+		TaskCancellation TaskCancellation::create()
+		{
+			return TaskCancellation(new (std::nothrow) TaskCancellationState());
+		}
+
+
+		// The constructor of the class, which creates an invalid handle.
+		TaskCancellation::TaskCancellation() :
+			m_state(NULL)
+		{
+		}
+
+		// A constructor of the class that refers to the given state.
+		TaskCancellation::TaskCancellation( TaskCancellationState* state ) :
+			m_state(state)
+		{
+			if ( m_state != NULL )
+				m_state->acquire();
+		}
+
+		// The copy constructor of the class. The copy refers to the same cancellation.
+		TaskCancellation::TaskCancellation( const TaskCancellation& cancellation ) :
+			m_state(cancellation.m_state)
+		{
+			if ( m_state != NULL )
+				m_state->acquire();
+		}
+
+		// The destructor of the class.
+		TaskCancellation::~TaskCancellation()
+		{
+			if ( m_state != NULL )
+				m_state->release();
+		}
+
+
+		// The assignment operator. The handle refers to the cancellation of the given handle.
+		TaskCancellation& TaskCancellation::operator=( const TaskCancellation& cancellation )
+		{
+			if ( m_state != cancellation.m_state )
+			{
+				if ( cancellation.m_state != NULL )
+					cancellation.m_state->acquire();
+
+				if ( m_state != NULL )
+					m_state->release();
+
+				m_state = cancellation.m_state;
+			}
+
+			return *this;
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
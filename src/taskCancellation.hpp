@@ -0,0 +1,108 @@
+#ifndef ATHENA_CORE_TASKCANCELLATION_HPP
+#define ATHENA_CORE_TASKCANCELLATION_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <atomic>
+#include <new>
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A class holding the state that is shared between the handles of a cancellation and the tasks it has been given to.
+		class TaskCancellationState
+		{
+			private:
+
+				// The amount of references to the state.
+				std::atomic<unsigned int> m_references;
+				// A variable holding whether the cancellation has been requested.
+				std::atomic<bool> m_cancelled;
+
+
+				// The copy constructor is not available.
+				TaskCancellationState( const TaskCancellationState& );
+				// The assignment operator is not available.
+				TaskCancellationState& operator=( const TaskCancellationState& );
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL TaskCancellationState();
+
+
+				// A function responsible of acquiring a reference to the state.
+				ATHENA_DLL void acquire();
+				// A function responsible of releasing a reference to the state. The state is deallocated when the last reference is released.
+				ATHENA_DLL void release();
+				// A function responsible of requesting the cancellation.
+				ATHENA_DLL void cancel();
+
+
+				// A function returning whether the cancellation has been requested.
+				ATHENA_DLL bool cancelled() const;
+		};
+
+
+		/*
+			A class representing a handle that is used to cooperatively cancel a group of tasks. Any amount of tasks
+			can be given the same handle. Once the cancellation is requested, the tasks that have not started are
+			dropped by the thread pool, while the tasks that are running may poll the handle and return early.
+			Copies of a handle refer to the same cancellation. A default constructed handle is invalid and is never cancelled.
+		*/
+		class TaskCancellation
+		{
+			private:
+
+				// The shared state of the cancellation.
+				TaskCancellationState* m_state;
+
+
+			public:
+
+				// A function responsible of creating a new cancellation. The handle is invalid if the state could not be allocated.
+				ATHENA_DLL static TaskCancellation create();
+
+
+				// The constructor of the class, which creates an invalid handle.
+				ATHENA_DLL TaskCancellation();
+				// A constructor of the class that refers to the given state.
+				ATHENA_DLL explicit TaskCancellation( TaskCancellationState* state );
+				// The copy constructor of the class. The copy refers to the same cancellation.
+				ATHENA_DLL TaskCancellation( const TaskCancellation& cancellation );
+				// The destructor of the class.
+				ATHENA_DLL ~TaskCancellation();
+
+
+				// The assignment operator. The handle refers to the cancellation of the given handle.
+				ATHENA_DLL TaskCancellation& operator=( const TaskCancellation& cancellation );
+
+
+				// A function responsible of requesting the cancellation. Has no effect on an invalid handle.
+				ATHENA_DLL void cancel();
+
+
+				// A function returning the shared state of the cancellation.
+				ATHENA_DLL TaskCancellationState* state() const;
+				// A function returning whether the handle refers to a cancellation.
+				ATHENA_DLL bool valid() const;
+				// A function returning whether the cancellation has been requested.
+				ATHENA_DLL bool cancelled() const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "taskCancellation.inl"
+
+
+
+#endif /* ATHENA_CORE_TASKCANCELLATION_HPP */
\ No newline at end of file
@@ -0,0 +1,75 @@
+#ifndef ATHENA_CORE_TASKCANCELLATION_INL
+#define ATHENA_CORE_TASKCANCELLATION_INL
+
+#ifndef ATHENA_CORE_TASKCANCELLATION_HPP
+	#error "taskCancellation.hpp must be included before taskCancellation.inl"
+#endif /* ATHENA_CORE_TASKCANCELLATION_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of acquiring a reference to the state.
+		inline void TaskCancellationState::acquire()
+		{
+			m_references.fetch_add(1,std::memory_order_relaxed);
+		}
+
+		// A function responsible of releasing a reference to the state. The state is deallocated when the last reference is released.
+		inline void TaskCancellationState::release()
+		{
+			if ( m_references.fetch_sub(1,std::memory_order_acq_rel) == 1 )
+				delete this;
+		}
+
+		// A function responsible of requesting the cancellation.
+		inline void TaskCancellationState::cancel()
+		{
+			m_cancelled.store(true,std::memory_order_release);
+		}
+
+
+		// A function returning whether the cancellation has been requested.
+		inline bool TaskCancellationState::cancelled() const
+		{
+			return m_cancelled.load(std::memory_order_acquire);
+		}
+
+
+		// A function responsible of requesting the cancellation. Has no effect on an invalid handle.
+		inline void TaskCancellation::cancel()
+		{
+			if ( m_state != NULL )
+				m_state->cancel();
+		}
+
+
+		// A function returning the shared state of the cancellation.
+		inline TaskCancellationState* TaskCancellation::state() const
+		{
+			return m_state;
+		}
+
+		// A function returning whether the handle refers to a cancellation.
+		inline bool TaskCancellation::valid() const
+		{
+			return ( m_state != NULL );
+		}
+
+		// A function returning whether the cancellation has been requested.
+		inline bool TaskCancellation::cancelled() const
+		{
+			return ( m_state != NULL  &&  m_state->cancelled() );
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_TASKCANCELLATION_INL */
\ No newline at end of file
@@ -0,0 +1,252 @@
+#ifndef ATHENA_CORE_TASKCOROUTINE_HPP
+#define ATHENA_CORE_TASKCOROUTINE_HPP
+
+#include "definitions.hpp"
+
+#ifndef __cpp_impl_coroutine
+	#error "taskCoroutine.hpp requires a compiler with C++20 coroutine support"
+#endif /* __cpp_impl_coroutine */
+
+#include <cstddef>
+#include <coroutine>
+#include <exception>
+#include <new>
+#include <utility>
+#include "threadTask.hpp"
+#include "taskFuture.hpp"
+#include "threadPool.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A class representing the callable of a task that resumes a suspended coroutine once the future it awaits is ready.
+			A coroutine that awaits an abandoned future is destroyed instead of being resumed, which abandons its own result as well.
+			A coroutine whose task is deallocated without being performed, because the thread pool was terminated, is destroyed too.
+		*/
+		class TaskResumption
+		{
+			private:
+
+				// The coroutine that is resumed.
+				std::coroutine_handle<> m_handle;
+				// The future the coroutine awaits. An invalid future means that the coroutine only waits for a thread of the pool.
+				TaskFutureBase m_future;
+
+
+				// The copy constructor is not available.
+				TaskResumption( const TaskResumption& );
+				// The assignment operator is not available.
+				TaskResumption& operator=( const TaskResumption& );
+
+
+			public:
+
+				// The constructor of the class.
+				TaskResumption( std::coroutine_handle<> handle , const TaskFutureBase& future );
+				// The move constructor of the class.
+				TaskResumption( TaskResumption&& resumption );
+				// The destructor of the class. A coroutine that has not been resumed is destroyed.
+				~TaskResumption();
+
+
+				// A function responsible of giving up the coroutine without resuming or destroying it, and returning it.
+				std::coroutine_handle<> release();
+
+
+				// The function call operator, which resumes the coroutine, or destroys it if the future it awaits has been abandoned.
+				void operator()();
+		};
+
+
+		/*
+			A class representing the awaiter that moves a coroutine to a thread of the pool. If the coroutine cannot be
+			queued, it continues on the calling thread.
+		*/
+		class TaskScheduleAwaiter
+		{
+			public:
+
+				// A function returning whether the coroutine can continue without suspending, which is never the case.
+				bool await_ready() const;
+				// A function responsible of queuing the suspended coroutine to the thread pool. Returns false if the coroutine should continue at once.
+				bool await_suspend( std::coroutine_handle<> handle ) const;
+				// A function that is called when the coroutine continues.
+				void await_resume() const;
+		};
+
+
+		// A class holding the functionality that is shared between the awaiters of the futures of every type.
+		class TaskFutureAwaiterBase
+		{
+			protected:
+
+				// A function returning whether a coroutine awaiting the given future can continue without suspending, which is the case if the future is fulfilled.
+				static bool ready( const TaskFutureBase& future );
+				/*
+					A function responsible of resuming the given suspended coroutine once the given future is ready.
+					Returns false if the coroutine should continue at once.
+				*/
+				static bool suspend( std::coroutine_handle<> handle , const TaskFutureBase& future );
+		};
+
+
+		/*
+			A class representing the awaiter of a future. The coroutine is suspended until the future is ready and then resumed
+			on a thread of the pool, so awaiting never blocks a thread. Awaiting a fulfilled future copies its result, while a coroutine
+			that awaits an abandoned or invalid future is destroyed without being resumed, abandoning its own result.
+		*/
+		template <typename Type>
+		class TaskFutureAwaiter : public TaskFutureAwaiterBase
+		{
+			private:
+
+				// The future that is awaited.
+				TaskFuture<Type> m_future;
+
+
+			public:
+
+				// The constructor of the class.
+				explicit TaskFutureAwaiter( const TaskFuture<Type>& future );
+
+
+				// A function returning whether the coroutine can continue without suspending, which is the case if the future is fulfilled.
+				bool await_ready() const;
+				// A function responsible of resuming the suspended coroutine once the future is ready. Returns false if the coroutine should continue at once.
+				bool await_suspend( std::coroutine_handle<> handle ) const;
+				// A function returning a copy of the result of the future.
+				Type await_resume() const;
+		};
+
+		template <>
+		class TaskFutureAwaiter<void> : public TaskFutureAwaiterBase
+		{
+			private:
+
+				// The future that is awaited.
+				TaskFuture<void> m_future;
+
+
+			public:
+
+				// The constructor of the class.
+				explicit TaskFutureAwaiter( const TaskFuture<void>& future );
+
+
+				// A function returning whether the coroutine can continue without suspending, which is the case if the future is fulfilled.
+				bool await_ready() const;
+				// A function responsible of resuming the suspended coroutine once the future is ready. Returns false if the coroutine should continue at once.
+				bool await_suspend( std::coroutine_handle<> handle ) const;
+				// A function that is called when the coroutine continues, since the future has no result.
+				void await_resume() const;
+		};
+
+
+		/*
+			A class representing the promise of a coroutine that returns a future. The coroutine starts on a thread of the pool
+			and its result fulfils the future once it returns. If the frame of the coroutine cannot be allocated, an invalid future is returned.
+		*/
+		template <typename Type>
+		class TaskPromiseBase
+		{
+			private:
+
+				// The copy constructor is not available.
+				TaskPromiseBase( const TaskPromiseBase& );
+				// The assignment operator is not available.
+				TaskPromiseBase& operator=( const TaskPromiseBase& );
+
+
+			protected:
+
+				// The state the result of the coroutine is stored in.
+				TaskState<Type>* m_state;
+
+
+			public:
+
+				// The allocation function of the coroutine frames, which does not throw.
+				static void* operator new( std::size_t size ) noexcept;
+				// The deallocation function of the coroutine frames.
+				static void operator delete( void* pointer );
+				// A function returning the future that is returned when the frame of the coroutine could not be allocated.
+				static TaskFuture<Type> get_return_object_on_allocation_failure();
+
+
+				// The constructor of the class.
+				TaskPromiseBase();
+				// The destructor of the class. The result is abandoned if the coroutine did not return.
+				~TaskPromiseBase();
+
+
+				// A function returning the future of the result of the coroutine.
+				TaskFuture<Type> get_return_object() const;
+				// A function returning the awaiter that moves the coroutine to a thread of the pool before it starts.
+				TaskScheduleAwaiter initial_suspend() const;
+				// A function returning the awaiter of the end of the coroutine, which lets the frame be destroyed at once.
+				std::suspend_never final_suspend() const noexcept;
+				// A function that is called if an exception escapes the coroutine, which the engine does not support.
+				void unhandled_exception() const;
+		};
+
+		// A class representing the promise of a coroutine that returns a future of a result.
+		template <typename Type>
+		class TaskPromise : public TaskPromiseBase<Type>
+		{
+			public:
+
+				// A function responsible of fulfilling the future with the result of the coroutine.
+				template <typename Value>
+				void return_value( Value&& value );
+		};
+
+		// A class representing the promise of a coroutine that returns a future without a result.
+		template <>
+		class TaskPromise<void> : public TaskPromiseBase<void>
+		{
+			public:
+
+				// A function responsible of fulfilling the future once the coroutine returns.
+				void return_void();
+		};
+
+
+		// A function returning the awaiter of the given future, which lets a coroutine co_await a future.
+		template <typename Type>
+		TaskFutureAwaiter<Type> operator co_await( const TaskFuture<Type>& future );
+		/*
+			A function returning an awaiter that suspends the coroutine and queues it to the thread pool again,
+			which lets a long coroutine give way to the tasks that have been queued before it.
+		*/
+		TaskScheduleAwaiter resume_on_pool();
+
+	} /* core */
+
+} /* athena */
+
+
+
+namespace std
+{
+
+	// The traits that let any function returning a future be a coroutine.
+	template <typename Type , typename... Arguments>
+	struct coroutine_traits<athena::core::TaskFuture<Type>,Arguments...>
+	{
+		typedef athena::core::TaskPromise<Type> promise_type;
+	};
+
+} /* std */
+
+
+#include "taskCoroutine.inl"
+
+
+
+#endif /* ATHENA_CORE_TASKCOROUTINE_HPP */
\ No newline at end of file
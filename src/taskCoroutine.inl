@@ -0,0 +1,322 @@
+#ifndef ATHENA_CORE_TASKCOROUTINE_INL
+#define ATHENA_CORE_TASKCOROUTINE_INL
+
+#ifndef ATHENA_CORE_TASKCOROUTINE_HPP
+	#error "taskCoroutine.hpp must be included before taskCoroutine.inl"
+#endif /* ATHENA_CORE_TASKCOROUTINE_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the class.
+		inline TaskResumption::TaskResumption( std::coroutine_handle<> handle , const TaskFutureBase& future ) :
+			m_handle(handle) ,
+			m_future(future)
+		{
+		}
+
+		// The move constructor of the class.
+		inline TaskResumption::TaskResumption( TaskResumption&& resumption ) :
+			m_handle(resumption.m_handle) ,
+			m_future(std::move(resumption.m_future))
+		{
+			resumption.m_handle = nullptr;
+		}
+
+		// The destructor of the class. A coroutine that has not been resumed is destroyed.
+		inline TaskResumption::~TaskResumption()
+		{
+			if ( m_handle )
+				m_handle.destroy();
+		}
+
+
+		// A function responsible of giving up the coroutine without resuming or destroying it, and returning it.
+		inline std::coroutine_handle<> TaskResumption::release()
+		{
+			std::coroutine_handle<> return_value = m_handle;
+
+
+			m_handle = nullptr;
+
+
+			return return_value;
+		}
+
+
+		// The function call operator, which resumes the coroutine, or destroys it if the future it awaits has been abandoned.
+		inline void TaskResumption::operator()()
+		{
+			std::coroutine_handle<> handle = release();
+
+
+			if ( m_future.abandoned() )
+				handle.destroy();
+			else
+				handle.resume();
+		}
+
+
+		// A function returning whether the coroutine can continue without suspending, which is never the case.
+		inline bool TaskScheduleAwaiter::await_ready() const
+		{
+			return false;
+		}
+
+		// A function responsible of queuing the suspended coroutine to the thread pool. Returns false if the coroutine should continue at once.
+		inline bool TaskScheduleAwaiter::await_suspend( std::coroutine_handle<> handle ) const
+		{
+			ThreadPool* thread_pool = ThreadPool::get();
+			ThreadTask* task = new (std::nothrow) ThreadTask();
+			TaskResumption resumption(handle,TaskFutureBase());
+			bool return_value = false;
+
+
+			if ( thread_pool != NULL  &&  task != NULL  &&  task->callable(std::move(resumption)) )
+			{
+				// A task that cannot be queued is performed at once, the same way the continuations of a future are.
+				if ( !thread_pool->queue_task(task) )
+				{
+					task->perform();
+					delete task;
+				}
+
+				return_value = true;
+			}
+			else
+			{
+				delete task;
+				resumption.release();
+			}
+
+
+			return return_value;
+		}
+
+		// A function that is called when the coroutine continues.
+		inline void TaskScheduleAwaiter::await_resume() const
+		{
+		}
+
+
+		// A function returning whether a coroutine awaiting the given future can continue without suspending, which is the case if the future is fulfilled.
+		inline bool TaskFutureAwaiterBase::ready( const TaskFutureBase& future )
+		{
+			return ( future.ready()  &&  !future.abandoned() );
+		}
+
+		/*
+			A function responsible of resuming the given suspended coroutine once the given future is ready.
+			Returns false if the coroutine should continue at once.
+		*/
+		inline bool TaskFutureAwaiterBase::suspend( std::coroutine_handle<> handle , const TaskFutureBase& future )
+		{
+			// The future is copied, since the awaiter is destroyed along with the coroutine once the coroutine is resumed on another thread.
+			TaskFutureBase awaited_future(future);
+			ThreadTask* task = new (std::nothrow) ThreadTask();
+			TaskResumption resumption(handle,awaited_future);
+			bool return_value = true;
+
+
+			if ( awaited_future.valid()  &&  task != NULL  &&  task->callable(std::move(resumption)) )
+				awaited_future.attach(task);
+			else
+			{
+				delete task;
+
+				// If the resumption could not be allocated, block until the future is ready instead.
+				if ( awaited_future.valid() )
+				{
+					awaited_future.wait();
+
+					if ( !awaited_future.abandoned() )
+					{
+						resumption.release();
+						return_value = false;
+					}
+				}
+			}
+
+
+			return return_value;
+		}
+
+
+		// The constructor of the class.
+		template <typename Type>
+		TaskFutureAwaiter<Type>::TaskFutureAwaiter( const TaskFuture<Type>& future ) :
+			m_future(future)
+		{
+		}
+
+
+		// A function returning whether the coroutine can continue without suspending, which is the case if the future is fulfilled.
+		template <typename Type>
+		bool TaskFutureAwaiter<Type>::await_ready() const
+		{
+			return ready(m_future);
+		}
+
+		// A function responsible of resuming the suspended coroutine once the future is ready. Returns false if the coroutine should continue at once.
+		template <typename Type>
+		bool TaskFutureAwaiter<Type>::await_suspend( std::coroutine_handle<> handle ) const
+		{
+			return suspend(handle,m_future);
+		}
+
+		// A function returning a copy of the result of the future.
+		template <typename Type>
+		Type TaskFutureAwaiter<Type>::await_resume() const
+		{
+			Type return_value;
+
+
+			m_future.get(return_value);
+
+
+			return return_value;
+		}
+
+
+		// The constructor of the class.
+		inline TaskFutureAwaiter<void>::TaskFutureAwaiter( const TaskFuture<void>& future ) :
+			m_future(future)
+		{
+		}
+
+
+		// A function returning whether the coroutine can continue without suspending, which is the case if the future is fulfilled.
+		inline bool TaskFutureAwaiter<void>::await_ready() const
+		{
+			return ready(m_future);
+		}
+
+		// A function responsible of resuming the suspended coroutine once the future is ready. Returns false if the coroutine should continue at once.
+		inline bool TaskFutureAwaiter<void>::await_suspend( std::coroutine_handle<> handle ) const
+		{
+			return suspend(handle,m_future);
+		}
+
+		// A function that is called when the coroutine continues, since the future has no result.
+		inline void TaskFutureAwaiter<void>::await_resume() const
+		{
+		}
+
+
+		// The allocation function of the coroutine frames, which does not throw.
+		template <typename Type>
+		void* TaskPromiseBase<Type>::operator new( std::size_t size ) noexcept
+		{
+			return ::operator new(size,std::nothrow);
+		}
+
+		// The deallocation function of the coroutine frames.
+		template <typename Type>
+		void TaskPromiseBase<Type>::operator delete( void* pointer )
+		{
+			::operator delete(pointer);
+		}
+
+		// A function returning the future that is returned when the frame of the coroutine could not be allocated.
+		template <typename Type>
+		TaskFuture<Type> TaskPromiseBase<Type>::get_return_object_on_allocation_failure()
+		{
+			return TaskFuture<Type>();
+		}
+
+
+		// The constructor of the class.
+		template <typename Type>
+		TaskPromiseBase<Type>::TaskPromiseBase() :
+			m_state(new (std::nothrow) TaskState<Type>())
+		{
+			if ( m_state != NULL )
+				m_state->acquire();
+		}
+
+		// The destructor of the class. The result is abandoned if the coroutine did not return.
+		template <typename Type>
+		TaskPromiseBase<Type>::~TaskPromiseBase()
+		{
+			if ( m_state != NULL )
+			{
+				m_state->abandon();
+				m_state->release();
+			}
+		}
+
+
+		// A function returning the future of the result of the coroutine.
+		template <typename Type>
+		TaskFuture<Type> TaskPromiseBase<Type>::get_return_object() const
+		{
+			return TaskFuture<Type>(m_state);
+		}
+
+		// A function returning the awaiter that moves the coroutine to a thread of the pool before it starts.
+		template <typename Type>
+		TaskScheduleAwaiter TaskPromiseBase<Type>::initial_suspend() const
+		{
+			return TaskScheduleAwaiter();
+		}
+
+		// A function returning the awaiter of the end of the coroutine, which lets the frame be destroyed at once.
+		template <typename Type>
+		std::suspend_never TaskPromiseBase<Type>::final_suspend() const noexcept
+		{
+			return std::suspend_never();
+		}
+
+		// A function that is called if an exception escapes the coroutine, which the engine does not support.
+		template <typename Type>
+		void TaskPromiseBase<Type>::unhandled_exception() const
+		{
+			std::terminate();
+		}
+
+
+		// A function responsible of fulfilling the future with the result of the coroutine.
+		template <typename Type>
+		template <typename Value>
+		void TaskPromise<Type>::return_value( Value&& value )
+		{
+			if ( this->m_state != NULL )
+				this->m_state->fulfil(std::forward<Value>(value));
+		}
+
+		// A function responsible of fulfilling the future once the coroutine returns.
+		inline void TaskPromise<void>::return_void()
+		{
+			if ( m_state != NULL )
+				m_state->fulfil();
+		}
+
+
+		// A function returning the awaiter of the given future, which lets a coroutine co_await a future.
+		template <typename Type>
+		TaskFutureAwaiter<Type> operator co_await( const TaskFuture<Type>& future )
+		{
+			return TaskFutureAwaiter<Type>(future);
+		}
+
+		/*
+			A function returning an awaiter that suspends the coroutine and queues it to the thread pool again,
+			which lets a long coroutine give way to the tasks that have been queued before it.
+		*/
+		inline TaskScheduleAwaiter resume_on_pool()
+		{
+			return TaskScheduleAwaiter();
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_TASKCOROUTINE_INL */
\ No newline at end of file
@@ -0,0 +1,175 @@
+#include "taskDeque.hpp"
+#include <new>
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of allocating an array of the given capacity. Returns NULL if the allocation fails.
+		TaskDeque::TaskArray* TaskDeque::allocate_array( const size_t capacity , TaskArray* previous )
+		{
+			TaskArray* return_value = new (std::nothrow) TaskArray;
+
+
+			if ( return_value != NULL )
+			{
+				return_value->m_capacity = capacity;
+				return_value->m_tasks = new (std::nothrow) std::atomic<ThreadTask*>[capacity];
+				return_value->m_previous = previous;
+
+				if ( return_value->m_tasks != NULL )
+				{
+					for ( size_t i = 0;  i < capacity;  ++i )
+						return_value->m_tasks[i].store(NULL,std::memory_order_relaxed);
+				}
+				else
+				{
+					delete return_value;
+					return_value = NULL;
+				}
+			}
+
+
+			return return_value;
+		}
+
+
+		// The constructor of the class.
+		TaskDeque::TaskDeque() :
+			m_array(allocate_array(s_INITIAL_CAPACITY,NULL)) ,
+			m_top(0) ,
+			m_bottom(0)
+		{
+		}
+
+		// The destructor of the class. The queued tasks are not deallocated.
+		TaskDeque::~TaskDeque()
+		{
+			TaskArray* array = m_array.load(std::memory_order_relaxed);
+
+
+			while ( array != NULL )
+			{
+				TaskArray* previous = array->m_previous;
+
+
+				delete[] array->m_tasks;
+				delete array;
+				array = previous;
+			}
+		}
+
+
+		/*
+			A function responsible of pushing a task to the bottom of the deque. Must only be called by the owner thread.
+			Returns false if the deque is full and could not grow.
+		*/
+		bool TaskDeque::push( ThreadTask* task )
+		{
+			long long bottom = m_bottom.load(std::memory_order_relaxed);
+			long long top = m_top.load(std::memory_order_acquire);
+			TaskArray* array = m_array.load(std::memory_order_relaxed);
+			bool return_value = false;
+
+
+			// If the array is full, copy the queued tasks to an array of double the capacity.
+			if ( array != NULL  &&  bottom - top >= static_cast<long long>(array->m_capacity) )
+			{
+				TaskArray* new_array = allocate_array(array->m_capacity * 2,array);
+
+
+				if ( new_array != NULL )
+				{
+					for ( long long i = top;  i < bottom;  ++i )
+						put(new_array,i,get(array,i));
+
+					m_array.store(new_array,std::memory_order_release);
+				}
+
+				array = new_array;
+			}
+
+			if ( array != NULL )
+			{
+				put(array,bottom,task);
+				// The task has to be visible before the thieves can see the new bottom.
+				std::atomic_thread_fence(std::memory_order_release);
+				m_bottom.store(bottom + 1,std::memory_order_relaxed);
+				return_value = true;
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of popping the most recently pushed task. Must only be called by the owner thread. Returns NULL if the deque is empty.
+		ThreadTask* TaskDeque::pop()
+		{
+			long long bottom = m_bottom.load(std::memory_order_relaxed) - 1;
+			TaskArray* array = m_array.load(std::memory_order_relaxed);
+			long long top = 0;
+			ThreadTask* return_value = NULL;
+
+
+			// Claim the bottom task before looking at the top, so that a thief cannot take it unnoticed.
+			m_bottom.store(bottom,std::memory_order_relaxed);
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			top = m_top.load(std::memory_order_relaxed);
+
+			if ( top <= bottom )
+			{
+				return_value = get(array,bottom);
+
+				// If this is the last task, race the thieves for it.
+				if ( top == bottom )
+				{
+					if ( !m_top.compare_exchange_strong(top,top + 1,std::memory_order_seq_cst,std::memory_order_relaxed) )
+						return_value = NULL;
+
+					m_bottom.store(bottom + 1,std::memory_order_relaxed);
+				}
+			}
+			else
+				m_bottom.store(bottom + 1,std::memory_order_relaxed);
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of stealing the least recently pushed task. May be called by any thread.
+			Returns NULL if the deque is empty or another thread took the task first.
+		*/
+		ThreadTask* TaskDeque::steal()
+		{
+			long long top = m_top.load(std::memory_order_acquire);
+			long long bottom = 0;
+			ThreadTask* return_value = NULL;
+
+
+			std::atomic_thread_fence(std::memory_order_seq_cst);
+			bottom = m_bottom.load(std::memory_order_acquire);
+
+			if ( top < bottom )
+			{
+				TaskArray* array = m_array.load(std::memory_order_acquire);
+
+
+				return_value = get(array,top);
+
+				// Another thief or the owner may have taken the task in the meantime.
+				if ( !m_top.compare_exchange_strong(top,top + 1,std::memory_order_seq_cst,std::memory_order_relaxed) )
+					return_value = NULL;
+			}
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
@@ -0,0 +1,112 @@
+#ifndef ATHENA_CORE_TASKDEQUE_HPP
+#define ATHENA_CORE_TASKDEQUE_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <atomic>
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		class ThreadTask;
+
+
+		/*
+			A lock-free work-stealing deque (Chase-Lev) that is used by every thread of the thread pool.
+			The owner thread pushes and pops tasks at the bottom of the deque in LIFO order, while any other
+			thread may steal tasks from the top of the deque in FIFO order. The owner and the thieves
+			only contend when the deque holds a single task.
+			The deque is a circular array that is doubled when it is full. The arrays that have been
+			replaced are kept until the deque is destroyed, since a thief may still be reading them.
+		*/
+		class TaskDeque
+		{
+			private:
+
+				// A struct representing a circular array of tasks.
+				struct TaskArray
+				{
+					// The capacity of the array. Always a power of two (2).
+					size_t m_capacity;
+					// The tasks of the array.
+					std::atomic<ThreadTask*>* m_tasks;
+					// The array this array replaced.
+					TaskArray* m_previous;
+				};
+
+
+				// The assumed size of a cache line, used to keep the owner and thief counters apart.
+				static const size_t s_CACHE_LINE_SIZE = 64;
+				// The initial capacity of the deque.
+				static const size_t s_INITIAL_CAPACITY = 256;
+
+
+				// The array holding the tasks.
+				std::atomic<TaskArray*> m_array;
+				// Padding that separates the thief counter from the read-mostly members.
+				char m_top_padding[s_CACHE_LINE_SIZE];
+				// The position tasks are stolen from.
+				std::atomic<long long> m_top;
+				// Padding that separates the thief counter from the owner counter.
+				char m_bottom_padding[s_CACHE_LINE_SIZE];
+				// The position tasks are pushed to and popped from by the owner.
+				std::atomic<long long> m_bottom;
+
+
+				// The copy constructor is not available.
+				TaskDeque( const TaskDeque& );
+				// The assignment operator is not available.
+				TaskDeque& operator=( const TaskDeque& );
+
+
+				// A function responsible of allocating an array of the given capacity. Returns NULL if the allocation fails.
+				static TaskArray* allocate_array( const size_t capacity , TaskArray* previous );
+				// A function responsible of reading the task at the given position of an array.
+				static ThreadTask* get( const TaskArray* array , const long long position );
+				// A function responsible of writing the task at the given position of an array.
+				static void put( TaskArray* array , const long long position , ThreadTask* task );
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL TaskDeque();
+				// The destructor of the class. The queued tasks are not deallocated.
+				ATHENA_DLL ~TaskDeque();
+
+
+				/*
+					A function responsible of pushing a task to the bottom of the deque. Must only be called by the owner thread.
+					Returns false if the deque is full and could not grow.
+				*/
+				ATHENA_DLL bool push( ThreadTask* task );
+				// A function responsible of popping the most recently pushed task. Must only be called by the owner thread. Returns NULL if the deque is empty.
+				ATHENA_DLL ThreadTask* pop();
+				/*
+					A function responsible of stealing the least recently pushed task. May be called by any thread.
+					Returns NULL if the deque is empty or another thread took the task first.
+				*/
+				ATHENA_DLL ThreadTask* steal();
+
+
+				// A function returning the approximate amount of queued tasks.
+				ATHENA_DLL size_t size() const;
+				// A function returning whether the deque is (approximately) empty.
+				ATHENA_DLL bool empty() const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "taskDeque.inl"
+
+
+
+#endif /* ATHENA_CORE_TASKDEQUE_HPP */
\ No newline at end of file
@@ -0,0 +1,51 @@
+#ifndef ATHENA_CORE_TASKDEQUE_INL
+#define ATHENA_CORE_TASKDEQUE_INL
+
+#ifndef ATHENA_CORE_TASKDEQUE_HPP
+	#error "taskDeque.hpp must be included before taskDeque.inl"
+#endif /* ATHENA_CORE_TASKDEQUE_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of reading the task at the given position of an array.
+		inline ThreadTask* TaskDeque::get( const TaskArray* array , const long long position )
+		{
+			return array->m_tasks[static_cast<size_t>(position) & ( array->m_capacity - 1 )].load(std::memory_order_relaxed);
+		}
+
+		// A function responsible of writing the task at the given position of an array.
+		inline void TaskDeque::put( TaskArray* array , const long long position , ThreadTask* task )
+		{
+			array->m_tasks[static_cast<size_t>(position) & ( array->m_capacity - 1 )].store(task,std::memory_order_relaxed);
+		}
+
+
+		// A function returning the approximate amount of queued tasks.
+		inline size_t TaskDeque::size() const
+		{
+			long long bottom = m_bottom.load(std::memory_order_relaxed);
+			long long top = m_top.load(std::memory_order_relaxed);
+
+
+			return ( bottom > top  ?  static_cast<size_t>(bottom - top) : 0 );
+		}
+
+		// A function returning whether the deque is (approximately) empty.
+		inline bool TaskDeque::empty() const
+		{
+			return ( size() == 0 );
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_TASKDEQUE_INL */
\ No newline at end of file
@@ -0,0 +1,240 @@
+#include "taskFileReader.hpp"
+#include <fstream>
+#include <utility>
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The function that is run by the service thread.
+		int TaskFileReader::thread_functionality( void* parameter )
+		{
+			TaskFileReader* reader = static_cast<TaskFileReader*>(parameter);
+
+
+			if ( reader != NULL )
+				reader->perform_reads();
+
+
+			return 0;
+		}
+
+		/*
+			A function responsible of reading the whole file at the given path into the given string.
+			Files whose size is not known, such as pipes, are read in chunks until their end. Returns false if the file could not be read.
+		*/
+		bool TaskFileReader::read_file( const std::string& path , std::string& contents )
+		{
+			std::ifstream file(path.c_str(),std::ios::in | std::ios::binary);
+			bool return_value = false;
+
+
+			if ( file.is_open() )
+			{
+				std::streamoff size = 0;
+
+
+				/*
+					Reserve the whole file at once, when its size is known. Pipes cannot seek and the files of /proc report no size,
+					so the failed seek is cleared and they are left to the chunked reads, as are directories, which report sizes no string can hold.
+				*/
+				file.seekg(0,std::ios::end);
+				size = file.tellg();
+				file.clear();
+				file.seekg(0,std::ios::beg);
+				file.clear();
+
+				contents.clear();
+
+				if ( size > 0  &&  static_cast<unsigned long long>(size) < contents.max_size() )
+				{
+					contents.resize(static_cast<size_t>(size));
+					file.read(&contents[0],size);
+					contents.resize(static_cast<size_t>(file.gcount()));
+				}
+
+				// Read in chunks until the end of the file, which also covers a file that has grown since its size was taken.
+				while ( file.good() )
+				{
+					size_t offset = contents.size();
+
+
+					contents.resize(offset + s_CHUNK_SIZE);
+					file.read(&contents[offset],s_CHUNK_SIZE);
+					contents.resize(offset + static_cast<size_t>(file.gcount()));
+				}
+
+				// Only reaching the end of the file counts as success, so that a stream error abandons the future.
+				return_value = ( file.eof()  &&  !file.bad() );
+				file.close();
+			}
+
+
+			return return_value;
+		}
+
+
+		// A function responsible of performing the requested reads until the reader is terminated.
+		void TaskFileReader::perform_reads()
+		{
+			m_lock.lock();
+
+			while ( m_run )
+			{
+				if ( m_requests.size() == 0 )
+					m_condition_variable.wait(m_lock);
+				else
+				{
+					Request request = m_requests.front();
+					std::string contents;
+
+
+					m_requests.pop_front();
+
+					// The file is read without holding the lock, so that reads can be requested in the meantime.
+					m_lock.unlock();
+
+					if ( read_file(request.m_path,contents) )
+						request.m_state->fulfil(std::move(contents));
+					else
+						request.m_state->abandon();
+
+					request.m_state->release();
+					m_lock.lock();
+				}
+			}
+
+			m_lock.unlock();
+		}
+
+
+		// The constructor of the class.
+		TaskFileReader::TaskFileReader() :
+			m_requests() ,
+			m_lock() ,
+			m_condition_variable() ,
+			m_thread() ,
+			m_run(false)
+		{
+		}
+
+		// The destructor of the class.
+		TaskFileReader::~TaskFileReader()
+		{
+			terminate();
+		}
+
+
+		// A function responsible of starting the service thread of the reader. Returns false if the thread could not be spawned.
+		bool TaskFileReader::startup( const std::string& name )
+		{
+			bool return_value = true;
+
+
+			m_lock.lock();
+
+			if ( !m_run )
+			{
+				m_run = true;
+				return_value = m_thread.start(name,thread_functionality,static_cast<void*>(this));
+
+				if ( !return_value )
+					m_run = false;
+			}
+
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		// A function responsible of stopping the service thread of the reader. The futures of the reads that have not been performed are abandoned.
+		void TaskFileReader::terminate()
+		{
+			std::deque<Request> requests;
+
+
+			m_lock.lock();
+			m_run = false;
+			m_requests.swap(requests);
+			m_condition_variable.notify_all();
+			m_lock.unlock();
+
+			m_thread.join();
+
+			// For every read that has not been performed.
+			for (
+					std::deque<Request>::iterator request_iterator = requests.begin();
+					request_iterator != requests.end();
+					++request_iterator
+				)
+			{
+				request_iterator->m_state->abandon();
+				request_iterator->m_state->release();
+			}
+		}
+
+
+		/*
+			A function responsible of requesting the whole file at the given path to be read, and returning a future of its contents.
+			The future is abandoned if the reader is not operational or the file could not be read.
+		*/
+		TaskFuture<std::string> TaskFileReader::read( const std::string& path )
+		{
+			TaskState<std::string>* state = new (std::nothrow) TaskState<std::string>();
+			TaskFuture<std::string> return_value;
+
+
+			if ( state != NULL )
+			{
+				bool requested = false;
+
+
+				return_value = TaskFuture<std::string>(state);
+				m_lock.lock();
+
+				if ( m_run )
+				{
+					Request request;
+
+
+					request.m_path = path;
+					request.m_state = state;
+					m_requests.push_back(request);
+					state->acquire();
+					requested = true;
+					m_condition_variable.notify_one();
+				}
+
+				m_lock.unlock();
+
+				if ( !requested )
+					state->abandon();
+			}
+
+
+			return return_value;
+		}
+
+
+		// A function returning the amount of reads that have been requested and not yet performed.
+		size_t TaskFileReader::size()
+		{
+			size_t return_value = 0;
+
+
+			m_lock.lock();
+			return_value = m_requests.size();
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
@@ -0,0 +1,106 @@
+#ifndef ATHENA_CORE_TASKFILEREADER_HPP
+#define ATHENA_CORE_TASKFILEREADER_HPP
+
+#include "definitions.hpp"
+#include <string>
+#include <deque>
+#include <mutex>
+#include <condition_variable>
+#include "taskFuture.hpp"
+#include "serviceThread.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A class representing a reader that reads whole files on a service thread and fulfils a future with the contents of each file.
+			The files are read in the order they were requested, so a job that needs the contents of a file awaits
+			its future instead of blocking a thread of the pool on the disk.
+			The continuations of a future that is fulfilled by the reader are queued to the thread pool.
+		*/
+		class TaskFileReader
+		{
+			private:
+
+				// A struct holding a requested read.
+				struct Request
+				{
+					// The path of the file.
+					std::string m_path;
+					// The state that is fulfilled with the contents of the file.
+					TaskState<std::string>* m_state;
+				};
+
+
+				// The amount of bytes that are read at once from a file whose size is not known.
+				static const size_t s_CHUNK_SIZE = 65536;
+
+
+				// The reads that have been requested and not yet performed.
+				std::deque<Request> m_requests;
+				// A lock that is used to handle concurrency issues.
+				std::mutex m_lock;
+				// The condition variable that the service thread waits on until a read is requested.
+				std::condition_variable_any m_condition_variable;
+				// The service thread that performs the reads.
+				ServiceThread m_thread;
+				// A variable holding whether the reader is operational.
+				bool m_run;
+
+
+				// The copy constructor is not available.
+				TaskFileReader( const TaskFileReader& );
+				// The assignment operator is not available.
+				TaskFileReader& operator=( const TaskFileReader& );
+
+
+				// The function that is run by the service thread.
+				static int thread_functionality( void* parameter );
+				/*
+					A function responsible of reading the whole file at the given path into the given string.
+					Files whose size is not known, such as pipes, are read in chunks until their end. Returns false if the file could not be read.
+				*/
+				static bool read_file( const std::string& path , std::string& contents );
+
+
+				// A function responsible of performing the requested reads until the reader is terminated.
+				void perform_reads();
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL TaskFileReader();
+				// The destructor of the class.
+				ATHENA_DLL ~TaskFileReader();
+
+
+				// A function responsible of starting the service thread of the reader. Returns false if the thread could not be spawned.
+				ATHENA_DLL bool startup( const std::string& name );
+				// A function responsible of stopping the service thread of the reader. The futures of the reads that have not been performed are abandoned.
+				ATHENA_DLL void terminate();
+
+
+				/*
+					A function responsible of requesting the whole file at the given path to be read, and returning a future of its contents.
+					The future is abandoned if the reader is not operational or the file could not be read.
+				*/
+				ATHENA_DLL TaskFuture<std::string> read( const std::string& path );
+
+
+				// A function returning the amount of reads that have been requested and not yet performed.
+				ATHENA_DLL size_t size();
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_TASKFILEREADER_HPP */
\ No newline at end of file
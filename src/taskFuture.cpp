@@ -0,0 +1,390 @@
+#include "taskFuture.hpp"
+#include <chrono>
+#include "threadPool.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of queuing a continuation to the thread pool, or performing it if it cannot be queued.
+		void TaskStateBase::queue_continuation( ThreadTask* task )
+		{
+			ThreadPool* thread_pool = ThreadPool::get();
+
+
+			if ( thread_pool == NULL  ||  !thread_pool->queue_task(task) )
+			{
+				task->perform();
+				delete task;
+			}
+		}
+
+
+		// The constructor of the class.
+		TaskStateBase::TaskStateBase() :
+			m_lock() ,
+			m_condition_variable() ,
+			m_continuations(NULL) ,
+			m_references(0) ,
+			m_status(PendingTask)
+		{
+		}
+
+		// The destructor of the class.
+		TaskStateBase::~TaskStateBase()
+		{
+			// Deallocate any continuation that has not been queued.
+			while ( m_continuations != NULL )
+			{
+				ThreadTask* task = m_continuations;
+
+
+				m_continuations = task->next();
+				delete task;
+			}
+		}
+
+
+		/*
+			A function responsible of setting the final status of the result, waking up the waiting threads and queuing the continuations.
+			Returns false if the result was already ready.
+		*/
+		bool TaskStateBase::complete( const TaskStatus status )
+		{
+			ThreadTask* continuations = NULL;
+			bool return_value = false;
+
+
+			m_lock.lock();
+
+			if ( m_status.load(std::memory_order_relaxed) == PendingTask )
+			{
+				m_status.store(status,std::memory_order_release);
+				continuations = m_continuations;
+				m_continuations = NULL;
+				return_value = true;
+			}
+
+			m_lock.unlock();
+
+			if ( return_value )
+			{
+				m_condition_variable.notify_all();
+
+				// Queue the continuations. A continuation may release the last reference to the state, so the state is not accessed afterwards.
+				while ( continuations != NULL )
+				{
+					ThreadTask* task = continuations;
+
+
+					continuations = task->next();
+					task->next(NULL);
+					queue_continuation(task);
+				}
+			}
+
+
+			return return_value;
+		}
+
+
+		// A function responsible of acquiring a reference to the state.
+		void TaskStateBase::acquire()
+		{
+			m_references.fetch_add(1,std::memory_order_relaxed);
+		}
+
+		// A function responsible of releasing a reference to the state. The state is deallocated when the last reference is released.
+		void TaskStateBase::release()
+		{
+			if ( m_references.fetch_sub(1,std::memory_order_acq_rel) == 1 )
+				delete this;
+		}
+
+		// A function responsible of abandoning the result, unless it is already ready.
+		void TaskStateBase::abandon()
+		{
+			if ( m_status.load(std::memory_order_acquire) == PendingTask )
+				complete(AbandonedTask);
+		}
+
+		// A function responsible of queuing the given task once the result is ready. The task is queued at once if the result is already ready.
+		void TaskStateBase::attach( ThreadTask* task )
+		{
+			bool ready = false;
+
+
+			m_lock.lock();
+
+			if ( m_status.load(std::memory_order_relaxed) == PendingTask )
+			{
+				task->next(m_continuations);
+				m_continuations = task;
+			}
+			else
+				ready = true;
+
+			m_lock.unlock();
+
+			if ( ready )
+				queue_continuation(task);
+		}
+
+		/*
+			A function responsible of blocking until the result is ready. While waiting, a thread of the pool performs
+			the queued tasks of the pool, so that waiting on a thread of the pool cannot starve the pool.
+		*/
+		void TaskStateBase::wait()
+		{
+			ThreadPool* thread_pool = ThreadPool::get();
+
+
+			while ( m_status.load(std::memory_order_acquire) == PendingTask )
+			{
+				// If there is no task to perform, block for a while before looking for tasks again.
+				if ( thread_pool == NULL  ||  !thread_pool->perform_task() )
+				{
+					m_lock.lock();
+
+					if ( m_status.load(std::memory_order_relaxed) == PendingTask )
+						m_condition_variable.wait_for(m_lock,std::chrono::milliseconds(1));
+
+					m_lock.unlock();
+				}
+			}
+		}
+
+
+		// A function returning the status of the result.
+		TaskStatus TaskStateBase::status() const
+		{
+			return static_cast<TaskStatus>(m_status.load(std::memory_order_acquire));
+		}
+
+
+		// The constructor of the class.
+		TaskGroupState::TaskGroupState() :
+			TaskState<void>() ,
+			m_remaining(1) ,
+			m_failed(false)
+		{
+		}
+
+
+		// A function responsible of adding a future to the group.
+		void TaskGroupState::add()
+		{
+			m_remaining.fetch_add(1,std::memory_order_relaxed);
+		}
+
+		// A function responsible of marking that a future of the group could not be waited on, which abandons the group.
+		void TaskGroupState::fail()
+		{
+			m_failed.store(true,std::memory_order_relaxed);
+		}
+
+		// A function responsible of marking a future of the group as ready. The state is completed once every future is ready.
+		void TaskGroupState::arrive()
+		{
+			if ( m_remaining.fetch_sub(1,std::memory_order_acq_rel) == 1 )
+			{
+				if ( m_failed.load(std::memory_order_relaxed) )
+					abandon();
+				else
+					fulfil();
+			}
+		}
+
+
+		// The constructor of the class.
+		TaskChoiceState::TaskChoiceState() :
+			TaskState<size_t>() ,
+			m_chosen(false)
+		{
+		}
+
+
+		// A function responsible of choosing the future at the given index, unless another future has been chosen.
+		void TaskChoiceState::choose( const size_t index )
+		{
+			if ( !m_chosen.exchange(true,std::memory_order_acq_rel) )
+				fulfil(index);
+		}
+
+
+		// The constructor of the class.
+		TaskGroupArrival::TaskGroupArrival( TaskGroupState* state ) :
+			m_state(state)
+		{
+			m_state->acquire();
+		}
+
+		// The copy constructor of the class.
+		TaskGroupArrival::TaskGroupArrival( const TaskGroupArrival& arrival ) :
+			m_state(arrival.m_state)
+		{
+			m_state->acquire();
+		}
+
+		// The destructor of the class.
+		TaskGroupArrival::~TaskGroupArrival()
+		{
+			m_state->release();
+		}
+
+
+		// The function call operator, which marks the future as ready.
+		void TaskGroupArrival::operator()()
+		{
+			m_state->arrive();
+		}
+
+
+		// The constructor of the class.
+		TaskChoiceArrival::TaskChoiceArrival( TaskChoiceState* state , const size_t index ) :
+			m_state(state) ,
+			m_index(index)
+		{
+			m_state->acquire();
+		}
+
+		// The copy constructor of the class.
+		TaskChoiceArrival::TaskChoiceArrival( const TaskChoiceArrival& arrival ) :
+			m_state(arrival.m_state) ,
+			m_index(arrival.m_index)
+		{
+			m_state->acquire();
+		}
+
+		// The destructor of the class.
+		TaskChoiceArrival::~TaskChoiceArrival()
+		{
+			m_state->release();
+		}
+
+
+		// The function call operator, which chooses the future.
+		void TaskChoiceArrival::operator()()
+		{
+			m_state->choose(m_index);
+		}
+
+
+		// A constructor of the class that refers to the given state.
+		TaskFutureBase::TaskFutureBase( TaskStateBase* state ) :
+			m_state(state)
+		{
+			if ( m_state != NULL )
+				m_state->acquire();
+		}
+
+		// The default constructor of the class, which creates an invalid future.
+		TaskFutureBase::TaskFutureBase() :
+			m_state(NULL)
+		{
+		}
+
+		// The copy constructor of the class.
+		TaskFutureBase::TaskFutureBase( const TaskFutureBase& future ) :
+			m_state(future.m_state)
+		{
+			if ( m_state != NULL )
+				m_state->acquire();
+		}
+
+		// The move constructor of the class.
+		TaskFutureBase::TaskFutureBase( TaskFutureBase&& future ) :
+			m_state(future.m_state)
+		{
+			future.m_state = NULL;
+		}
+
+		// The destructor of the class.
+		TaskFutureBase::~TaskFutureBase()
+		{
+			if ( m_state != NULL )
+				m_state->release();
+		}
+
+
+		// The assignment operator.
+		TaskFutureBase& TaskFutureBase::operator=( const TaskFutureBase& future )
+		{
+			if ( this != &future )
+			{
+				if ( future.m_state != NULL )
+					future.m_state->acquire();
+
+				if ( m_state != NULL )
+					m_state->release();
+
+				m_state = future.m_state;
+			}
+
+			return *this;
+		}
+
+		// The move assignment operator.
+		TaskFutureBase& TaskFutureBase::operator=( TaskFutureBase&& future )
+		{
+			if ( this != &future )
+			{
+				if ( m_state != NULL )
+					m_state->release();
+
+				m_state = future.m_state;
+				future.m_state = NULL;
+			}
+
+			return *this;
+		}
+
+
+		/*
+			A function responsible of blocking until the result is ready. While waiting, a thread of the pool performs
+			the queued tasks of the pool. Returns immediately if the future is invalid.
+		*/
+		void TaskFutureBase::wait() const
+		{
+			if ( m_state != NULL )
+				m_state->wait();
+		}
+
+		/*
+			A function responsible of queuing the given task to the thread pool once the result is ready,
+			whether it is fulfilled or abandoned. The task is deallocated if the future is invalid.
+		*/
+		void TaskFutureBase::attach( ThreadTask* task ) const
+		{
+			if ( m_state != NULL )
+				m_state->attach(task);
+			else
+				delete task;
+		}
+
+
+		// A function returning whether the future refers to a result.
+		bool TaskFutureBase::valid() const
+		{
+			return ( m_state != NULL );
+		}
+
+		// A function returning whether the result is ready, either fulfilled or abandoned.
+		bool TaskFutureBase::ready() const
+		{
+			return ( m_state != NULL  &&  m_state->status() != PendingTask );
+		}
+
+		// A function returning whether the result has been abandoned, in which case it will never be available.
+		bool TaskFutureBase::abandoned() const
+		{
+			return ( m_state != NULL  &&  m_state->status() == AbandonedTask );
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
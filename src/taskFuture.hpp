@@ -0,0 +1,492 @@
+#ifndef ATHENA_CORE_TASKFUTURE_HPP
+#define ATHENA_CORE_TASKFUTURE_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <condition_variable>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "threadTask.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// An enumeration holding the possible states of the result of a task.
+		enum TaskStatus
+		{
+			PendingTask = 0 ,
+			FulfilledTask ,
+			AbandonedTask
+		};
+
+
+		/*
+			A class holding the state that is shared between a task and the futures of its result.
+			The state is reference counted and holds the tasks that are queued to the thread pool once the result is ready.
+			A result that will never be produced, because the task could not be queued or was discarded, is abandoned.
+		*/
+		class TaskStateBase
+		{
+			private:
+
+				// A lock that is used to handle concurrency issues.
+				std::mutex m_lock;
+				// The condition variable that the threads waiting for the result block on.
+				std::condition_variable_any m_condition_variable;
+				// The list of the tasks that are queued once the result is ready.
+				ThreadTask* m_continuations;
+				// The amount of references to the state.
+				std::atomic<unsigned int> m_references;
+				// The status of the result.
+				std::atomic<int> m_status;
+
+
+				// The copy constructor is not available.
+				TaskStateBase( const TaskStateBase& );
+				// The assignment operator is not available.
+				TaskStateBase& operator=( const TaskStateBase& );
+
+
+				// A function responsible of queuing a continuation to the thread pool, or performing it if it cannot be queued.
+				static void queue_continuation( ThreadTask* task );
+
+
+			protected:
+
+				// The constructor of the class.
+				ATHENA_DLL TaskStateBase();
+
+
+				/*
+					A function responsible of setting the final status of the result, waking up the waiting threads and queuing the continuations.
+					Returns false if the result was already ready.
+				*/
+				ATHENA_DLL bool complete( const TaskStatus status );
+
+
+			public:
+
+				// The destructor of the class.
+				ATHENA_DLL virtual ~TaskStateBase();
+
+
+				// A function responsible of acquiring a reference to the state.
+				ATHENA_DLL void acquire();
+				// A function responsible of releasing a reference to the state. The state is deallocated when the last reference is released.
+				ATHENA_DLL void release();
+				// A function responsible of abandoning the result, unless it is already ready.
+				ATHENA_DLL void abandon();
+				// A function responsible of queuing the given task once the result is ready. The task is queued at once if the result is already ready.
+				ATHENA_DLL void attach( ThreadTask* task );
+				/*
+					A function responsible of blocking until the result is ready. While waiting, a thread of the pool performs
+					the queued tasks of the pool, so that waiting on a thread of the pool cannot starve the pool.
+				*/
+				ATHENA_DLL void wait();
+
+
+				// A function returning the status of the result.
+				ATHENA_DLL TaskStatus status() const;
+		};
+
+
+		// A class holding the state that is shared between a task and the futures of its result.
+		template <typename Type>
+		class TaskState : public TaskStateBase
+		{
+			private:
+
+				// The storage of the result.
+				typename std::aligned_storage<sizeof(Type),std::alignment_of<Type>::value>::type m_value;
+
+
+			public:
+
+				// The constructor of the class.
+				TaskState();
+				// The destructor of the class.
+				~TaskState();
+
+
+				// A function responsible of storing the result and completing the state. Must only be called once.
+				template <typename Value>
+				void fulfil( Value&& value );
+
+
+				// A function returning the result. Must only be called once the result is fulfilled.
+				const Type& value() const;
+		};
+
+		// A class holding the state that is shared between a task without a result and its futures.
+		template <>
+		class TaskState<void> : public TaskStateBase
+		{
+			public:
+
+				// A function responsible of completing the state. Must only be called once.
+				void fulfil();
+		};
+
+
+		// A class holding the state of a future that is ready once every one of a group of futures is ready.
+		class TaskGroupState : public TaskState<void>
+		{
+			private:
+
+				// The amount of futures that are not ready yet, along with a reference that is held while the group is formed.
+				std::atomic<size_t> m_remaining;
+				// A variable holding whether a future of the group could not be waited on.
+				std::atomic<bool> m_failed;
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL TaskGroupState();
+
+
+				// A function responsible of adding a future to the group.
+				ATHENA_DLL void add();
+				// A function responsible of marking that a future of the group could not be waited on, which abandons the group.
+				ATHENA_DLL void fail();
+				// A function responsible of marking a future of the group as ready. The state is completed once every future is ready.
+				ATHENA_DLL void arrive();
+		};
+
+
+		// A class holding the state of a future that is ready once any one of a group of futures is ready.
+		class TaskChoiceState : public TaskState<size_t>
+		{
+			private:
+
+				// A variable holding whether a future of the group has been chosen.
+				std::atomic<bool> m_chosen;
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL TaskChoiceState();
+
+
+				// A function responsible of choosing the future at the given index, unless another future has been chosen.
+				ATHENA_DLL void choose( const size_t index );
+		};
+
+
+		// A struct responsible of calling a function and fulfilling a state with its result.
+		template <typename Result>
+		struct TaskResult
+		{
+			// A function responsible of calling the given function with the given arguments and fulfilling the state with the result.
+			template <typename Function , typename... Arguments>
+			static void fulfil( TaskState<Result>* state , Function& function , Arguments&&... arguments );
+		};
+
+		template <>
+		struct TaskResult<void>
+		{
+			// A function responsible of calling the given function with the given arguments and fulfilling the state.
+			template <typename Function , typename... Arguments>
+			static void fulfil( TaskState<void>* state , Function& function , Arguments&&... arguments );
+		};
+
+
+		// A struct defining the result of a continuation of a future of the given type.
+		template <typename Type , typename Function>
+		struct TaskContinuationResult
+		{
+			typedef typename std::result_of<Function(const Type&)>::type type;
+		};
+
+		template <typename Function>
+		struct TaskContinuationResult<void,Function>
+		{
+			typedef typename std::result_of<Function()>::type type;
+		};
+
+
+		/*
+			A class representing the callable of a task whose result is stored in a state.
+			If the callable is destroyed without being called, the result is abandoned.
+		*/
+		template <typename Result , typename Function>
+		class TaskJob
+		{
+			private:
+
+				// The state the result is stored in.
+				TaskState<Result>* m_state;
+				// The function producing the result.
+				Function m_function;
+
+
+				// The copy constructor is not available.
+				TaskJob( const TaskJob& );
+				// The assignment operator is not available.
+				TaskJob& operator=( const TaskJob& );
+
+
+			public:
+
+				// The constructor of the class.
+				TaskJob( TaskState<Result>* state , Function&& function );
+				// The move constructor of the class.
+				TaskJob( TaskJob&& job );
+				// The destructor of the class.
+				~TaskJob();
+
+
+				// The function call operator, which calls the function and stores its result.
+				void operator()();
+		};
+
+
+		/*
+			A class representing the callable of a continuation, which calls its function with the result of another task.
+			If the other task was abandoned or the callable is destroyed without being called, the result is abandoned.
+		*/
+		template <typename Type , typename Result , typename Function>
+		class TaskContinuation
+		{
+			private:
+
+				// The state of the task the continuation follows.
+				TaskState<Type>* m_source;
+				// The state the result is stored in.
+				TaskState<Result>* m_state;
+				// The function producing the result.
+				Function m_function;
+
+
+				// The copy constructor is not available.
+				TaskContinuation( const TaskContinuation& );
+				// The assignment operator is not available.
+				TaskContinuation& operator=( const TaskContinuation& );
+
+
+				// A function responsible of calling the function with the result of the task the continuation follows.
+				template <typename Source>
+				static void call( TaskState<Source>* source , TaskState<Result>* state , Function& function );
+				// A function responsible of calling the function, since the task the continuation follows has no result.
+				static void call( TaskState<void>* source , TaskState<Result>* state , Function& function );
+
+
+			public:
+
+				// The constructor of the class.
+				TaskContinuation( TaskState<Type>* source , TaskState<Result>* state , Function&& function );
+				// The move constructor of the class.
+				TaskContinuation( TaskContinuation&& continuation );
+				// The destructor of the class.
+				~TaskContinuation();
+
+
+				// The function call operator, which calls the function and stores its result.
+				void operator()();
+		};
+
+
+		// A class representing the callable that marks a future of a group as ready.
+		class TaskGroupArrival
+		{
+			private:
+
+				// The state of the group.
+				TaskGroupState* m_state;
+
+
+				// The assignment operator is not available.
+				TaskGroupArrival& operator=( const TaskGroupArrival& );
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL explicit TaskGroupArrival( TaskGroupState* state );
+				// The copy constructor of the class.
+				ATHENA_DLL TaskGroupArrival( const TaskGroupArrival& arrival );
+				// The destructor of the class.
+				ATHENA_DLL ~TaskGroupArrival();
+
+
+				// The function call operator, which marks the future as ready.
+				ATHENA_DLL void operator()();
+		};
+
+
+		// A class representing the callable that chooses a future of a group.
+		class TaskChoiceArrival
+		{
+			private:
+
+				// The state of the group.
+				TaskChoiceState* m_state;
+				// The index of the future in the group.
+				size_t m_index;
+
+
+				// The assignment operator is not available.
+				TaskChoiceArrival& operator=( const TaskChoiceArrival& );
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL TaskChoiceArrival( TaskChoiceState* state , const size_t index );
+				// The copy constructor of the class.
+				ATHENA_DLL TaskChoiceArrival( const TaskChoiceArrival& arrival );
+				// The destructor of the class.
+				ATHENA_DLL ~TaskChoiceArrival();
+
+
+				// The function call operator, which chooses the future.
+				ATHENA_DLL void operator()();
+		};
+
+
+		/*
+			A class representing a handle to the result of a task. Futures are cheap to copy, since
+			every copy refers to the same reference counted state.
+			A future that does not refer to a state is invalid.
+		*/
+		class TaskFutureBase
+		{
+			protected:
+
+				// The state of the result.
+				TaskStateBase* m_state;
+
+
+				// A constructor of the class that refers to the given state.
+				ATHENA_DLL explicit TaskFutureBase( TaskStateBase* state );
+
+
+			public:
+
+				// The default constructor of the class, which creates an invalid future.
+				ATHENA_DLL TaskFutureBase();
+				// The copy constructor of the class.
+				ATHENA_DLL TaskFutureBase( const TaskFutureBase& future );
+				// The move constructor of the class.
+				ATHENA_DLL TaskFutureBase( TaskFutureBase&& future );
+				// The destructor of the class.
+				ATHENA_DLL ~TaskFutureBase();
+
+
+				// The assignment operator.
+				ATHENA_DLL TaskFutureBase& operator=( const TaskFutureBase& future );
+				// The move assignment operator.
+				ATHENA_DLL TaskFutureBase& operator=( TaskFutureBase&& future );
+
+
+				/*
+					A function responsible of blocking until the result is ready. While waiting, a thread of the pool performs
+					the queued tasks of the pool. Returns immediately if the future is invalid.
+				*/
+				ATHENA_DLL void wait() const;
+				/*
+					A function responsible of queuing the given task to the thread pool once the result is ready,
+					whether it is fulfilled or abandoned. The task is deallocated if the future is invalid.
+				*/
+				ATHENA_DLL void attach( ThreadTask* task ) const;
+
+
+				// A function returning whether the future refers to a result.
+				ATHENA_DLL bool valid() const;
+				// A function returning whether the result is ready, either fulfilled or abandoned.
+				ATHENA_DLL bool ready() const;
+				// A function returning whether the result has been abandoned, in which case it will never be available.
+				ATHENA_DLL bool abandoned() const;
+		};
+
+
+		// A class providing the access to the result of a future.
+		template <typename Type>
+		class TaskFutureValue : public TaskFutureBase
+		{
+			protected:
+
+				// The default constructor of the class, which creates an invalid future.
+				TaskFutureValue();
+				// A constructor of the class that refers to the given state.
+				explicit TaskFutureValue( TaskState<Type>* state );
+
+
+			public:
+
+				// A function responsible of waiting for the result and copying it. Returns false if the future is invalid or the result was abandoned.
+				bool get( Type& value ) const;
+		};
+
+		template <>
+		class TaskFutureValue<void> : public TaskFutureBase
+		{
+			protected:
+
+				// The default constructor of the class, which creates an invalid future.
+				TaskFutureValue();
+				// A constructor of the class that refers to the given state.
+				explicit TaskFutureValue( TaskState<void>* state );
+
+
+			public:
+
+				// A function responsible of waiting for the task to be performed. Returns false if the future is invalid or the result was abandoned.
+				bool get() const;
+		};
+
+
+		// A class representing a handle to the result of a task, which can be waited on and continued with other tasks.
+		template <typename Type>
+		class TaskFuture : public TaskFutureValue<Type>
+		{
+			public:
+
+				// The default constructor of the class, which creates an invalid future.
+				TaskFuture();
+				// A constructor of the class that refers to the given state.
+				explicit TaskFuture( TaskState<Type>* state );
+
+
+				/*
+					A function responsible of queuing the given function to the thread pool once the result is fulfilled. The function is
+					called with the result, or without any argument if the task has no result. If the result is abandoned, the result of the
+					continuation is abandoned as well. Returns the future of the result of the continuation.
+				*/
+				template <typename Function>
+				TaskFuture<typename TaskContinuationResult<Type,typename std::decay<Function>::type>::type> then( Function&& function ) const;
+		};
+
+
+		/*
+			A function returning a future that is ready once every future in the range [begin,end) is ready.
+			The future is abandoned if a future of the range could not be waited on.
+		*/
+		template <typename Iterator>
+		TaskFuture<void> when_all( Iterator begin , Iterator end );
+		/*
+			A function returning a future that is fulfilled with the index of the first future in the range [begin,end) that is ready.
+			Invalid futures are ignored. The future is abandoned if none of the futures can be waited on.
+		*/
+		template <typename Iterator>
+		TaskFuture<size_t> when_any( Iterator begin , Iterator end );
+
+	} /* core */
+
+} /* athena */
+
+
+#include "taskFuture.inl"
+
+
+
+#endif /* ATHENA_CORE_TASKFUTURE_HPP */
\ No newline at end of file
@@ -0,0 +1,394 @@
+#ifndef ATHENA_CORE_TASKFUTURE_INL
+#define ATHENA_CORE_TASKFUTURE_INL
+
+#ifndef ATHENA_CORE_TASKFUTURE_HPP
+	#error "taskFuture.hpp must be included before taskFuture.inl"
+#endif /* ATHENA_CORE_TASKFUTURE_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the class.
+		template <typename Type>
+		TaskState<Type>::TaskState() :
+			TaskStateBase() ,
+			m_value()
+		{
+		}
+
+		// The destructor of the class.
+		template <typename Type>
+		TaskState<Type>::~TaskState()
+		{
+			if ( status() == FulfilledTask )
+				reinterpret_cast<Type*>(&m_value)->~Type();
+		}
+
+
+		// A function responsible of storing the result and completing the state. Must only be called once.
+		template <typename Type>
+		template <typename Value>
+		void TaskState<Type>::fulfil( Value&& value )
+		{
+			new (static_cast<void*>(&m_value)) Type(std::forward<Value>(value));
+			complete(FulfilledTask);
+		}
+
+
+		// A function returning the result. Must only be called once the result is fulfilled.
+		template <typename Type>
+		const Type& TaskState<Type>::value() const
+		{
+			return *reinterpret_cast<const Type*>(&m_value);
+		}
+
+
+		// A function responsible of completing the state. Must only be called once.
+		inline void TaskState<void>::fulfil()
+		{
+			complete(FulfilledTask);
+		}
+
+
+		// A function responsible of calling the given function with the given arguments and fulfilling the state with the result.
+		template <typename Result>
+		template <typename Function , typename... Arguments>
+		void TaskResult<Result>::fulfil( TaskState<Result>* state , Function& function , Arguments&&... arguments )
+		{
+			state->fulfil(function(std::forward<Arguments>(arguments)...));
+		}
+
+		// A function responsible of calling the given function with the given arguments and fulfilling the state.
+		template <typename Function , typename... Arguments>
+		void TaskResult<void>::fulfil( TaskState<void>* state , Function& function , Arguments&&... arguments )
+		{
+			function(std::forward<Arguments>(arguments)...);
+			state->fulfil();
+		}
+
+
+		// The constructor of the class.
+		template <typename Result , typename Function>
+		TaskJob<Result,Function>::TaskJob( TaskState<Result>* state , Function&& function ) :
+			m_state(state) ,
+			m_function(std::move(function))
+		{
+			m_state->acquire();
+		}
+
+		// The move constructor of the class.
+		template <typename Result , typename Function>
+		TaskJob<Result,Function>::TaskJob( TaskJob&& job ) :
+			m_state(job.m_state) ,
+			m_function(std::move(job.m_function))
+		{
+			job.m_state = NULL;
+		}
+
+		// The destructor of the class.
+		template <typename Result , typename Function>
+		TaskJob<Result,Function>::~TaskJob()
+		{
+			if ( m_state != NULL )
+			{
+				m_state->abandon();
+				m_state->release();
+			}
+		}
+
+
+		// The function call operator, which calls the function and stores its result.
+		template <typename Result , typename Function>
+		void TaskJob<Result,Function>::operator()()
+		{
+			TaskResult<Result>::fulfil(m_state,m_function);
+		}
+
+
+		// A function responsible of calling the function with the result of the task the continuation follows.
+		template <typename Type , typename Result , typename Function>
+		template <typename Source>
+		void TaskContinuation<Type,Result,Function>::call( TaskState<Source>* source , TaskState<Result>* state , Function& function )
+		{
+			TaskResult<Result>::fulfil(state,function,source->value());
+		}
+
+		// A function responsible of calling the function, since the task the continuation follows has no result.
+		template <typename Type , typename Result , typename Function>
+		void TaskContinuation<Type,Result,Function>::call( TaskState<void>* , TaskState<Result>* state , Function& function )
+		{
+			TaskResult<Result>::fulfil(state,function);
+		}
+
+
+		// The constructor of the class.
+		template <typename Type , typename Result , typename Function>
+		TaskContinuation<Type,Result,Function>::TaskContinuation( TaskState<Type>* source , TaskState<Result>* state , Function&& function ) :
+			m_source(source) ,
+			m_state(state) ,
+			m_function(std::move(function))
+		{
+			m_source->acquire();
+			m_state->acquire();
+		}
+
+		// The move constructor of the class.
+		template <typename Type , typename Result , typename Function>
+		TaskContinuation<Type,Result,Function>::TaskContinuation( TaskContinuation&& continuation ) :
+			m_source(continuation.m_source) ,
+			m_state(continuation.m_state) ,
+			m_function(std::move(continuation.m_function))
+		{
+			continuation.m_source = NULL;
+			continuation.m_state = NULL;
+		}
+
+		// The destructor of the class.
+		template <typename Type , typename Result , typename Function>
+		TaskContinuation<Type,Result,Function>::~TaskContinuation()
+		{
+			if ( m_source != NULL )
+				m_source->release();
+
+			if ( m_state != NULL )
+			{
+				m_state->abandon();
+				m_state->release();
+			}
+		}
+
+
+		// The function call operator, which calls the function and stores its result.
+		template <typename Type , typename Result , typename Function>
+		void TaskContinuation<Type,Result,Function>::operator()()
+		{
+			// The result of an abandoned task is abandoned by the destructor.
+			if ( m_source->status() == FulfilledTask )
+				call(m_source,m_state,m_function);
+		}
+
+
+		// The default constructor of the class, which creates an invalid future.
+		template <typename Type>
+		TaskFutureValue<Type>::TaskFutureValue() :
+			TaskFutureBase()
+		{
+		}
+
+		// A constructor of the class that refers to the given state.
+		template <typename Type>
+		TaskFutureValue<Type>::TaskFutureValue( TaskState<Type>* state ) :
+			TaskFutureBase(state)
+		{
+		}
+
+
+		// A function responsible of waiting for the result and copying it. Returns false if the future is invalid or the result was abandoned.
+		template <typename Type>
+		bool TaskFutureValue<Type>::get( Type& value ) const
+		{
+			bool return_value = false;
+
+
+			if ( m_state != NULL )
+			{
+				m_state->wait();
+
+				if ( m_state->status() == FulfilledTask )
+				{
+					value = static_cast<TaskState<Type>*>(m_state)->value();
+					return_value = true;
+				}
+			}
+
+
+			return return_value;
+		}
+
+
+		// The default constructor of the class, which creates an invalid future.
+		inline TaskFutureValue<void>::TaskFutureValue() :
+			TaskFutureBase()
+		{
+		}
+
+		// A constructor of the class that refers to the given state.
+		inline TaskFutureValue<void>::TaskFutureValue( TaskState<void>* state ) :
+			TaskFutureBase(state)
+		{
+		}
+
+
+		// A function responsible of waiting for the task to be performed. Returns false if the future is invalid or the result was abandoned.
+		inline bool TaskFutureValue<void>::get() const
+		{
+			bool return_value = false;
+
+
+			if ( m_state != NULL )
+			{
+				m_state->wait();
+				return_value = ( m_state->status() == FulfilledTask );
+			}
+
+
+			return return_value;
+		}
+
+
+		// The default constructor of the class, which creates an invalid future.
+		template <typename Type>
+		TaskFuture<Type>::TaskFuture() :
+			TaskFutureValue<Type>()
+		{
+		}
+
+		// A constructor of the class that refers to the given state.
+		template <typename Type>
+		TaskFuture<Type>::TaskFuture( TaskState<Type>* state ) :
+			TaskFutureValue<Type>(state)
+		{
+		}
+
+
+		/*
+			A function responsible of queuing the given function to the thread pool once the result is fulfilled. The function is
+			called with the result, or without any argument if the task has no result. If the result is abandoned, the result of the
+			continuation is abandoned as well. Returns the future of the result of the continuation.
+		*/
+		template <typename Type>
+		template <typename Function>
+		TaskFuture<typename TaskContinuationResult<Type,typename std::decay<Function>::type>::type> TaskFuture<Type>::then( Function&& function ) const
+		{
+			typedef typename std::decay<Function>::type FunctionType;
+			typedef typename TaskContinuationResult<Type,FunctionType>::type ResultType;
+
+			TaskFuture<ResultType> return_value;
+
+
+			if ( this->m_state != NULL )
+			{
+				TaskState<ResultType>* state = new (std::nothrow) TaskState<ResultType>();
+
+
+				if ( state != NULL )
+				{
+					ThreadTask* task = new (std::nothrow) ThreadTask();
+
+
+					return_value = TaskFuture<ResultType>(state);
+
+					if ( task != NULL  &&  task->callable(TaskContinuation<Type,ResultType,FunctionType>(static_cast<TaskState<Type>*>(this->m_state),state,FunctionType(std::forward<Function>(function)))) )
+						this->attach(task);
+					else
+					{
+						delete task;
+						state->abandon();
+					}
+				}
+			}
+
+
+			return return_value;
+		}
+
+
+		/*
+			A function returning a future that is ready once every future in the range [begin,end) is ready.
+			The future is abandoned if a future of the range could not be waited on.
+		*/
+		template <typename Iterator>
+		TaskFuture<void> when_all( Iterator begin , Iterator end )
+		{
+			TaskGroupState* state = new (std::nothrow) TaskGroupState();
+			TaskFuture<void> return_value;
+
+
+			if ( state != NULL )
+			{
+				return_value = TaskFuture<void>(state);
+
+				for ( Iterator future_iterator = begin;  future_iterator != end;  ++future_iterator )
+				{
+					if ( future_iterator->valid() )
+					{
+						ThreadTask* task = new (std::nothrow) ThreadTask();
+
+
+						state->add();
+
+						if ( task != NULL  &&  task->callable(TaskGroupArrival(state)) )
+							future_iterator->attach(task);
+						else
+						{
+							delete task;
+							state->fail();
+							state->arrive();
+						}
+					}
+				}
+
+				// Release the reference that was held while the group was formed.
+				state->arrive();
+			}
+
+
+			return return_value;
+		}
+
+		/*
+			A function returning a future that is fulfilled with the index of the first future in the range [begin,end) that is ready.
+			Invalid futures are ignored. The future is abandoned if none of the futures can be waited on.
+		*/
+		template <typename Iterator>
+		TaskFuture<size_t> when_any( Iterator begin , Iterator end )
+		{
+			TaskChoiceState* state = new (std::nothrow) TaskChoiceState();
+			TaskFuture<size_t> return_value;
+
+
+			if ( state != NULL )
+			{
+				size_t index = 0;
+				size_t attached = 0;
+
+
+				return_value = TaskFuture<size_t>(state);
+
+				for ( Iterator future_iterator = begin;  future_iterator != end;  ++future_iterator , ++index )
+				{
+					if ( future_iterator->valid() )
+					{
+						ThreadTask* task = new (std::nothrow) ThreadTask();
+
+
+						if ( task != NULL  &&  task->callable(TaskChoiceArrival(state,index)) )
+						{
+							future_iterator->attach(task);
+							++attached;
+						}
+						else
+							delete task;
+					}
+				}
+
+				if ( attached == 0 )
+					state->abandon();
+			}
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_TASKFUTURE_INL */
\ No newline at end of file
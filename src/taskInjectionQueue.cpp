@@ -0,0 +1,93 @@
+#include "taskInjectionQueue.hpp"
+#include "threadTask.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the class. The queue is created open.
+		TaskInjectionQueue::TaskInjectionQueue() :
+			m_tasks(0,NULL) ,
+			m_size(0) ,
+			m_lock() ,
+			m_open(true)
+		{
+		}
+
+		// The destructor of the class. Any queued tasks are deallocated.
+		TaskInjectionQueue::~TaskInjectionQueue()
+		{
+			for (
+					std::deque<ThreadTask*>::iterator task_iterator = m_tasks.begin();
+					task_iterator != m_tasks.end();
+					++task_iterator
+				)
+			{
+				delete (*task_iterator);
+			}
+
+			m_tasks.clear();
+		}
+
+
+		// A function responsible of queuing a task. Returns false if the queue is closed.
+		bool TaskInjectionQueue::push( ThreadTask* task )
+		{
+			bool return_value = false;
+
+
+			m_lock.lock();
+
+			if ( m_open )
+			{
+				m_tasks.push_back(task);
+				m_size.store(m_tasks.size(),std::memory_order_release);
+				return_value = true;
+			}
+
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		// A function responsible of taking the oldest task. Returns NULL if the queue is empty.
+		ThreadTask* TaskInjectionQueue::pop()
+		{
+			ThreadTask* return_value = NULL;
+
+
+			// Only take the lock if there is a task to take.
+			if ( m_size.load(std::memory_order_acquire) > 0 )
+			{
+				m_lock.lock();
+
+				if ( m_tasks.size() > 0 )
+				{
+					return_value = m_tasks.front();
+					m_tasks.pop_front();
+					m_size.store(m_tasks.size(),std::memory_order_relaxed);
+				}
+
+				m_lock.unlock();
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of closing the queue, so that it rejects any further tasks.
+		void TaskInjectionQueue::close()
+		{
+			m_lock.lock();
+			m_open = false;
+			m_lock.unlock();
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
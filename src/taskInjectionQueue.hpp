@@ -0,0 +1,77 @@
+#ifndef ATHENA_CORE_TASKINJECTIONQUEUE_HPP
+#define ATHENA_CORE_TASKINJECTIONQUEUE_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <atomic>
+#include <mutex>
+#include <deque>
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		class ThreadTask;
+
+
+		/*
+			A FIFO queue holding the tasks that have been queued to the thread pool by threads outside the pool.
+			The amount of queued tasks is kept in an atomic variable, so that a thread looking for work only takes
+			the lock if there is a task to take. A closed queue rejects any further tasks.
+		*/
+		class TaskInjectionQueue
+		{
+			private:
+
+				// The queued tasks.
+				std::deque<ThreadTask*> m_tasks;
+				// The amount of queued tasks.
+				std::atomic<size_t> m_size;
+				// A lock that is used to handle concurrency issues.
+				std::mutex m_lock;
+				// A variable holding whether the queue accepts tasks. Protected by the lock.
+				bool m_open;
+
+
+				// The copy constructor is not available.
+				TaskInjectionQueue( const TaskInjectionQueue& );
+				// The assignment operator is not available.
+				TaskInjectionQueue& operator=( const TaskInjectionQueue& );
+
+
+			public:
+
+				// The constructor of the class. The queue is created open.
+				ATHENA_DLL TaskInjectionQueue();
+				// The destructor of the class. Any queued tasks are deallocated.
+				ATHENA_DLL ~TaskInjectionQueue();
+
+
+				// A function responsible of queuing a task. Returns false if the queue is closed.
+				ATHENA_DLL bool push( ThreadTask* task );
+				// A function responsible of taking the oldest task. Returns NULL if the queue is empty.
+				ATHENA_DLL ThreadTask* pop();
+				// A function responsible of closing the queue, so that it rejects any further tasks.
+				ATHENA_DLL void close();
+
+
+				// A function returning the amount of queued tasks.
+				ATHENA_DLL size_t size() const;
+				// A function returning whether the queue is empty.
+				ATHENA_DLL bool empty() const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "taskInjectionQueue.inl"
+
+
+
+#endif /* ATHENA_CORE_TASKINJECTIONQUEUE_HPP */
\ No newline at end of file
@@ -0,0 +1,34 @@
+#ifndef ATHENA_CORE_TASKINJECTIONQUEUE_INL
+#define ATHENA_CORE_TASKINJECTIONQUEUE_INL
+
+#ifndef ATHENA_CORE_TASKINJECTIONQUEUE_HPP
+	#error "taskInjectionQueue.hpp must be included before taskInjectionQueue.inl"
+#endif /* ATHENA_CORE_TASKINJECTIONQUEUE_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function returning the amount of queued tasks.
+		inline size_t TaskInjectionQueue::size() const
+		{
+			return m_size.load(std::memory_order_acquire);
+		}
+
+		// A function returning whether the queue is empty.
+		inline bool TaskInjectionQueue::empty() const
+		{
+			return ( size() == 0 );
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_TASKINJECTIONQUEUE_INL */
\ No newline at end of file
@@ -0,0 +1,200 @@
+#include "taskTimerQueue.hpp"
+#include <algorithm>
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The function that is run by the service thread.
+		int TaskTimerQueue::thread_functionality( void* parameter )
+		{
+			TaskTimerQueue* queue = static_cast<TaskTimerQueue*>(parameter);
+
+
+			if ( queue != NULL )
+				queue->fire_timers();
+
+
+			return 0;
+		}
+
+		// A function returning whether the first timer fires after the second one, which is used to order the heap.
+		bool TaskTimerQueue::later( const Entry& first , const Entry& second )
+		{
+			return ( first.m_time > second.m_time  ||  ( first.m_time == second.m_time  &&  first.m_sequence > second.m_sequence ) );
+		}
+
+
+		// A function responsible of firing the timers until the queue is terminated.
+		void TaskTimerQueue::fire_timers()
+		{
+			m_lock.lock();
+
+			while ( m_run )
+			{
+				if ( m_timers.size() == 0 )
+					m_condition_variable.wait(m_lock);
+				else if ( m_timers.front().m_time > TaskClock::now() )
+				{
+					// The time is copied, since the heap may be reallocated while the thread waits.
+					TaskClock::time_point time = m_timers.front().m_time;
+
+
+					m_condition_variable.wait_until(m_lock,time);
+				}
+				else
+				{
+					TaskState<void>* state = m_timers.front().m_state;
+
+
+					std::pop_heap(m_timers.begin(),m_timers.end(),later);
+					m_timers.pop_back();
+
+					// The state is fulfilled without holding the lock, since its continuations may schedule new timers.
+					m_lock.unlock();
+					state->fulfil();
+					state->release();
+					m_lock.lock();
+				}
+			}
+
+			m_lock.unlock();
+		}
+
+
+		// The constructor of the class.
+		TaskTimerQueue::TaskTimerQueue() :
+			m_timers(0) ,
+			m_sequence(0) ,
+			m_lock() ,
+			m_condition_variable() ,
+			m_thread() ,
+			m_run(false)
+		{
+		}
+
+		// The destructor of the class.
+		TaskTimerQueue::~TaskTimerQueue()
+		{
+			terminate();
+		}
+
+
+		// A function responsible of starting the service thread of the queue. Returns false if the thread could not be spawned.
+		bool TaskTimerQueue::startup( const std::string& name )
+		{
+			bool return_value = true;
+
+
+			m_lock.lock();
+
+			if ( !m_run )
+			{
+				m_run = true;
+				return_value = m_thread.start(name,thread_functionality,static_cast<void*>(this));
+
+				if ( !return_value )
+					m_run = false;
+			}
+
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		// A function responsible of stopping the service thread of the queue. The futures of the timers that have not fired are abandoned.
+		void TaskTimerQueue::terminate()
+		{
+			std::vector<Entry> timers;
+
+
+			m_lock.lock();
+			m_run = false;
+			m_timers.swap(timers);
+			m_condition_variable.notify_all();
+			m_lock.unlock();
+
+			m_thread.join();
+
+			// For every timer that has not fired.
+			for (
+					std::vector<Entry>::iterator timer_iterator = timers.begin();
+					timer_iterator != timers.end();
+					++timer_iterator
+				)
+			{
+				timer_iterator->m_state->abandon();
+				timer_iterator->m_state->release();
+			}
+		}
+
+
+		/*
+			A function responsible of scheduling a timer that fires at the given time, and returning a future that is fulfilled when it fires.
+			The future is abandoned if the queue is not operational or the timer could not be scheduled.
+		*/
+		TaskFuture<void> TaskTimerQueue::schedule( const TaskClock::time_point& time )
+		{
+			TaskState<void>* state = new (std::nothrow) TaskState<void>();
+			TaskFuture<void> return_value;
+
+
+			if ( state != NULL )
+			{
+				bool scheduled = false;
+
+
+				return_value = TaskFuture<void>(state);
+				m_lock.lock();
+
+				if ( m_run )
+				{
+					Entry entry;
+
+
+					entry.m_time = time;
+					entry.m_sequence = m_sequence++;
+					entry.m_state = state;
+					m_timers.push_back(entry);
+					std::push_heap(m_timers.begin(),m_timers.end(),later);
+					state->acquire();
+					scheduled = true;
+
+					// The service thread only has to wake up if the new timer fires first.
+					if ( m_timers.front().m_state == state )
+						m_condition_variable.notify_one();
+				}
+
+				m_lock.unlock();
+
+				if ( !scheduled )
+					state->abandon();
+			}
+
+
+			return return_value;
+		}
+
+
+		// A function returning the amount of timers that have not fired yet.
+		size_t TaskTimerQueue::size()
+		{
+			size_t return_value = 0;
+
+
+			m_lock.lock();
+			return_value = m_timers.size();
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
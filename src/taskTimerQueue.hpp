@@ -0,0 +1,104 @@
+#ifndef ATHENA_CORE_TASKTIMERQUEUE_HPP
+#define ATHENA_CORE_TASKTIMERQUEUE_HPP
+
+#include "definitions.hpp"
+#include <string>
+#include <vector>
+#include <mutex>
+#include <condition_variable>
+#include "threadTask.hpp"
+#include "taskFuture.hpp"
+#include "serviceThread.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A class representing a queue of timers, each of which fulfils a future once its time arrives.
+			The timers are kept in a binary heap ordered by time and are fired by a service thread, so waiting
+			for a timer never blocks a thread of the pool. Timers with the same time fire in the order they were scheduled.
+			The continuations of a future that is fulfilled by a timer are queued to the thread pool.
+		*/
+		class TaskTimerQueue
+		{
+			private:
+
+				// A struct holding a scheduled timer.
+				struct Entry
+				{
+					// The time the timer fires.
+					TaskClock::time_point m_time;
+					// The order the timer was scheduled in, which orders the timers with the same time.
+					unsigned long long m_sequence;
+					// The state that is fulfilled when the timer fires.
+					TaskState<void>* m_state;
+				};
+
+
+				// The heap of the scheduled timers, with the timer that fires first at the front.
+				std::vector<Entry> m_timers;
+				// The order the next timer is scheduled in.
+				unsigned long long m_sequence;
+				// A lock that is used to handle concurrency issues.
+				std::mutex m_lock;
+				// The condition variable that the service thread waits on until the next timer fires or a timer is scheduled.
+				std::condition_variable_any m_condition_variable;
+				// The service thread that fires the timers.
+				ServiceThread m_thread;
+				// A variable holding whether the queue is operational.
+				bool m_run;
+
+
+				// The copy constructor is not available.
+				TaskTimerQueue( const TaskTimerQueue& );
+				// The assignment operator is not available.
+				TaskTimerQueue& operator=( const TaskTimerQueue& );
+
+
+				// The function that is run by the service thread.
+				static int thread_functionality( void* parameter );
+				// A function returning whether the first timer fires after the second one, which is used to order the heap.
+				static bool later( const Entry& first , const Entry& second );
+
+
+				// A function responsible of firing the timers until the queue is terminated.
+				void fire_timers();
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL TaskTimerQueue();
+				// The destructor of the class.
+				ATHENA_DLL ~TaskTimerQueue();
+
+
+				// A function responsible of starting the service thread of the queue. Returns false if the thread could not be spawned.
+				ATHENA_DLL bool startup( const std::string& name );
+				// A function responsible of stopping the service thread of the queue. The futures of the timers that have not fired are abandoned.
+				ATHENA_DLL void terminate();
+
+
+				/*
+					A function responsible of scheduling a timer that fires at the given time, and returning a future that is fulfilled when it fires.
+					The future is abandoned if the queue is not operational or the timer could not be scheduled.
+				*/
+				ATHENA_DLL TaskFuture<void> schedule( const TaskClock::time_point& time );
+
+
+				// A function returning the amount of timers that have not fired yet.
+				ATHENA_DLL size_t size();
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_TASKTIMERQUEUE_HPP */
\ No newline at end of file
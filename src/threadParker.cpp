@@ -0,0 +1,49 @@
+#include "threadParker.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the class.
+		ThreadParker::ThreadParker() :
+			m_lock() ,
+			m_condition_variable() ,
+			m_permit(false)
+		{
+		}
+
+		// The destructor of the class.
+		ThreadParker::~ThreadParker()
+		{
+		}
+
+
+		// A function responsible of blocking the calling thread until a permit is granted, and consuming the permit.
+		void ThreadParker::park()
+		{
+			std::unique_lock<std::mutex> lock(m_lock);
+
+
+			while ( !m_permit )
+				m_condition_variable.wait(lock);
+
+			m_permit = false;
+		}
+
+		// A function responsible of granting a permit, waking up the parked thread if there is one.
+		void ThreadParker::unpark()
+		{
+			m_lock.lock();
+			m_permit = true;
+			m_lock.unlock();
+
+			m_condition_variable.notify_one();
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
@@ -0,0 +1,59 @@
+#ifndef ATHENA_CORE_THREADPARKER_HPP
+#define ATHENA_CORE_THREADPARKER_HPP
+
+#include "definitions.hpp"
+#include <mutex>
+#include <condition_variable>
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A class representing a binary semaphore that a single thread parks on until another thread unparks it.
+			An unpark that happens before the park is not lost, since the permit is kept until the parked thread consumes it.
+			Every permit is granted to a specific thread, so unparking never wakes more than the thread it is meant for.
+		*/
+		class ThreadParker
+		{
+			private:
+
+				// A lock that is used to handle concurrency issues.
+				std::mutex m_lock;
+				// The condition variable that the thread parks on.
+				std::condition_variable m_condition_variable;
+				// A variable holding whether a permit has been granted and not yet consumed.
+				bool m_permit;
+
+
+				// The copy constructor is not available.
+				ThreadParker( const ThreadParker& );
+				// The assignment operator is not available.
+				ThreadParker& operator=( const ThreadParker& );
+
+
+			public:
+
+				// The constructor of the class.
+				ATHENA_DLL ThreadParker();
+				// The destructor of the class.
+				ATHENA_DLL ~ThreadParker();
+
+
+				// A function responsible of blocking the calling thread until a permit is granted, and consuming the permit.
+				ATHENA_DLL void park();
+				// A function responsible of granting a permit, waking up the parked thread if there is one.
+				ATHENA_DLL void unpark();
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_THREADPARKER_HPP */
\ No newline at end of file
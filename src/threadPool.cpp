@@ -1,5 +1,9 @@
 #include "threadPool.hpp"
 #include <iostream>
+#include <sstream>
+#include <algorithm>
+#include "threadUtilities.hpp"
+#include "logManager.hpp"
 
 #ifdef _WIN32
 	
@@ -24,73 +28,62 @@ namespace athena
 		std::mutex ThreadPool::s_instance_lock;
 
 
+		// The pool the current thread belongs to, if the thread belongs to a pool.
+		ATHENA_THREAD_LOCAL ThreadPool* ThreadPool::s_worker_pool = NULL;
+		// The deques of the current thread, one for each priority class, if the thread belongs to a pool.
+		ATHENA_THREAD_LOCAL TaskDeque** ThreadPool::s_worker_deques = NULL;
+		// The index of the current thread in its pool, if the thread belongs to a pool.
+		ATHENA_THREAD_LOCAL unsigned int ThreadPool::s_worker_index = 0;
+		// The state of the random generator of the current thread that is used to pick the victims to steal from.
+		ATHENA_THREAD_LOCAL unsigned int ThreadPool::s_worker_random_state = 0;
+
+
 		// The function that is used to perform the functionality of each thread.
-		void ThreadPool::thread_functionality( void* parameter )
+		void ThreadPool::thread_functionality( void* parameter , const unsigned int index )
 		{
 			ThreadPool* pool = static_cast<ThreadPool*>(parameter);
+			io::LogManager* log_manager = NULL;
 
 
 			if ( pool != NULL )
 			{
-				ThreadTask* task = NULL;
-				bool run = true;
+				std::ostringstream name;
+
+
+				name << "athena-worker-" << index;
+				utility::set_thread_name(name.str());
+
+				// Restrict the thread to its processors, if it has any.
+				if ( pool->m_thread_processors[index].size() > 0  &&  !utility::set_thread_affinity(pool->m_thread_processors[index]) )
+					pool->m_unrestricted_threads.fetch_add(1,std::memory_order_relaxed);
 
+				// Tasks that are queued by this thread are pushed to its own deques.
+				s_worker_pool = pool;
+				s_worker_deques = &pool->m_deques[index * s_PRIORITY_COUNT];
+				s_worker_index = index;
+				s_worker_random_state = ( index + 1 ) * 2654435761U;
 
-				while ( run )
+				// While the thread pool is operational.
+				while ( pool->m_run.load(std::memory_order_acquire) )
 				{
-					// Get the task lock.
-					pool->m_lock.lock();
-					// Check if the thread pool is running.
-					run = pool->m_run;
-					
-					// If the thread pool is operational.
-					if ( run )
-					{
-						// If the task queue is not empty.
-						if ( pool->m_tasks.size() > 0 )
-						{
-							// Get the first task in the queue.
-							task = pool->m_tasks[0];
-							// Pop the task from the queue.
-							pool->m_tasks.pop_front();
-						}
-					}
-					
-					// Release the task lock.
-					pool->m_lock.unlock();
+					ThreadTask* task = pool->next_task(index);
 
-					if ( run )
-					{
-						// If a task was retrieved.
-						if ( task != NULL )
-						{
-							// A variable that is used to hold the exit code of the task.
-							int exit_code = 0;
-						
-						
-							// Perform the task.
-							exit_code = (*task->m_function)(task->m_parameter);
-
-							// If a callback function was provided.
-							if ( task->m_callback != NULL )
-								(*task->m_callback)(exit_code,task->m_callback_parameter); // Call the callback function.
-						
-							// Deallocate the task.
-							delete task;
-							// Reset the task pointer.
-							task = NULL;
-						}
-						else
-						{
-							// Get the condition variable lock.
-							pool->m_wait_lock.lock();
-							// Wait for a signal from the condition variable.
-							pool->m_condition_variable.wait(pool->m_wait_lock);
-							// Release the condition variable lock.
-							pool->m_wait_lock.unlock();
-						}
-					}
+
+					// If a task was retrieved, perform it.
+					if ( task != NULL )
+						pool->run_task(task);
+					else
+						pool->wait_for_task(index);
 				}
+
+				s_worker_pool = NULL;
+				s_worker_deques = NULL;
+
+				// Release the log ring buffer of the thread, if it has one, since the thread is about to exit.
+				log_manager = io::LogManager::get();
+
+				if ( log_manager != NULL )
+					log_manager->release_thread_buffer();
 			}
 		}
 
@@ -98,13 +91,33 @@ namespace athena
 		// The constructor of the class.
 		ThreadPool::ThreadPool() :
 			m_pool(0,NULL) ,
-			m_tasks(0,NULL) ,
+			m_deques(0,NULL) ,
+			m_injection_queues(0,NULL) ,
+			m_thread_nodes(0) ,
+			m_thread_processors(0) ,
+			m_unrestricted_threads(0) ,
+			m_processor_nodes(0) ,
+			m_queued_tasks(0) ,
+			m_submitters(0) ,
+			m_parkers(0,NULL) ,
+			m_idle_workers(0) ,
+			m_idle_threads(0) ,
+			m_spin_count(s_DEFAULT_SPIN_COUNT) ,
+			m_timers() ,
+			m_file_reader() ,
 			m_lock() ,
-			m_wait_lock() ,
-			m_condition_variable() ,
+			m_idle_lock() ,
+			m_requested_threads(0) ,
+			m_pin_threads(false) ,
+			m_numa_aware(false) ,
 			m_initialised(false) ,
 			m_run(false)
 		{
+			for ( unsigned int i = 0;  i < s_PRIORITY_COUNT;  ++i )
+			{
+				m_queue_depths[i].store(0,std::memory_order_relaxed);
+				m_dropped_tasks[i].store(0,std::memory_order_relaxed);
+			}
 		}
 
 		// The destructor of the class.
@@ -132,19 +145,420 @@ namespace athena
 			// Clear the thread pool.
 			m_pool.clear();
 
-			// For every pending task.
-			for ( 
-					std::deque<ThreadTask*>::iterator task_iterator = m_tasks.begin();
-					task_iterator != m_tasks.end();
-					++task_iterator
+			// For every deque of the threads.
+			for (
+					std::vector<TaskDeque*>::iterator deque_iterator = m_deques.begin();
+					deque_iterator != m_deques.end();
+					++deque_iterator
 				)
 			{
-				// Deallocate the task.
-				delete (*task_iterator);
+				ThreadTask* task = NULL;
+
+
+				// Deallocate the pending tasks of the deque.
+				while ( ( task = (*deque_iterator)->pop() ) != NULL )
+					delete task;
+
+				// Deallocate the deque.
+				delete (*deque_iterator);
+			}
+
+			// Clear the deques.
+			m_deques.clear();
+
+			// For every injection queue.
+			for (
+					std::vector<TaskInjectionQueue*>::iterator queue_iterator = m_injection_queues.begin();
+					queue_iterator != m_injection_queues.end();
+					++queue_iterator
+				)
+			{
+				// Deallocate the queue along with its pending tasks.
+				delete (*queue_iterator);
+			}
+
+			// For every parker of the threads.
+			for (
+					std::vector<ThreadParker*>::iterator parker_iterator = m_parkers.begin();
+					parker_iterator != m_parkers.end();
+					++parker_iterator
+				)
+			{
+				// Deallocate the parker.
+				delete (*parker_iterator);
+			}
+
+			// Clear the parkers and the idle threads.
+			m_parkers.clear();
+			m_idle_workers.clear();
+			m_idle_threads.store(0,std::memory_order_relaxed);
+
+			// Clear the injection queues and the placement of the threads.
+			m_injection_queues.clear();
+			m_thread_nodes.clear();
+			m_thread_processors.clear();
+			m_processor_nodes.clear();
+			m_queued_tasks.store(0,std::memory_order_relaxed);
+
+			for ( unsigned int i = 0;  i < s_PRIORITY_COUNT;  ++i )
+				m_queue_depths[i].store(0,std::memory_order_relaxed);
+		}
+
+		// A function responsible of moving every pending task out of the deques and the injection queues to the given vector.
+		void ThreadPool::take_pending_tasks( std::vector<ThreadTask*>& tasks )
+		{
+			ThreadTask* task = NULL;
+
+
+			// For every deque of the threads.
+			for (
+					std::vector<TaskDeque*>::iterator deque_iterator = m_deques.begin();
+					deque_iterator != m_deques.end();
+					++deque_iterator
+				)
+			{
+				while ( ( task = (*deque_iterator)->pop() ) != NULL )
+					tasks.push_back(task);
+			}
+
+			// For every injection queue.
+			for (
+					std::vector<TaskInjectionQueue*>::iterator queue_iterator = m_injection_queues.begin();
+					queue_iterator != m_injection_queues.end();
+					++queue_iterator
+				)
+			{
+				while ( ( task = (*queue_iterator)->pop() ) != NULL )
+					tasks.push_back(task);
+			}
+		}
+
+		/*
+			A function responsible of assigning every thread that is about to be spawned to a node and to the processors it is restricted to.
+			Returns the amount of nodes.
+		*/
+		unsigned int ThreadPool::place_threads( const unsigned int thread_count )
+		{
+			std::vector< std::vector<unsigned int> > topology;
+			std::vector< std::vector<unsigned int> > nodes;
+			std::vector<unsigned int> processors;
+			std::vector<unsigned int> processor_nodes;
+			std::vector<unsigned int> allowed;
+			unsigned int hardware_threads = std::thread::hardware_concurrency();
+			// The processors are limited to the ones the process is allowed to run on, whenever they can be determined.
+			bool restricted = utility::allowed_processors(allowed);
+
+
+			if ( hardware_threads < 1 )
+				hardware_threads = 1;
+
+			// Nodes without any allowed processor either hold memory only or lie outside the cpuset of the process, so they get no threads.
+			if ( m_numa_aware  &&  utility::numa_topology(topology) )
+			{
+				for (
+						std::vector< std::vector<unsigned int> >::iterator node_iterator = topology.begin();
+						node_iterator != topology.end();
+						++node_iterator
+					)
+				{
+					std::vector<unsigned int> node_processors;
+
+
+					for (
+							std::vector<unsigned int>::iterator processor_iterator = node_iterator->begin();
+							processor_iterator != node_iterator->end();
+							++processor_iterator
+						)
+					{
+						if ( !restricted  ||  std::binary_search(allowed.begin(),allowed.end(),(*processor_iterator)) )
+							node_processors.push_back(*processor_iterator);
+					}
+
+					if ( node_processors.size() > 0 )
+						nodes.push_back(node_processors);
+				}
+			}
+
+			// Without NUMA information every processor belongs to a single node.
+			if ( nodes.size() == 0 )
+			{
+				nodes.resize(1);
+
+				if ( restricted )
+					nodes[0] = allowed;
+				else
+				{
+					for ( unsigned int i = 0;  i < hardware_threads;  ++i )
+						nodes[0].push_back(i);
+				}
+			}
+
+			// List the processors node by node, so that consecutive threads share a node.
+			for ( unsigned int node = 0;  node < nodes.size();  ++node )
+			{
+				for (
+						std::vector<unsigned int>::iterator processor_iterator = nodes[node].begin();
+						processor_iterator != nodes[node].end();
+						++processor_iterator
+					)
+				{
+					if ( (*processor_iterator) >= m_processor_nodes.size() )
+						m_processor_nodes.resize((*processor_iterator) + 1,0);
+
+					m_processor_nodes[(*processor_iterator)] = node;
+					processors.push_back(*processor_iterator);
+					processor_nodes.push_back(node);
+				}
+			}
+
+			m_thread_nodes.resize(thread_count,0);
+			m_thread_processors.resize(thread_count);
+
+			for ( unsigned int i = 0;  i < thread_count;  ++i )
+			{
+				size_t processor = i % processors.size();
+
+
+				m_thread_nodes[i] = processor_nodes[processor];
+				m_thread_processors[i].clear();
+
+				// A pinned thread is restricted to its processor, while the thread of a NUMA-aware pool is restricted to its node.
+				if ( m_pin_threads )
+					m_thread_processors[i].push_back(processors[processor]);
+				else if ( nodes.size() > 1 )
+					m_thread_processors[i] = nodes[m_thread_nodes[i]];
+			}
+
+
+			return static_cast<unsigned int>(nodes.size());
+		}
+
+		// A function returning the node of the processor the calling thread is running on.
+		unsigned int ThreadPool::calling_node() const
+		{
+			unsigned int return_value = 0;
+
+
+			if ( m_injection_queues.size() > s_PRIORITY_COUNT )
+			{
+				unsigned int processor = utility::current_processor();
+
+
+				if ( processor < m_processor_nodes.size() )
+					return_value = m_processor_nodes[processor];
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of taking a task of the given priority class from the injection queue of the given node, or of any other node. Returns NULL if the queues are empty.
+		ThreadTask* ThreadPool::pop_injected_task( const unsigned int node , const unsigned int priority )
+		{
+			size_t node_count = m_injection_queues.size() / s_PRIORITY_COUNT;
+			ThreadTask* return_value = NULL;
+
+
+			for ( size_t i = 0;  i < node_count  &&  return_value == NULL;  ++i )
+				return_value = m_injection_queues[( ( node + i ) % node_count ) * s_PRIORITY_COUNT + priority]->pop();
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of stealing a task of the given priority class from the deque of another thread, starting from a random victim.
+			The threads of the same node are tried before the rest. Returns NULL if no task was stolen.
+		*/
+		ThreadTask* ThreadPool::steal_task( const unsigned int index , const unsigned int priority )
+		{
+			size_t thread_count = m_deques.size() / s_PRIORITY_COUNT;
+			ThreadTask* return_value = NULL;
+
+
+			if ( thread_count > 1 )
+			{
+				unsigned int node = m_thread_nodes[index];
+				unsigned int passes = ( m_injection_queues.size() > s_PRIORITY_COUNT  ?  2 : 1 );
+				size_t victim = 0;
+
+
+				// Advance the random generator (xorshift) of the thread.
+				s_worker_random_state ^= s_worker_random_state << 13;
+				s_worker_random_state ^= s_worker_random_state >> 17;
+				s_worker_random_state ^= s_worker_random_state << 5;
+				victim = s_worker_random_state % thread_count;
+
+				// The first pass only visits the threads of the same node and the second pass only visits the rest.
+				for ( unsigned int pass = 0;  pass < passes  &&  return_value == NULL;  ++pass )
+				{
+					for ( size_t i = 0;  i < thread_count  &&  return_value == NULL;  ++i )
+					{
+						TaskDeque* deque = m_deques[victim * s_PRIORITY_COUNT + priority];
+
+
+						if ( victim != index  &&  ( m_thread_nodes[victim] == node ) == ( pass == 0 )  &&  !deque->empty() )
+							return_value = deque->steal();
+
+						victim = ( victim + 1 < thread_count  ?  victim + 1 : 0 );
+					}
+				}
+			}
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of taking the next task the thread at the given index should perform, which is the most urgent task it can find.
+			Returns NULL if there is no task.
+		*/
+		ThreadTask* ThreadPool::next_task( const unsigned int index )
+		{
+			ThreadTask* return_value = NULL;
+
+
+			/*
+				The priority classes are visited from the most urgent one, so a task is only taken if there is no task of a more urgent class.
+				Within a class, the thread prefers its own tasks, then the tasks of the threads outside the pool and then the tasks of the other threads.
+			*/
+			for ( unsigned int priority = 0;  priority < s_PRIORITY_COUNT  &&  return_value == NULL;  ++priority )
+			{
+				return_value = m_deques[index * s_PRIORITY_COUNT + priority]->pop();
+
+				if ( return_value == NULL )
+					return_value = pop_injected_task(m_thread_nodes[index],priority);
+
+				if ( return_value == NULL )
+					return_value = steal_task(index,priority);
+
+				if ( return_value != NULL )
+				{
+					m_queued_tasks.fetch_sub(1,std::memory_order_relaxed);
+					m_queue_depths[priority].fetch_sub(1,std::memory_order_relaxed);
+				}
+			}
+
+
+			return return_value;
+		}
+
+		// A function responsible of performing a task that has been taken, or dropping it if it is obsolete, and deallocating it.
+		void ThreadPool::run_task( ThreadTask* task )
+		{
+			TaskClock::time_point current_time = TaskClock::now();
+			unsigned int priority = task->priority();
+			TaskDropReason reason = CancelledTask;
+
+
+			if ( current_time > task->queue_time() )
+				m_wait_times[priority].record(static_cast<unsigned long long>(std::chrono::duration_cast<std::chrono::microseconds>(current_time - task->queue_time()).count()));
+			else
+				m_wait_times[priority].record(0);
+
+			if ( task->obsolete(current_time,reason) )
+			{
+				m_dropped_tasks[priority].fetch_add(1,std::memory_order_relaxed);
+				task->drop(reason);
+			}
+			else
+				task->perform();
+
+			delete task;
+		}
+
+		/*
+			A function responsible of blocking the thread at the given index until a task is queued or the pool is terminated.
+			The thread spins for a while before it parks, so that a task which is queued shortly after does not wait for the thread to wake up.
+		*/
+		void ThreadPool::wait_for_task( const unsigned int index )
+		{
+			unsigned int spin_count = m_spin_count.load(std::memory_order_relaxed);
+			bool park = false;
+
+
+			for ( unsigned int i = 0;  i < spin_count  &&  m_queued_tasks.load(std::memory_order_relaxed) == 0  &&  m_run.load(std::memory_order_relaxed);  ++i )
+				std::this_thread::yield();
+
+			m_idle_lock.lock();
+			m_idle_workers.push_back(index);
+
+			/*
+				The idle count is raised before the queued task count is checked, while a thread queuing a task raises
+				the queued task count before checking the idle count. Therefore either this thread sees the task,
+				or the queuing thread sees this thread and unparks it.
+			*/
+			m_idle_threads.fetch_add(1,std::memory_order_seq_cst);
+			m_idle_lock.unlock();
+
+			if ( m_queued_tasks.load(std::memory_order_seq_cst) == 0  &&  m_run.load(std::memory_order_acquire) )
+				park = true;
+			else
+			{
+				std::vector<unsigned int>::iterator worker_iterator;
+
+
+				m_idle_lock.lock();
+				worker_iterator = std::find(m_idle_workers.begin(),m_idle_workers.end(),index);
+
+				// If the thread has already been taken off the idle threads, it has been or is about to be unparked, so the permit has to be consumed.
+				if ( worker_iterator != m_idle_workers.end() )
+				{
+					m_idle_workers.erase(worker_iterator);
+					m_idle_threads.fetch_sub(1,std::memory_order_relaxed);
+				}
+				else
+					park = true;
+
+				m_idle_lock.unlock();
+			}
+
+			if ( park )
+				m_parkers[index]->park();
+		}
+
+		// A function responsible of unparking the thread that parked last, if there is one.
+		void ThreadPool::wake_up()
+		{
+			if ( m_idle_threads.load(std::memory_order_seq_cst) > 0 )
+			{
+				ThreadParker* parker = NULL;
+
+
+				m_idle_lock.lock();
+
+				// The thread that parked last is unparked, since its cache is the most likely to still be warm.
+				if ( m_idle_workers.size() > 0 )
+				{
+					parker = m_parkers[m_idle_workers.back()];
+					m_idle_workers.pop_back();
+					m_idle_threads.fetch_sub(1,std::memory_order_relaxed);
+				}
+
+				m_idle_lock.unlock();
+
+				if ( parker != NULL )
+					parker->unpark();
+			}
+		}
+
+		// A function responsible of unparking every parked thread.
+		void ThreadPool::wake_up_all()
+		{
+			m_idle_lock.lock();
+
+			for (
+					std::vector<unsigned int>::iterator worker_iterator = m_idle_workers.begin();
+					worker_iterator != m_idle_workers.end();
+					++worker_iterator
+				)
+			{
+				m_parkers[(*worker_iterator)]->unpark();
 			}
 
-			// Clear the task queue.
-			m_tasks.clear();
+			m_idle_workers.clear();
+			m_idle_threads.store(0,std::memory_order_relaxed);
+			m_idle_lock.unlock();
 		}
 
 
@@ -192,22 +606,75 @@ namespace athena
 			bool return_value = true;
 
 
+			m_lock.lock();
+
+			// A requested amount of threads overrides the amount of hardware threads.
+			if ( m_requested_threads > 0 )
+				max_threads = m_requested_threads;
+
 			// If the maximum number of threads is 0, we will create at least 1 thread.
 			if ( max_threads < 1 )
 				max_threads = 1;
 
-			m_lock.lock();
-
 			// If the thread pool is not operational.
 			if ( !m_initialised )
 			{
+				unsigned int node_count = place_threads(max_threads);
+
+
+				// Allocate an injection queue for each node and priority class.
+				for ( unsigned int i = 0;  i < node_count * s_PRIORITY_COUNT;  ++i )
+				{
+					TaskInjectionQueue* new_queue = new (std::nothrow) TaskInjectionQueue();
+
+
+					if ( new_queue != NULL )
+						m_injection_queues.push_back(new_queue);
+				}
+
+				/*
+					Allocate the deques of the threads, one for each priority class, before spawning any thread, since the threads
+					steal from each other's deques as soon as they start. No thread is spawned unless every injection queue has been allocated.
+				*/
+				for ( unsigned int i = 0;  i < max_threads * s_PRIORITY_COUNT  &&  m_injection_queues.size() == node_count * s_PRIORITY_COUNT;  ++i )
+				{
+					TaskDeque* new_deque = new (std::nothrow) TaskDeque();
+
+
+					if ( new_deque != NULL )
+						m_deques.push_back(new_deque);
+				}
+
+				// Allocate a parker for each thread that has a deque for every priority class.
+				for ( unsigned int i = 0;  i < m_deques.size() / s_PRIORITY_COUNT;  ++i )
+				{
+					ThreadParker* new_parker = new (std::nothrow) ThreadParker();
+
+
+					if ( new_parker == NULL )
+						break;
+
+					m_parkers.push_back(new_parker);
+				}
+
+				// A thread is only spawned if it has a deque for every priority class and a parker.
+				while ( m_deques.size() > m_parkers.size() * s_PRIORITY_COUNT )
+				{
+					delete m_deques.back();
+					m_deques.pop_back();
+				}
+
+				m_idle_workers.reserve(m_parkers.size());
+
+				m_unrestricted_threads.store(0,std::memory_order_relaxed);
+
 				// Set the run variable.
-				m_run = true;
+				m_run.store(true,std::memory_order_release);
 
-				// Spawn the threads.
-				for ( unsigned int i = 0;  i < max_threads;  ++i )
+				// Spawn the threads, one for each set of deques.
+				for ( unsigned int i = 0;  i < m_deques.size() / s_PRIORITY_COUNT;  ++i )
 				{
-					std::thread* new_thread = new (std::nothrow) std::thread(thread_functionality,static_cast<void*>(this));
+					std::thread* new_thread = new (std::nothrow) std::thread(thread_functionality,static_cast<void*>(this),i);
 
 
 					if ( new_thread != NULL )
@@ -215,9 +682,26 @@ namespace athena
 				}
 
 				if ( m_pool.size() > 0 )
+				{
+					/*
+						The pool remains operational even if the timer or the file reader could not be started,
+						in which case the futures they return are abandoned.
+					*/
+					m_timers.startup("athena-timers");
+					m_file_reader.startup("athena-io");
 					m_initialised = true;
+				}
 				else
+				{
+					m_run.store(false,std::memory_order_seq_cst);
+
+					// Wait for any thread that started queuing a task while the run variable was set.
+					while ( m_submitters.load(std::memory_order_seq_cst) > 0 )
+						std::this_thread::yield();
+
+					cleanup();
 					return_value = false;
+				}
 			}
 
 			m_lock.unlock();
@@ -229,14 +713,40 @@ namespace athena
 		// A function responsible of terminating the functionality of the thread pool.
 		void ThreadPool::terminate()
 		{
+			std::vector<ThreadTask*> pending_tasks;
+
+
 			m_lock.lock();
 
 			if ( m_initialised )
 			{
-				// Set the run variable to false.
-				m_run = false;
+				/*
+					Stop the timer and the file reader first, so that the continuations of the futures
+					they abandon are still queued to the threads of the pool.
+				*/
+				m_timers.terminate();
+				m_file_reader.terminate();
+
+				// Set the run variable to false and close the injection queues, so that no more tasks are queued.
+				m_run.store(false,std::memory_order_seq_cst);
+
+				for (
+						std::vector<TaskInjectionQueue*>::iterator queue_iterator = m_injection_queues.begin();
+						queue_iterator != m_injection_queues.end();
+						++queue_iterator
+					)
+				{
+					(*queue_iterator)->close();
+				}
+
 				m_lock.unlock();
-				
+
+				/*
+					Unpark every parked thread. A thread that becomes idle afterwards sees the run variable,
+					since it acquires the lock of the idle threads after the run variable has been set.
+				*/
+				wake_up_all();
+
 				// Wait for every thread to exit.
 				for (
 						std::vector<std::thread*>::iterator thread_iterator = m_pool.begin();
@@ -244,16 +754,20 @@ namespace athena
 						++thread_iterator
 					)
 				{
-					/*
-						Wake all the threads that are waiting on the condition variable.
-						This is a workaround for missed wake up calls.
-					*/
-					m_condition_variable.notify_all();
 					// Join the thread.
 					(*thread_iterator)->join();
 				};
 
+				/*
+					Wait for any thread that is still queuing a task, since it may be using the queues and the parkers.
+					A thread that starts queuing a task afterwards sees the run variable and does not touch them.
+				*/
+				while ( m_submitters.load(std::memory_order_seq_cst) > 0 )
+					std::this_thread::yield();
+
 				m_lock.lock();
+				// Take the tasks that were never performed, so that they are dropped once the lock is released.
+				take_pending_tasks(pending_tasks);
 				// Perform cleanup.
 				cleanup();
 				// Set the initialised flag to false.
@@ -261,6 +775,21 @@ namespace athena
 			}
 
 			m_lock.unlock();
+
+			/*
+				Drop the pending tasks without holding the lock, since abandoning their futures
+				runs any continuations inline and those may use the pool.
+			*/
+			for (
+					std::vector<ThreadTask*>::iterator task_iterator = pending_tasks.begin();
+					task_iterator != pending_tasks.end();
+					++task_iterator
+				)
+			{
+				m_dropped_tasks[(*task_iterator)->priority()].fetch_add(1,std::memory_order_relaxed);
+				(*task_iterator)->drop(TerminatedTask);
+				delete (*task_iterator);
+			}
 		}
 
 
@@ -279,40 +808,263 @@ namespace athena
 		}
 
 
-		// A function responsible of queuing a task.
+		/*
+			A function responsible of queuing a task. A task that is queued by a thread of the pool is pushed to the deque of the thread,
+			while a task that is queued by any other thread is pushed to the injection queue.
+		*/
 		bool ThreadPool::add_task( TaskFunction task , void* parameter , TaskCallbackFunction callback , void* callback_parameter )
+		{
+			return add_task(task,parameter,callback,callback_parameter,TaskOptions());
+		}
+
+		// A function responsible of queuing a task with the given priority class, cancellation, deadline and drop callback.
+		bool ThreadPool::add_task( TaskFunction task , void* parameter , TaskCallbackFunction callback , void* callback_parameter , const TaskOptions& options )
 		{
 			bool return_value = false;
 
 
-			if ( task != NULL )
+			// If the thread pool is operational.
+			if ( task != NULL  &&  m_run.load(std::memory_order_acquire) )
 			{
-				m_lock.lock();
+				// Create the new task to be performed.
+				ThreadTask* new_task = new (std::nothrow) ThreadTask(task,parameter,callback,callback_parameter);
 
-				// If the thread pool is operational.
-				if ( m_run )
+
+				if ( new_task != NULL )
 				{
-					// Create the new task to be performed.
-					ThreadTask* new_task = new (std::nothrow) ThreadTask(task,parameter,callback,callback_parameter);
+					new_task->options(options);
+					return_value = queue_task(new_task);
+
+					if ( !return_value )
+						delete new_task;
+				}
+			}
 
 
-					if ( new_task != NULL )
-					{
-						// Insert the new task to the task queue.
-						m_tasks.push_back(new_task);
-						// Wake up a suspended thread (If any thread is suspended).
-						m_condition_variable.notify_one();
-						return_value = true;
-					}
+			return return_value;
+		}
+
+		/*
+			A function responsible of queuing a task that has already been allocated. The pool takes the ownership of the task
+			and deallocates it once it is performed. Returns false if the pool is not operational, in which case the caller keeps the ownership.
+		*/
+		bool ThreadPool::queue_task( ThreadTask* task )
+		{
+			bool return_value = false;
+
+
+			// The submitter count is raised before the run variable is read, so that terminating the pool waits for the task to be queued.
+			m_submitters.fetch_add(1,std::memory_order_seq_cst);
+
+			if ( task != NULL  &&  m_run.load(std::memory_order_seq_cst) )
+			{
+				unsigned int priority = task->priority();
+
+
+				task->queue_time(TaskClock::now());
+
+				// The queued task count is raised first, so that a thread that is about to wait does not miss the task.
+				m_queue_depths[priority].fetch_add(1,std::memory_order_relaxed);
+				m_queued_tasks.fetch_add(1,std::memory_order_seq_cst);
+
+				// If the calling thread belongs to the pool, push the task to its own deque of the priority class of the task.
+				if ( s_worker_pool == this  &&  s_worker_deques != NULL )
+					return_value = s_worker_deques[priority]->push(task);
+
+				// Otherwise, or if the deque could not grow, insert the new task to the injection queue of the node of the calling thread.
+				if ( !return_value )
+				{
+					unsigned int node = ( s_worker_pool == this  ?  m_thread_nodes[s_worker_index] : calling_node() );
+
+
+					return_value = m_injection_queues[node * s_PRIORITY_COUNT + priority]->push(task);
 				}
 
-				m_lock.unlock();
+				// Wake up a suspended thread (If any thread is suspended).
+				if ( return_value )
+					wake_up();
+				else
+				{
+					m_queued_tasks.fetch_sub(1,std::memory_order_relaxed);
+					m_queue_depths[priority].fetch_sub(1,std::memory_order_relaxed);
+				}
+			}
+
+			m_submitters.fetch_sub(1,std::memory_order_seq_cst);
+
+
+			return return_value;
+		}
+
+		// A function returning a future that is fulfilled once the given duration has passed. The future is abandoned if the pool is not operational.
+		TaskFuture<void> ThreadPool::delay( const TaskClock::duration& duration )
+		{
+			return m_timers.schedule(TaskClock::now() + duration);
+		}
+
+		// A function returning a future that is fulfilled once the given time has come. The future is abandoned if the pool is not operational.
+		TaskFuture<void> ThreadPool::delay_until( const TaskClock::time_point& time )
+		{
+			return m_timers.schedule(time);
+		}
+
+		/*
+			A function returning a future of the contents of the whole file at the given path, which is read without occupying a thread of the pool.
+			The future is abandoned if the pool is not operational or the file could not be read.
+		*/
+		TaskFuture<std::string> ThreadPool::read_file( const std::string& path )
+		{
+			return m_file_reader.read(path);
+		}
+
+		/*
+			A function responsible of performing a single queued task on the calling thread, if it is a thread of the pool.
+			Threads outside the pool do not perform tasks, since a queued task may keep its thread for as long as the pool is operational.
+			Returns false if there was no task to perform.
+		*/
+		bool ThreadPool::perform_task()
+		{
+			ThreadTask* task = NULL;
+			bool return_value = false;
+
+
+			if ( s_worker_pool == this  &&  s_worker_deques != NULL  &&  m_run.load(std::memory_order_acquire) )
+			{
+				task = next_task(s_worker_index);
+
+				if ( task != NULL )
+				{
+					run_task(task);
+					return_value = true;
+				}
 			}
 
 
 			return return_value;
 		}
 
+
+		// A function responsible of setting the amount of threads that are spawned when the pool is started. Zero (0), the default, spawns one thread for each hardware thread.
+		void ThreadPool::thread_count( const unsigned int count )
+		{
+			m_lock.lock();
+			m_requested_threads = count;
+			m_lock.unlock();
+		}
+
+		// A function responsible of setting whether every thread is pinned to a single processor when the pool is started.
+		void ThreadPool::pin_threads( const bool value )
+		{
+			m_lock.lock();
+			m_pin_threads = value;
+			m_lock.unlock();
+		}
+
+		// A function responsible of setting whether the threads are grouped by NUMA node when the pool is started.
+		void ThreadPool::numa_aware( const bool value )
+		{
+			m_lock.lock();
+			m_numa_aware = value;
+			m_lock.unlock();
+		}
+
+
+		/*
+			A function responsible of setting the amount of rounds a thread that runs out of tasks spins for before it parks.
+			Spinning lowers the latency of tasks that are queued in bursts at the cost of processor time. Zero (0) parks the thread immediately.
+		*/
+		void ThreadPool::spin_count( const unsigned int count )
+		{
+			m_spin_count.store(count,std::memory_order_relaxed);
+		}
+
+
+		// A function returning the amount of threads of the pool.
+		unsigned int ThreadPool::thread_count()
+		{
+			unsigned int return_value = 0;
+
+
+			m_lock.lock();
+			return_value = m_pool.size();
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		// A function returning whether every thread is pinned to a single processor when the pool is started.
+		bool ThreadPool::pin_threads()
+		{
+			bool return_value = false;
+
+
+			m_lock.lock();
+			return_value = m_pin_threads;
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		// A function returning whether the threads are grouped by NUMA node when the pool is started.
+		bool ThreadPool::numa_aware()
+		{
+			bool return_value = false;
+
+
+			m_lock.lock();
+			return_value = m_numa_aware;
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		// A function returning the amount of rounds a thread that runs out of tasks spins for before it parks.
+		unsigned int ThreadPool::spin_count() const
+		{
+			return m_spin_count.load(std::memory_order_relaxed);
+		}
+
+		// A function returning the amount of nodes the threads of the pool are grouped in.
+		unsigned int ThreadPool::node_count()
+		{
+			unsigned int return_value = 0;
+
+
+			m_lock.lock();
+			return_value = static_cast<unsigned int>(m_injection_queues.size() / s_PRIORITY_COUNT);
+			m_lock.unlock();
+
+
+			return return_value;
+		}
+
+		// A function returning the amount of threads of the pool that could not be restricted to their processors.
+		unsigned int ThreadPool::unrestricted_thread_count() const
+		{
+			return m_unrestricted_threads.load(std::memory_order_relaxed);
+		}
+
+		// A function returning the approximate amount of tasks of the given priority class that are queued and not yet taken by a thread.
+		size_t ThreadPool::task_queue_depth( const TaskPriority priority ) const
+		{
+			return ( static_cast<unsigned int>(priority) < s_PRIORITY_COUNT  ?  m_queue_depths[priority].load(std::memory_order_relaxed) : 0 );
+		}
+
+		// A function returning the histogram of the time the tasks of the given priority class have waited before a thread took them, in microseconds.
+		const utility::Histogram& ThreadPool::task_wait_time( const TaskPriority priority ) const
+		{
+			return m_wait_times[( static_cast<unsigned int>(priority) < s_PRIORITY_COUNT  ?  priority : NormalTaskPriority )];
+		}
+
+		// A function returning the amount of tasks of the given priority class that have been dropped without being performed.
+		unsigned long long ThreadPool::dropped_task_count( const TaskPriority priority ) const
+		{
+			return ( static_cast<unsigned int>(priority) < s_PRIORITY_COUNT  ?  m_dropped_tasks[priority].load(std::memory_order_relaxed) : 0 );
+		}
+
 	} /* core */
 
 } /* athena */
\ No newline at end of file
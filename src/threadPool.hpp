@@ -2,12 +2,25 @@
 #define ATHENA_CORE_THREADPOOL_HPP
 
 #include "definitions.hpp"
+#include <string>
 #include <vector>
 #include <deque>
+#include <atomic>
 #include <mutex>
-#include <condition_variable>
 #include <thread>
+#include <functional>
+#include <type_traits>
+#include <utility>
 #include "athena.hpp"
+#include "threadTask.hpp"
+#include "taskDeque.hpp"
+#include "taskInjectionQueue.hpp"
+#include "threadParker.hpp"
+#include "taskTimerQueue.hpp"
+#include "taskFileReader.hpp"
+#include "taskFuture.hpp"
+#include "taskCancellation.hpp"
+#include "histogram.hpp"
 
 
 
@@ -17,54 +30,50 @@ namespace athena
 	namespace core
 	{
 
-		/*
-			A type definition that is used to define the function that is 
-			considered a "task" for the thread pool threads.
-		*/
-		typedef int (*TaskFunction)( void * parameter );
-		/*
-			A type definition that is used to define the function that is called
-			when a task is completed.
-		*/
-		typedef void (*TaskCallbackFunction)( const int exit_code , void* parameter );
-
-		
-		/*
-			The struct that is used to store the task of the thread and it's
-			single parameter.
-		*/
-		struct ThreadTask
-		{
-			TaskFunction m_function;
-			TaskCallbackFunction m_callback;
-			void* m_parameter;
-			void* m_callback_parameter;
-
-
-			ThreadTask(
-						TaskFunction function ,
-						void* parameter ,
-						TaskCallbackFunction callback ,
-						void* callback_parameter
-					) :
-				m_function(function) ,
-				m_callback(callback) , 
-				m_parameter(parameter) ,
-				m_callback_parameter(callback_parameter)
-			{
-			};
-		};
-
-
 		/*
 			A class representing and handling the thread pool that the 
 			engine is using to perform various tasks. In the event that the 
 			hardware supports only one (1) thread the thread pool will have a 
 			size of one (1), resulting in two (2) total threads including the 
 			main thread of the application.
+			Every thread of the pool owns a work-stealing deque. Tasks that are queued by a thread of the pool
+			are pushed to its own deque and popped in LIFO order, so the thread continues with the work it
+			has just created. Tasks that are queued by any other thread are pushed to an injection queue.
+			A thread that runs out of tasks takes them from the injection queues, and then steals them
+			from the deques of the other threads, starting from a random victim.
+			The threads can be pinned to processors and grouped by NUMA node before the pool is started. A NUMA-aware
+			pool keeps an injection queue for each node, and its threads are restricted to the processors of their node,
+			prefer the injection queue of their node and steal from the threads of their node first. Every thread is named
+			after its index (athena-worker-N), on the platforms that support thread names.
+			Every task belongs to a priority class, and every thread and node keeps a deque and an injection queue
+			for each class. A thread looking for work takes the most urgent task it can find, so critical tasks overtake
+			queued tasks of lower classes. A task can be given a cancellation handle and a deadline, in which case it is
+			dropped, and its drop callback is called, if it is cancelled or its deadline passes before a thread takes it.
+			Any tasks that are still pending when the pool is terminated are dropped the same way.
+			The amount of queued tasks, the time the tasks have waited and the amount of dropped tasks are kept for every class.
+			A thread that runs out of tasks spins, yielding its processor, for a tunable amount of rounds before it parks.
+			Every thread parks on its own parker and a queued task unparks a single idle thread, the one that parked last,
+			so a burst of tasks wakes no more threads than it needs and a lone task does not wake every idle thread.
+			Besides task functions, any callable can be submitted along with its arguments, in which case a future of its
+			result is returned. Callables that are small enough are stored inside the task, so submitting them requires
+			no allocation besides the state of the result.
+			Tasks are expected to return in a timely manner. A loop that runs for as long as a manager is operational
+			should be run by a ServiceThread instead, so that it does not permanently occupy a thread of the pool.
+			Likewise, a task should not block waiting for time to pass or for a file to be read. The pool offers futures
+			that are fulfilled by a timer and by a file reader, each running on its own service thread, so that a task
+			can continue with the result instead. With a C++20 compiler, taskCoroutine.hpp lets any function returning
+			a future be a coroutine that co_awaits futures, so a few threads can drive thousands of suspended jobs.
 		*/
 		class ThreadPool
 		{
+			public:
+
+				// The amount of priority classes of the tasks.
+				static const unsigned int s_PRIORITY_COUNT = 3;
+				// The default amount of rounds a thread spins for before it parks.
+				static const unsigned int s_DEFAULT_SPIN_COUNT = 64;
+
+
 			private:
 
 				// The single instance of the class.
@@ -73,24 +82,76 @@ namespace athena
 				static std::mutex s_instance_lock;
 
 
+				// The pool the current thread belongs to, if the thread belongs to a pool.
+				static ATHENA_THREAD_LOCAL ThreadPool* s_worker_pool;
+				// The deques of the current thread, one for each priority class, if the thread belongs to a pool.
+				static ATHENA_THREAD_LOCAL TaskDeque** s_worker_deques;
+				// The index of the current thread in its pool, if the thread belongs to a pool.
+				static ATHENA_THREAD_LOCAL unsigned int s_worker_index;
+				// The state of the random generator of the current thread that is used to pick the victims to steal from.
+				static ATHENA_THREAD_LOCAL unsigned int s_worker_random_state;
+
+
 				// The pool of threads.
 				std::vector<std::thread*> m_pool;
-				// The pending task list.
-				std::deque<ThreadTask*> m_tasks;
+				/*
+					The work-stealing deques of the threads, one for each thread and priority class.
+					The deques of each thread are consecutive, ordered from the most to the least urgent class.
+				*/
+				std::vector<TaskDeque*> m_deques;
+				/*
+					The injection queues, one for each node and priority class, holding the tasks that have been queued by threads outside the pool.
+					The queues of each node are consecutive, ordered from the most to the least urgent class.
+				*/
+				std::vector<TaskInjectionQueue*> m_injection_queues;
+				// The node of every thread.
+				std::vector<unsigned int> m_thread_nodes;
+				// The processors every thread is restricted to. A thread without processors is not restricted.
+				std::vector< std::vector<unsigned int> > m_thread_processors;
+				// The amount of threads that could not be restricted to their processors.
+				std::atomic<unsigned int> m_unrestricted_threads;
+				// The node of every processor, which is used to pick the injection queue of a thread outside the pool.
+				std::vector<unsigned int> m_processor_nodes;
+				// The amount of tasks that have been queued and not yet taken by a thread.
+				std::atomic<size_t> m_queued_tasks;
+				// The amount of threads that are queuing a task. The queues and the parkers are kept until it drops to zero (0).
+				std::atomic<unsigned int> m_submitters;
+				// The amount of tasks of each priority class that have been queued and not yet taken by a thread.
+				std::atomic<size_t> m_queue_depths[s_PRIORITY_COUNT];
+				// The histograms of the time the tasks of each priority class have waited before a thread took them, in microseconds.
+				utility::Histogram m_wait_times[s_PRIORITY_COUNT];
+				// The amount of tasks of each priority class that have been dropped without being performed.
+				std::atomic<unsigned long long> m_dropped_tasks[s_PRIORITY_COUNT];
+				// The parkers of the threads. The parker at each index is owned by the thread at the same index.
+				std::vector<ThreadParker*> m_parkers;
+				// The indices of the threads that are parked or about to park, in the order they became idle.
+				std::vector<unsigned int> m_idle_workers;
+				// The amount of threads that are parked or about to park.
+				std::atomic<unsigned int> m_idle_threads;
+				// The amount of rounds a thread spins for before it parks.
+				std::atomic<unsigned int> m_spin_count;
+				// The timers that fulfil the futures returned by delay.
+				TaskTimerQueue m_timers;
+				// The reader that fulfils the futures returned by read_file.
+				TaskFileReader m_file_reader;
 				// A lock that is used to handle concurrency issues.
 				std::mutex m_lock;
-				// A lock that is used to signal waiting threads.
-				std::mutex m_wait_lock;
-				// A condition variable that is used to manage the waiting threads.
-				std::condition_variable_any m_condition_variable;
+				// A lock that is used to handle concurrency issues for the idle threads.
+				std::mutex m_idle_lock;
+				// The amount of threads that are spawned when the pool is started. Zero (0) spawns one thread for each hardware thread.
+				unsigned int m_requested_threads;
+				// A variable holding whether every thread is pinned to a single processor when the pool is started.
+				bool m_pin_threads;
+				// A variable holding whether the threads are grouped by NUMA node when the pool is started.
+				bool m_numa_aware;
 				// A variable holding whether the class has been initialised.
 				bool m_initialised;
 				// A variable holding whether the class is operational.
-				bool m_run;
+				std::atomic<bool> m_run;
 
 
 				// The function that is used to perform the functionality of each thread.
-				static void thread_functionality( void* parameter );
+				static void thread_functionality( void* parameter , const unsigned int index );
 
 
 				// The constructor of the class.
@@ -101,6 +162,38 @@ namespace athena
 
 				// A function responsible of performing any needed cleanup.
 				void cleanup();
+				// A function responsible of moving every pending task out of the deques and the injection queues to the given vector.
+				void take_pending_tasks( std::vector<ThreadTask*>& tasks );
+				/*
+					A function responsible of assigning every thread that is about to be spawned to a node and to the processors it is restricted to.
+					Returns the amount of nodes.
+				*/
+				unsigned int place_threads( const unsigned int thread_count );
+				// A function returning the node of the processor the calling thread is running on.
+				unsigned int calling_node() const;
+				// A function responsible of taking a task of the given priority class from the injection queue of the given node, or of any other node. Returns NULL if the queues are empty.
+				ThreadTask* pop_injected_task( const unsigned int node , const unsigned int priority );
+				/*
+					A function responsible of stealing a task of the given priority class from the deque of another thread, starting from a random victim.
+					The threads of the same node are tried before the rest. Returns NULL if no task was stolen.
+				*/
+				ThreadTask* steal_task( const unsigned int index , const unsigned int priority );
+				/*
+					A function responsible of taking the next task the thread at the given index should perform, which is the most urgent task it can find.
+					Returns NULL if there is no task.
+				*/
+				ThreadTask* next_task( const unsigned int index );
+				// A function responsible of performing a task that has been taken, or dropping it if it is obsolete, and deallocating it.
+				void run_task( ThreadTask* task );
+				/*
+					A function responsible of blocking the thread at the given index until a task is queued or the pool is terminated.
+					The thread spins for a while before it parks, so that a task which is queued shortly after does not wait for the thread to wake up.
+				*/
+				void wait_for_task( const unsigned int index );
+				// A function responsible of unparking the thread that parked last, if there is one.
+				void wake_up();
+				// A function responsible of unparking every parked thread.
+				void wake_up_all();
 
 
 			protected:
@@ -128,8 +221,78 @@ namespace athena
 				ATHENA_DLL static ThreadPool* get();
 
 
-				// A function responsible of queuing a task.
+				/*
+					A function responsible of queuing a task. A task that is queued by a thread of the pool is pushed to the deque of the thread,
+					while a task that is queued by any other thread is pushed to the injection queue.
+				*/
 				ATHENA_DLL bool add_task( TaskFunction task , void* parameter , TaskCallbackFunction callback , void* callback_parameter );
+				// A function responsible of queuing a task with the given priority class, cancellation, deadline and drop callback.
+				ATHENA_DLL bool add_task( TaskFunction task , void* parameter , TaskCallbackFunction callback , void* callback_parameter , const TaskOptions& options );
+				/*
+					A function responsible of queuing a task that has already been allocated. The pool takes the ownership of the task
+					and deallocates it once it is performed. Returns false if the pool is not operational, in which case the caller keeps the ownership.
+				*/
+				ATHENA_DLL bool queue_task( ThreadTask* task );
+				/*
+					A function responsible of queuing the given callable along with its arguments, which are copied.
+					Returns a future of the result of the callable, which is abandoned if the callable could not be queued.
+				*/
+				template <typename Function , typename... Arguments>
+				TaskFuture<typename std::result_of<typename std::decay<Function>::type(typename std::decay<Arguments>::type...)>::type> submit( Function&& function , Arguments&&... arguments );
+				/*
+					A function responsible of queuing the given callable along with its arguments, with the given priority class, cancellation, deadline and drop callback.
+					Returns a future of the result of the callable, which is abandoned if the callable could not be queued or is dropped.
+				*/
+				template <typename Function , typename... Arguments>
+				TaskFuture<typename std::result_of<typename std::decay<Function>::type(typename std::decay<Arguments>::type...)>::type> submit_with_options( const TaskOptions& options , Function&& function , Arguments&&... arguments );
+				// A function returning a future that is fulfilled once the given duration has passed. The future is abandoned if the pool is not operational.
+				ATHENA_DLL TaskFuture<void> delay( const TaskClock::duration& duration );
+				// A function returning a future that is fulfilled once the given time has come. The future is abandoned if the pool is not operational.
+				ATHENA_DLL TaskFuture<void> delay_until( const TaskClock::time_point& time );
+				/*
+					A function returning a future of the contents of the whole file at the given path, which is read without occupying a thread of the pool.
+					The future is abandoned if the pool is not operational or the file could not be read.
+				*/
+				ATHENA_DLL TaskFuture<std::string> read_file( const std::string& path );
+				/*
+					A function responsible of performing a single queued task on the calling thread, if it is a thread of the pool.
+					Threads outside the pool do not perform tasks, since a queued task may keep its thread for as long as the pool is operational.
+					Returns false if there was no task to perform.
+				*/
+				ATHENA_DLL bool perform_task();
+
+
+				// A function responsible of setting the amount of threads that are spawned when the pool is started. Zero (0), the default, spawns one thread for each hardware thread.
+				ATHENA_DLL void thread_count( const unsigned int count );
+				// A function responsible of setting whether every thread is pinned to a single processor when the pool is started.
+				ATHENA_DLL void pin_threads( const bool value );
+				// A function responsible of setting whether the threads are grouped by NUMA node when the pool is started.
+				ATHENA_DLL void numa_aware( const bool value );
+				/*
+					A function responsible of setting the amount of rounds a thread that runs out of tasks spins for before it parks.
+					Spinning lowers the latency of tasks that are queued in bursts at the cost of processor time. Zero (0) parks the thread immediately.
+				*/
+				ATHENA_DLL void spin_count( const unsigned int count );
+
+
+				// A function returning the amount of threads of the pool.
+				ATHENA_DLL unsigned int thread_count();
+				// A function returning whether every thread is pinned to a single processor when the pool is started.
+				ATHENA_DLL bool pin_threads();
+				// A function returning whether the threads are grouped by NUMA node when the pool is started.
+				ATHENA_DLL bool numa_aware();
+				// A function returning the amount of rounds a thread that runs out of tasks spins for before it parks.
+				ATHENA_DLL unsigned int spin_count() const;
+				// A function returning the amount of nodes the threads of the pool are grouped in.
+				ATHENA_DLL unsigned int node_count();
+				// A function returning the amount of threads of the pool that could not be restricted to their processors.
+				ATHENA_DLL unsigned int unrestricted_thread_count() const;
+				// A function returning the approximate amount of tasks of the given priority class that are queued and not yet taken by a thread.
+				ATHENA_DLL size_t task_queue_depth( const TaskPriority priority ) const;
+				// A function returning the histogram of the time the tasks of the given priority class have waited before a thread took them, in microseconds.
+				ATHENA_DLL const utility::Histogram& task_wait_time( const TaskPriority priority ) const;
+				// A function returning the amount of tasks of the given priority class that have been dropped without being performed.
+				ATHENA_DLL unsigned long long dropped_task_count( const TaskPriority priority ) const;
 		};
 
 	} /* core */
@@ -137,5 +300,8 @@ namespace athena
 } /* athena */
 
 
+#include "threadPool.inl"
+
+
 
 #endif /* ATHENA_CORE_THREADPOOL_HPP */
\ No newline at end of file
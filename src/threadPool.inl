@@ -0,0 +1,68 @@
+#ifndef ATHENA_CORE_THREADPOOL_INL
+#define ATHENA_CORE_THREADPOOL_INL
+
+#ifndef ATHENA_CORE_THREADPOOL_HPP
+	#error "threadPool.hpp must be included before threadPool.inl"
+#endif /* ATHENA_CORE_THREADPOOL_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A function responsible of queuing the given callable along with its arguments, which are copied.
+			Returns a future of the result of the callable, which is abandoned if the callable could not be queued.
+		*/
+		template <typename Function , typename... Arguments>
+		TaskFuture<typename std::result_of<typename std::decay<Function>::type(typename std::decay<Arguments>::type...)>::type> ThreadPool::submit( Function&& function , Arguments&&... arguments )
+		{
+			return submit_with_options(TaskOptions(),std::forward<Function>(function),std::forward<Arguments>(arguments)...);
+		}
+
+		/*
+			A function responsible of queuing the given callable along with its arguments, with the given priority class, cancellation, deadline and drop callback.
+			Returns a future of the result of the callable, which is abandoned if the callable could not be queued or is dropped.
+		*/
+		template <typename Function , typename... Arguments>
+		TaskFuture<typename std::result_of<typename std::decay<Function>::type(typename std::decay<Arguments>::type...)>::type> ThreadPool::submit_with_options( const TaskOptions& options , Function&& function , Arguments&&... arguments )
+		{
+			typedef typename std::result_of<typename std::decay<Function>::type(typename std::decay<Arguments>::type...)>::type ResultType;
+			typedef decltype(std::bind(std::forward<Function>(function),std::forward<Arguments>(arguments)...)) CallableType;
+
+			TaskState<ResultType>* state = new (std::nothrow) TaskState<ResultType>();
+			TaskFuture<ResultType> return_value;
+
+
+			if ( state != NULL )
+			{
+				ThreadTask* task = new (std::nothrow) ThreadTask();
+
+
+				return_value = TaskFuture<ResultType>(state);
+
+				if ( task != NULL )
+					task->options(options);
+
+				// A task that is deallocated without being performed abandons the result.
+				if ( task == NULL  ||  !task->callable(TaskJob<ResultType,CallableType>(state,std::bind(std::forward<Function>(function),std::forward<Arguments>(arguments)...)))  ||  !queue_task(task) )
+				{
+					delete task;
+					state->abandon();
+				}
+			}
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_THREADPOOL_INL */
\ No newline at end of file
@@ -0,0 +1,165 @@
+#include "threadTask.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The constructor of the struct. The task has no cancellation, deadline or drop callback.
+		TaskOptions::TaskOptions( const TaskPriority priority ) :
+			m_priority(priority) ,
+			m_cancellation() ,
+			m_deadline() ,
+			m_drop_callback(NULL) ,
+			m_drop_parameter(NULL)
+		{
+		}
+
+
+		// The pool the tasks are allocated from.
+		utility::ObjectPool ThreadTask::s_pool(sizeof(ThreadTask));
+
+
+		// A constructor of the class that creates a task without anything to perform. A callable should be given to the task.
+		ThreadTask::ThreadTask() :
+			m_function(NULL) ,
+			m_callback(NULL) ,
+			m_parameter(NULL) ,
+			m_callback_parameter(NULL) ,
+			m_invoke(NULL) ,
+			m_next(NULL) ,
+			m_priority(NormalTaskPriority) ,
+			m_cancellation(NULL) ,
+			m_deadline() ,
+			m_queue_time() ,
+			m_drop_callback(NULL) ,
+			m_drop_parameter(NULL) ,
+			m_storage()
+		{
+		}
+
+		// A constructor of the class that creates a task that performs the given task function, followed by the given callback.
+		ThreadTask::ThreadTask( TaskFunction function , void* parameter , TaskCallbackFunction callback , void* callback_parameter ) :
+			m_function(function) ,
+			m_callback(callback) ,
+			m_parameter(parameter) ,
+			m_callback_parameter(callback_parameter) ,
+			m_invoke(NULL) ,
+			m_next(NULL) ,
+			m_priority(NormalTaskPriority) ,
+			m_cancellation(NULL) ,
+			m_deadline() ,
+			m_queue_time() ,
+			m_drop_callback(NULL) ,
+			m_drop_parameter(NULL) ,
+			m_storage()
+		{
+		}
+
+		// The destructor of the class. The callable of a task that has not been performed is destroyed without being performed.
+		ThreadTask::~ThreadTask()
+		{
+			if ( m_invoke != NULL )
+				(*m_invoke)(this,false);
+
+			if ( m_cancellation != NULL )
+				m_cancellation->release();
+		}
+
+		// The allocation function of the class, which allocates the object from the pool of the class.
+		void* ThreadTask::operator new( size_t size , const std::nothrow_t& ) throw()
+		{
+			return s_pool.allocate(size);
+		}
+
+		// The deallocation function of the class, which returns the object to the pool of the class.
+		void ThreadTask::operator delete( void* pointer , size_t size )
+		{
+			s_pool.deallocate(pointer,size);
+		}
+
+		// The deallocation function that is called if the constructor throws after the object was allocated from the pool of the class.
+		void ThreadTask::operator delete( void* pointer , const std::nothrow_t& ) throw()
+		{
+			s_pool.deallocate(pointer,sizeof(ThreadTask));
+		}
+
+		// A function returning the pool the objects of the class are allocated from.
+		const utility::ObjectPool& ThreadTask::pool()
+		{
+			return s_pool;
+		}
+
+
+		// A function responsible of setting the priority class, cancellation, deadline and drop callback of the task.
+		void ThreadTask::options( const TaskOptions& options )
+		{
+			TaskCancellationState* cancellation = options.m_cancellation.state();
+
+
+			if ( cancellation != NULL )
+				cancellation->acquire();
+
+			if ( m_cancellation != NULL )
+				m_cancellation->release();
+
+			// An unknown priority class is treated as the normal class.
+			m_priority = ( static_cast<unsigned int>(options.m_priority) <= BackgroundTaskPriority  ?  options.m_priority : NormalTaskPriority );
+			m_cancellation = cancellation;
+			m_deadline = options.m_deadline;
+			m_drop_callback = options.m_drop_callback;
+			m_drop_parameter = options.m_drop_parameter;
+		}
+
+		// A function responsible of performing the task. A task is only performed once.
+		void ThreadTask::perform()
+		{
+			if ( m_invoke != NULL )
+			{
+				TaskInvokeFunction invoke = m_invoke;
+
+
+				m_invoke = NULL;
+				(*invoke)(this,true);
+			}
+			else if ( m_function != NULL )
+			{
+				// A variable that is used to hold the exit code of the task.
+				int exit_code = (*m_function)(m_parameter);
+
+
+				m_function = NULL;
+
+				// If a callback function was provided.
+				if ( m_callback != NULL )
+					(*m_callback)(exit_code,m_callback_parameter); // Call the callback function.
+			}
+		}
+
+		/*
+			A function responsible of dropping the task without performing it. The callable of the task is destroyed
+			and the drop callback is called with the given reason, instead of the task function and its callback.
+		*/
+		void ThreadTask::drop( const TaskDropReason reason )
+		{
+			if ( m_invoke != NULL )
+			{
+				TaskInvokeFunction invoke = m_invoke;
+
+
+				m_invoke = NULL;
+				(*invoke)(this,false);
+			}
+
+			m_function = NULL;
+
+			if ( m_drop_callback != NULL )
+				(*m_drop_callback)(reason,m_drop_parameter);
+		}
+
+	} /* core */
+
+} /* athena */
\ No newline at end of file
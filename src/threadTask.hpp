@@ -0,0 +1,228 @@
+#ifndef ATHENA_CORE_THREADTASK_HPP
+#define ATHENA_CORE_THREADTASK_HPP
+
+#include "definitions.hpp"
+#include <cstddef>
+#include <chrono>
+#include <new>
+#include <type_traits>
+#include <utility>
+#include "objectPool.hpp"
+#include "taskCancellation.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A type definition that is used to define the function that is 
+			considered a "task" for the thread pool threads.
+		*/
+		typedef int (*TaskFunction)( void * parameter );
+		/*
+			A type definition that is used to define the function that is called
+			when a task is completed.
+		*/
+		typedef void (*TaskCallbackFunction)( const int exit_code , void* parameter );
+
+
+		// A type definition that defines the clock that is used for the deadlines and the wait time of the tasks.
+		typedef std::chrono::steady_clock TaskClock;
+
+
+		// An enumeration holding the priority classes a task can belong to, from the most to the least urgent.
+		enum TaskPriority
+		{
+			CriticalTaskPriority = 0 ,
+			NormalTaskPriority ,
+			BackgroundTaskPriority
+		};
+
+		// An enumeration holding the reasons a task can be dropped without being performed. TerminatedTask is used for the tasks that are pending when the pool is terminated.
+		enum TaskDropReason
+		{
+			CancelledTask = 0 ,
+			ExpiredTask ,
+			TerminatedTask
+		};
+
+
+		/*
+			A type definition that is used to define the function that is called
+			when a task is dropped without being performed.
+		*/
+		typedef void (*TaskDropFunction)( const TaskDropReason reason , void* parameter );
+
+
+		/*
+			A struct holding the options a task is queued with. A task that has been cancelled, or whose deadline
+			has passed, before a thread of the pool takes it is dropped, in which case the drop callback is called
+			instead of the task function and its callback. A default time point means that the task has no deadline.
+		*/
+		struct TaskOptions
+		{
+			TaskPriority m_priority;
+			TaskCancellation m_cancellation;
+			TaskClock::time_point m_deadline;
+			TaskDropFunction m_drop_callback;
+			void* m_drop_parameter;
+
+
+			// The constructor of the struct. The task has no cancellation, deadline or drop callback.
+			ATHENA_DLL explicit TaskOptions( const TaskPriority priority = NormalTaskPriority );
+		};
+
+
+		class ThreadTask;
+
+
+		/*
+			A type definition that is used to define the function that performs the callable of a task, if requested,
+			and destroys it.
+		*/
+		typedef void (*TaskInvokeFunction)( ThreadTask* task , const bool perform );
+
+
+		/*
+			A union holding the callable of a task. The union is aligned for every fundamental type,
+			so any callable that is not over-aligned and fits in the union is stored inline.
+		*/
+		union ThreadTaskStorage
+		{
+			char m_bytes[64];
+			long long m_integer;
+			long double m_real;
+			void* m_pointer;
+		};
+
+
+		/*
+			A class representing a task of the thread pool. A task either performs a task function with its single
+			parameter, followed by an optional callback, or a callable object of any type.
+			Callables that fit in the storage of the task are stored inline, while larger callables are allocated
+			on their own. Tasks are allocated from a pool, so queuing a task usually requires no allocation.
+		*/
+		class ThreadTask
+		{
+			private:
+
+				// The pool the tasks are allocated from.
+				static utility::ObjectPool s_pool;
+
+
+				// The task function.
+				TaskFunction m_function;
+				// The function that is called when the task function is completed.
+				TaskCallbackFunction m_callback;
+				// The parameter of the task function.
+				void* m_parameter;
+				// The parameter of the callback function.
+				void* m_callback_parameter;
+				// The function that performs and destroys the callable of the task, if the task holds a callable.
+				TaskInvokeFunction m_invoke;
+				// The next task of the list the task belongs to.
+				ThreadTask* m_next;
+				// The priority class of the task.
+				TaskPriority m_priority;
+				// The shared state of the cancellation of the task, if the task can be cancelled.
+				TaskCancellationState* m_cancellation;
+				// The time after which the task is dropped. A default time point means that the task has no deadline.
+				TaskClock::time_point m_deadline;
+				// The time the task was queued.
+				TaskClock::time_point m_queue_time;
+				// The function that is called when the task is dropped.
+				TaskDropFunction m_drop_callback;
+				// The parameter of the drop function.
+				void* m_drop_parameter;
+				// The storage of the callable of the task.
+				ThreadTaskStorage m_storage;
+
+
+				// The copy constructor is not available.
+				ThreadTask( const ThreadTask& );
+				// The assignment operator is not available.
+				ThreadTask& operator=( const ThreadTask& );
+
+
+				// The function that performs and destroys a callable that is stored inline.
+				template <typename Callable>
+				static void invoke_inline( ThreadTask* task , const bool perform );
+				// The function that performs and destroys a callable that is allocated on its own.
+				template <typename Callable>
+				static void invoke_allocated( ThreadTask* task , const bool perform );
+
+				// A function responsible of storing a callable inline.
+				template <typename Function>
+				bool store( Function&& function , std::true_type inline_storage );
+				// A function responsible of storing a callable that does not fit in the storage of the task. Returns false if the allocation fails.
+				template <typename Function>
+				bool store( Function&& function , std::false_type inline_storage );
+
+
+			public:
+
+				// A constructor of the class that creates a task without anything to perform. A callable should be given to the task.
+				ATHENA_DLL ThreadTask();
+				// A constructor of the class that creates a task that performs the given task function, followed by the given callback.
+				ATHENA_DLL ThreadTask( TaskFunction function , void* parameter , TaskCallbackFunction callback , void* callback_parameter );
+				// The destructor of the class. The callable of a task that has not been performed is destroyed without being performed.
+				ATHENA_DLL ~ThreadTask();
+
+				// The allocation function of the class, which allocates the object from the pool of the class.
+				ATHENA_DLL static void* operator new( size_t size , const std::nothrow_t& ) throw();
+				// The deallocation function of the class, which returns the object to the pool of the class.
+				ATHENA_DLL static void operator delete( void* pointer , size_t size );
+				// The deallocation function that is called if the constructor throws after the object was allocated from the pool of the class.
+				ATHENA_DLL static void operator delete( void* pointer , const std::nothrow_t& ) throw();
+				// A function returning the pool the objects of the class are allocated from.
+				ATHENA_DLL static const utility::ObjectPool& pool();
+
+
+				/*
+					A function responsible of setting the callable the task performs, replacing the task function.
+					Returns false if the callable has to be allocated and the allocation fails.
+				*/
+				template <typename Function>
+				bool callable( Function&& function );
+				// A function responsible of setting the next task of the list the task belongs to.
+				ATHENA_DLL void next( ThreadTask* task );
+				// A function responsible of setting the priority class, cancellation, deadline and drop callback of the task.
+				ATHENA_DLL void options( const TaskOptions& options );
+				// A function responsible of setting the time the task was queued.
+				ATHENA_DLL void queue_time( const TaskClock::time_point& time );
+				// A function responsible of performing the task. A task is only performed once.
+				ATHENA_DLL void perform();
+				/*
+					A function responsible of dropping the task without performing it. The callable of the task is destroyed
+					and the drop callback is called with the given reason, instead of the task function and its callback.
+				*/
+				ATHENA_DLL void drop( const TaskDropReason reason );
+
+
+				// A function returning the next task of the list the task belongs to.
+				ATHENA_DLL ThreadTask* next() const;
+				// A function returning the priority class of the task.
+				ATHENA_DLL TaskPriority priority() const;
+				// A function returning the time the task was queued.
+				ATHENA_DLL const TaskClock::time_point& queue_time() const;
+				/*
+					A function returning whether the task should be dropped instead of being performed at the given time,
+					either because it has been cancelled or because its deadline has passed. The reason is set if the task should be dropped.
+				*/
+				ATHENA_DLL bool obsolete( const TaskClock::time_point& time , TaskDropReason& reason ) const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "threadTask.inl"
+
+
+
+#endif /* ATHENA_CORE_THREADTASK_HPP */
\ No newline at end of file
@@ -0,0 +1,174 @@
+#ifndef ATHENA_CORE_THREADTASK_INL
+#define ATHENA_CORE_THREADTASK_INL
+
+#ifndef ATHENA_CORE_THREADTASK_HPP
+	#error "threadTask.hpp must be included before threadTask.inl"
+#endif /* ATHENA_CORE_THREADTASK_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// The function that performs and destroys a callable that is stored inline.
+		template <typename Callable>
+		void ThreadTask::invoke_inline( ThreadTask* task , const bool perform )
+		{
+			Callable* callable = reinterpret_cast<Callable*>(&task->m_storage);
+
+
+			if ( perform )
+				(*callable)();
+
+			callable->~Callable();
+		}
+
+		// The function that performs and destroys a callable that is allocated on its own.
+		template <typename Callable>
+		void ThreadTask::invoke_allocated( ThreadTask* task , const bool perform )
+		{
+			Callable* callable = static_cast<Callable*>(task->m_storage.m_pointer);
+
+
+			if ( perform )
+				(*callable)();
+
+			delete callable;
+		}
+
+
+		// A function responsible of storing a callable inline.
+		template <typename Function>
+		bool ThreadTask::store( Function&& function , std::true_type )
+		{
+			typedef typename std::decay<Function>::type Callable;
+
+
+			new (static_cast<void*>(&m_storage)) Callable(std::forward<Function>(function));
+			m_invoke = &ThreadTask::invoke_inline<Callable>;
+
+
+			return true;
+		}
+
+		// A function responsible of storing a callable that does not fit in the storage of the task. Returns false if the allocation fails.
+		template <typename Function>
+		bool ThreadTask::store( Function&& function , std::false_type )
+		{
+			typedef typename std::decay<Function>::type Callable;
+
+			bool return_value = false;
+
+
+			m_storage.m_pointer = new (std::nothrow) Callable(std::forward<Function>(function));
+
+			if ( m_storage.m_pointer != NULL )
+			{
+				m_invoke = &ThreadTask::invoke_allocated<Callable>;
+				return_value = true;
+			}
+
+
+			return return_value;
+		}
+
+
+		/*
+			A function responsible of setting the callable the task performs, replacing the task function.
+			Returns false if the callable has to be allocated and the allocation fails.
+		*/
+		template <typename Function>
+		bool ThreadTask::callable( Function&& function )
+		{
+			typedef typename std::decay<Function>::type Callable;
+
+			bool return_value = false;
+
+
+			// Destroy any previous callable.
+			if ( m_invoke != NULL )
+			{
+				(*m_invoke)(this,false);
+				m_invoke = NULL;
+			}
+
+			m_function = NULL;
+
+			return_value = store(
+									std::forward<Function>(function) ,
+									std::integral_constant<
+										bool ,
+										sizeof(Callable) <= sizeof(ThreadTaskStorage)  &&  std::alignment_of<Callable>::value <= std::alignment_of<ThreadTaskStorage>::value
+									>()
+								);
+
+
+			return return_value;
+		}
+
+		// A function responsible of setting the next task of the list the task belongs to.
+		inline void ThreadTask::next( ThreadTask* task )
+		{
+			m_next = task;
+		}
+
+
+		// A function responsible of setting the time the task was queued.
+		inline void ThreadTask::queue_time( const TaskClock::time_point& time )
+		{
+			m_queue_time = time;
+		}
+
+
+		// A function returning the next task of the list the task belongs to.
+		inline ThreadTask* ThreadTask::next() const
+		{
+			return m_next;
+		}
+
+		// A function returning the priority class of the task.
+		inline TaskPriority ThreadTask::priority() const
+		{
+			return m_priority;
+		}
+
+		// A function returning the time the task was queued.
+		inline const TaskClock::time_point& ThreadTask::queue_time() const
+		{
+			return m_queue_time;
+		}
+
+		/*
+			A function returning whether the task should be dropped instead of being performed at the given time,
+			either because it has been cancelled or because its deadline has passed. The reason is set if the task should be dropped.
+		*/
+		inline bool ThreadTask::obsolete( const TaskClock::time_point& time , TaskDropReason& reason ) const
+		{
+			bool return_value = false;
+
+
+			if ( m_cancellation != NULL  &&  m_cancellation->cancelled() )
+			{
+				reason = CancelledTask;
+				return_value = true;
+			}
+			else if ( m_deadline != TaskClock::time_point()  &&  time > m_deadline )
+			{
+				reason = ExpiredTask;
+				return_value = true;
+			}
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_THREADTASK_INL */
\ No newline at end of file
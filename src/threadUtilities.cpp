@@ -0,0 +1,309 @@
+#include "threadUtilities.hpp"
+
+#ifdef _WIN32
+
+	#include "windowsDefinitions.hpp"
+	#include <Windows.h>
+
+#elif defined(__linux__)
+
+	#include <fstream>
+	#include <sstream>
+	#include <cstdlib>
+	#include <pthread.h>
+	#include <sched.h>
+
+#endif /* _WIN32 */
+
+
+namespace athena
+{
+
+	namespace utility
+	{
+
+		#if !defined(_WIN32)  &&  defined(__linux__)
+
+			// A function responsible of parsing a list of processors or nodes, such as "0-3,8-11", as it is written by the kernel.
+			static void parse_list( const std::string& list , std::vector<unsigned int>& values )
+			{
+				std::istringstream stream(list);
+				std::string range("");
+
+
+				while ( std::getline(stream,range,',') )
+				{
+					size_t separator = range.find('-');
+					unsigned long first = strtoul(range.c_str(),NULL,10);
+					unsigned long last = ( separator != std::string::npos  ?  strtoul(range.c_str() + separator + 1,NULL,10) : first );
+
+
+					if ( range.find_first_of("0123456789") != std::string::npos )
+					{
+						for ( unsigned long value = first;  value <= last;  ++value )
+							values.push_back(static_cast<unsigned int>(value));
+					}
+				}
+			}
+
+			// A function responsible of reading the first line of the given file. Returns false if the file cannot be read.
+			static bool read_line( const std::string& filename , std::string& line )
+			{
+				std::ifstream file(filename.c_str());
+				bool return_value = false;
+
+
+				if ( file.is_open() )
+					return_value = static_cast<bool>(std::getline(file,line));
+
+
+				return return_value;
+			}
+
+		#endif /* __linux__ */
+
+
+		/*
+			A function responsible of naming the calling thread, so that it can be told apart in debuggers and profilers.
+			Names are truncated to fifteen (15) characters under Linux. Returns false if the platform does not support thread names.
+		*/
+		bool set_thread_name( const std::string& name )
+		{
+			bool return_value = false;
+
+
+			#if !defined(_WIN32)  &&  defined(__linux__)
+
+				// The kernel limits the name to sixteen (16) bytes, including the terminating character.
+				return_value = ( pthread_setname_np(pthread_self(),name.substr(0,15).c_str()) == 0 );
+
+			#else
+
+				// Thread descriptions are not available in the Windows SDKs the engine is built with.
+				(void)name;
+
+			#endif /* __linux__ */
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of restricting the calling thread to the given processors.
+			Returns false if the affinity could not be set or if any of the processors cannot be represented by the platform.
+		*/
+		bool set_thread_affinity( const std::vector<unsigned int>& processors )
+		{
+			bool return_value = false;
+
+
+			#ifdef _WIN32
+
+				DWORD_PTR mask = 0;
+				bool representable = true;
+
+
+				for (
+						std::vector<unsigned int>::const_iterator processor_iterator = processors.begin();
+						processor_iterator != processors.end();
+						++processor_iterator
+					)
+				{
+					if ( (*processor_iterator) < sizeof(DWORD_PTR) * 8 )
+						mask |= static_cast<DWORD_PTR>(1) << (*processor_iterator);
+					else
+						representable = false;
+				}
+
+				if ( representable  &&  mask != 0 )
+					return_value = ( SetThreadAffinityMask(GetCurrentThread(),mask) != 0 );
+
+			#elif defined(__linux__)
+
+				cpu_set_t set;
+				bool representable = true;
+
+
+				CPU_ZERO(&set);
+
+				for (
+						std::vector<unsigned int>::const_iterator processor_iterator = processors.begin();
+						processor_iterator != processors.end();
+						++processor_iterator
+					)
+				{
+					if ( (*processor_iterator) < CPU_SETSIZE )
+						CPU_SET((*processor_iterator),&set);
+					else
+						representable = false;
+				}
+
+				if ( representable  &&  CPU_COUNT(&set) > 0 )
+					return_value = ( pthread_setaffinity_np(pthread_self(),sizeof(set),&set) == 0 );
+
+			#else
+
+				(void)processors;
+
+			#endif /* _WIN32 */
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of retrieving the processors the process is allowed to run on, which may be fewer than the processors
+			of the system when the process is restricted to a cpuset. Returns false if they cannot be determined, in which case the processors are left empty.
+		*/
+		bool allowed_processors( std::vector<unsigned int>& processors )
+		{
+			bool return_value = false;
+
+
+			processors.clear();
+
+			#ifdef _WIN32
+
+				DWORD_PTR process_mask = 0;
+				DWORD_PTR system_mask = 0;
+
+
+				if ( GetProcessAffinityMask(GetCurrentProcess(),&process_mask,&system_mask) )
+				{
+					for ( unsigned int processor = 0;  processor < sizeof(DWORD_PTR) * 8;  ++processor )
+					{
+						if ( ( process_mask & ( static_cast<DWORD_PTR>(1) << processor ) ) != 0 )
+							processors.push_back(processor);
+					}
+
+					return_value = ( processors.size() > 0 );
+				}
+
+			#elif defined(__linux__)
+
+				cpu_set_t set;
+
+
+				CPU_ZERO(&set);
+
+				if ( sched_getaffinity(0,sizeof(set),&set) == 0 )
+				{
+					for ( unsigned int processor = 0;  processor < CPU_SETSIZE;  ++processor )
+					{
+						if ( CPU_ISSET(processor,&set) )
+							processors.push_back(processor);
+					}
+
+					return_value = ( processors.size() > 0 );
+				}
+
+			#endif /* _WIN32 */
+
+
+			return return_value;
+		}
+
+		// A function returning the processor the calling thread is running on, or zero (0) if it cannot be determined.
+		unsigned int current_processor()
+		{
+			unsigned int return_value = 0;
+
+
+			#ifdef _WIN32
+
+				return_value = static_cast<unsigned int>(GetCurrentProcessorNumber());
+
+			#elif defined(__linux__)
+
+				int processor = sched_getcpu();
+
+
+				if ( processor > 0 )
+					return_value = static_cast<unsigned int>(processor);
+
+			#endif /* _WIN32 */
+
+
+			return return_value;
+		}
+
+		/*
+			A function responsible of retrieving the processors of every NUMA node, indexed by node.
+			Returns false if the topology cannot be determined, in which case the nodes are left empty.
+		*/
+		bool numa_topology( std::vector< std::vector<unsigned int> >& nodes )
+		{
+			bool return_value = false;
+
+
+			nodes.clear();
+
+			#ifdef _WIN32
+
+				ULONG highest_node = 0;
+
+
+				if ( GetNumaHighestNodeNumber(&highest_node) )
+				{
+					nodes.resize(highest_node + 1);
+
+					for ( ULONG node = 0;  node <= highest_node;  ++node )
+					{
+						ULONGLONG mask = 0;
+
+
+						if ( GetNumaNodeProcessorMask(static_cast<UCHAR>(node),&mask) )
+						{
+							for ( unsigned int processor = 0;  processor < sizeof(ULONGLONG) * 8;  ++processor )
+							{
+								if ( ( mask & ( static_cast<ULONGLONG>(1) << processor ) ) != 0 )
+									nodes[node].push_back(processor);
+							}
+						}
+					}
+
+					return_value = true;
+				}
+
+			#elif defined(__linux__)
+
+				std::string line("");
+
+
+				if ( read_line("/sys/devices/system/node/online",line) )
+				{
+					std::vector<unsigned int> online_nodes;
+
+
+					parse_list(line,online_nodes);
+
+					for (
+							std::vector<unsigned int>::iterator node_iterator = online_nodes.begin();
+							node_iterator != online_nodes.end();
+							++node_iterator
+						)
+					{
+						std::ostringstream filename;
+
+
+						filename << "/sys/devices/system/node/node" << (*node_iterator) << "/cpulist";
+
+						if ( (*node_iterator) >= nodes.size() )
+							nodes.resize((*node_iterator) + 1);
+
+						if ( read_line(filename.str(),line) )
+							parse_list(line,nodes[(*node_iterator)]);
+					}
+
+					return_value = ( nodes.size() > 0 );
+				}
+
+			#endif /* _WIN32 */
+
+
+			return return_value;
+		}
+
+	} /* utility */
+
+} /* athena */
\ No newline at end of file
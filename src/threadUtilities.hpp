@@ -0,0 +1,45 @@
+#ifndef ATHENA_UTILITY_THREADUTILITIES_HPP
+#define ATHENA_UTILITY_THREADUTILITIES_HPP
+
+#include "definitions.hpp"
+#include <string>
+#include <vector>
+
+
+namespace athena
+{
+
+	namespace utility
+	{
+
+		/*
+			A function responsible of naming the calling thread, so that it can be told apart in debuggers and profilers.
+			Names are truncated to fifteen (15) characters under Linux. Returns false if the platform does not support thread names.
+		*/
+		ATHENA_DLL bool set_thread_name( const std::string& name );
+
+		/*
+			A function responsible of restricting the calling thread to the given processors.
+			Returns false if the affinity could not be set or if any of the processors cannot be represented by the platform.
+		*/
+		ATHENA_DLL bool set_thread_affinity( const std::vector<unsigned int>& processors );
+		/*
+			A function responsible of retrieving the processors the process is allowed to run on, which may be fewer than the processors
+			of the system when the process is restricted to a cpuset. Returns false if they cannot be determined, in which case the processors are left empty.
+		*/
+		ATHENA_DLL bool allowed_processors( std::vector<unsigned int>& processors );
+
+		// A function returning the processor the calling thread is running on, or zero (0) if it cannot be determined.
+		ATHENA_DLL unsigned int current_processor();
+
+		/*
+			A function responsible of retrieving the processors of every NUMA node, indexed by node.
+			Returns false if the topology cannot be determined, in which case the nodes are left empty.
+		*/
+		ATHENA_DLL bool numa_topology( std::vector< std::vector<unsigned int> >& nodes );
+
+	} /* utility */
+
+} /* athena */
+
+#endif /* ATHENA_UTILITY_THREADUTILITIES_HPP */
\ No newline at end of file
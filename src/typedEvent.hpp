@@ -0,0 +1,213 @@
+#ifndef ATHENA_CORE_TYPEDEVENT_HPP
+#define ATHENA_CORE_TYPEDEVENT_HPP
+
+#include "definitions.hpp"
+#include <tuple>
+#include "event.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A struct mapping a payload type to the parameter type it is stored as.
+			Only the types of the ParameterType enumeration are specialised, so using
+			any other payload type in a typed event fails at compile time.
+		*/
+		template <typename Type>
+		struct ParameterTraits;
+
+		template <>
+		struct ParameterTraits<bool>
+		{
+			static ParameterType type() { return Boolean; }
+			static bool read( const Parameter& parameter ) { return *(static_cast<const bool*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<char>
+		{
+			static ParameterType type() { return Character; }
+			static char read( const Parameter& parameter ) { return *(static_cast<const char*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<unsigned char>
+		{
+			static ParameterType type() { return UnsignedCharacter; }
+			static unsigned char read( const Parameter& parameter ) { return *(static_cast<const unsigned char*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<wchar_t>
+		{
+			static ParameterType type() { return WideCharacter; }
+			static wchar_t read( const Parameter& parameter ) { return *(static_cast<const wchar_t*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<short>
+		{
+			static ParameterType type() { return ShortInteger; }
+			static short read( const Parameter& parameter ) { return *(static_cast<const short*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<unsigned short>
+		{
+			static ParameterType type() { return UnsignedShortInteger; }
+			static unsigned short read( const Parameter& parameter ) { return *(static_cast<const unsigned short*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<int>
+		{
+			static ParameterType type() { return Integer; }
+			static int read( const Parameter& parameter ) { return *(static_cast<const int*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<unsigned int>
+		{
+			static ParameterType type() { return UnsignedInteger; }
+			static unsigned int read( const Parameter& parameter ) { return *(static_cast<const unsigned int*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<long>
+		{
+			static ParameterType type() { return LongInteger; }
+			static long read( const Parameter& parameter ) { return *(static_cast<const long*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<unsigned long>
+		{
+			static ParameterType type() { return UnsignedLongInteger; }
+			static unsigned long read( const Parameter& parameter ) { return *(static_cast<const unsigned long*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<float>
+		{
+			static ParameterType type() { return Real; }
+			static float read( const Parameter& parameter ) { return *(static_cast<const float*>(parameter.data())); }
+		};
+
+		template <>
+		struct ParameterTraits<double>
+		{
+			static ParameterType type() { return DoubleReal; }
+			static double read( const Parameter& parameter ) { return *(static_cast<const double*>(parameter.data())); }
+		};
+
+		/*
+			A pointer that is stored inline is the value of the parameter, while the
+			data of a parameter that is not stored inline is the pointer itself.
+		*/
+		template <typename Type>
+		struct ParameterTraits<Type*>
+		{
+			static ParameterType type() { return Pointer; }
+			static Type* read( const Parameter& parameter ) { return ( parameter.stored_inline()  ?  *(static_cast<Type* const*>(parameter.data())) : static_cast<Type*>(parameter.data()) ); }
+		};
+
+
+		/*
+			A struct responsible of copying the payload of a typed event, starting from the given index,
+			to and from the parameters of an event. The recursion is resolved at compile time.
+		*/
+		template <unsigned int Index , unsigned int Count>
+		struct TypedEventPayload
+		{
+			// A function responsible of storing the payload inline, as the parameters of the given event.
+			template <typename Payload>
+			static void encode( const Payload& payload , Event& event );
+			// A function responsible of reading the payload from the parameters of the given event. Returns false if a parameter is missing or of a different type.
+			template <typename Payload>
+			static bool decode( const Event& event , Payload& payload );
+		};
+
+		template <unsigned int Count>
+		struct TypedEventPayload<Count,Count>
+		{
+			// A function responsible of storing the payload inline, as the parameters of the given event.
+			template <typename Payload>
+			static void encode( const Payload& payload , Event& event );
+			// A function responsible of reading the payload from the parameters of the given event. Returns false if a parameter is missing or of a different type.
+			template <typename Payload>
+			static bool decode( const Event& event , Payload& payload );
+		};
+
+
+		/*
+			A class representing an event whose code and payload types are known at compile time.
+			The payload is stored by value, both in the typed event and in the inline parameters of the
+			event it is converted to, so a typed event needs no allocation, no pointers that have to
+			outlive it and no cleanup function. Typed events are triggered through their event() and are
+			received through a TypedListener, which decodes them before calling the typed handler.
+			A periodic typed event has a utility::TimerValueType as its first payload, which holds the
+			time that has passed since its last trigger.
+		*/
+		template <EventCode Code , typename... Payload>
+		class TypedEvent
+		{
+			public:
+
+				// A type definition that defines the type of the payload of the event.
+				typedef std::tuple<Payload...> PayloadType;
+
+
+			private:
+
+				// The payload of the event.
+				PayloadType m_payload;
+				// The id of the triggering entity.
+				ListenerIDType m_initiator_id;
+
+
+			public:
+
+				// A constructor of the class that copies the given payload.
+				explicit TypedEvent( const Payload&... payload );
+				// A constructor of the class that copies the given payload tuple, used when decoding an event.
+				TypedEvent( const PayloadType& payload , const ListenerIDType& initiator_id );
+
+
+				// A function returning the id code of the event.
+				static EventCode code();
+				// A function returning the amount of values in the payload of the event.
+				static unsigned int size();
+				// A function responsible of reading the payload of the given event. Returns false if the event does not match the typed event.
+				static bool decode( const Event& event , PayloadType& payload );
+
+
+				// A function responsible of setting the id of the triggering entity.
+				void initiator_id( const ListenerIDType& value );
+
+
+				// A function returning the id of the triggering entity.
+				ListenerIDType initiator_id() const;
+				// A function returning the payload of the event.
+				const PayloadType& payload() const;
+				// A function returning the value of the payload at the given index.
+				template <unsigned int Index>
+				const typename std::tuple_element<Index,PayloadType>::type& get() const;
+				// A function returning an event holding the payload inline, that can be triggered through the event manager.
+				Event event() const;
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "typedEvent.inl"
+
+
+
+#endif /* ATHENA_CORE_TYPEDEVENT_HPP */
\ No newline at end of file
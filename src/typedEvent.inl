@@ -0,0 +1,161 @@
+#ifndef ATHENA_CORE_TYPEDEVENT_INL
+#define ATHENA_CORE_TYPEDEVENT_INL
+
+#ifndef ATHENA_CORE_TYPEDEVENT_HPP
+	#error "typedEvent.hpp must be included before typedEvent.inl"
+#endif /* ATHENA_CORE_TYPEDEVENT_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of storing the payload inline, as the parameters of the given event.
+		template <unsigned int Index , unsigned int Count>
+		template <typename Payload>
+		inline void TypedEventPayload<Index,Count>::encode( const Payload& payload , Event& event )
+		{
+			typedef typename std::tuple_element<Index,Payload>::type ValueType;
+
+
+			event.parameter_value(Index,ParameterTraits<ValueType>::type(),&std::get<Index>(payload));
+			TypedEventPayload<Index+1,Count>::encode(payload,event);
+		}
+
+		// A function responsible of reading the payload from the parameters of the given event. Returns false if a parameter is missing or of a different type.
+		template <unsigned int Index , unsigned int Count>
+		template <typename Payload>
+		inline bool TypedEventPayload<Index,Count>::decode( const Event& event , Payload& payload )
+		{
+			typedef typename std::tuple_element<Index,Payload>::type ValueType;
+
+			const Parameter* parameter = event.parameter(Index);
+			bool return_value = false;
+
+
+			if ( parameter != NULL  &&  parameter->type() == ParameterTraits<ValueType>::type()  &&  parameter->data() != NULL )
+			{
+				std::get<Index>(payload) = ParameterTraits<ValueType>::read((*parameter));
+				return_value = TypedEventPayload<Index+1,Count>::decode(event,payload);
+			}
+
+
+			return return_value;
+		}
+
+
+		// A function responsible of storing the payload inline, as the parameters of the given event.
+		template <unsigned int Count>
+		template <typename Payload>
+		inline void TypedEventPayload<Count,Count>::encode( const Payload& , Event& )
+		{
+		}
+
+		// A function responsible of reading the payload from the parameters of the given event. Returns false if a parameter is missing or of a different type.
+		template <unsigned int Count>
+		template <typename Payload>
+		inline bool TypedEventPayload<Count,Count>::decode( const Event& , Payload& )
+		{
+			return true;
+		}
+
+
+		// A constructor of the class that copies the given payload.
+		template <EventCode Code , typename... Payload>
+		inline TypedEvent<Code,Payload...>::TypedEvent( const Payload&... payload ) :
+			m_payload(payload...) ,
+			m_initiator_id(0)
+		{
+		}
+
+		// A constructor of the class that copies the given payload tuple, used when decoding an event.
+		template <EventCode Code , typename... Payload>
+		inline TypedEvent<Code,Payload...>::TypedEvent( const PayloadType& payload , const ListenerIDType& initiator_id ) :
+			m_payload(payload) ,
+			m_initiator_id(initiator_id)
+		{
+		}
+
+
+		// A function returning the id code of the event.
+		template <EventCode Code , typename... Payload>
+		inline EventCode TypedEvent<Code,Payload...>::code()
+		{
+			return Code;
+		}
+
+		// A function returning the amount of values in the payload of the event.
+		template <EventCode Code , typename... Payload>
+		inline unsigned int TypedEvent<Code,Payload...>::size()
+		{
+			return sizeof...(Payload);
+		}
+
+		// A function responsible of reading the payload of the given event. Returns false if the event does not match the typed event.
+		template <EventCode Code , typename... Payload>
+		inline bool TypedEvent<Code,Payload...>::decode( const Event& event , PayloadType& payload )
+		{
+			bool return_value = false;
+
+
+			if ( event.code() == Code  &&  event.parameter_count() >= sizeof...(Payload) )
+				return_value = TypedEventPayload<0,sizeof...(Payload)>::decode(event,payload);
+
+
+			return return_value;
+		}
+
+
+		// A function responsible of setting the id of the triggering entity.
+		template <EventCode Code , typename... Payload>
+		inline void TypedEvent<Code,Payload...>::initiator_id( const ListenerIDType& value )
+		{
+			m_initiator_id = value;
+		}
+
+
+		// A function returning the id of the triggering entity.
+		template <EventCode Code , typename... Payload>
+		inline ListenerIDType TypedEvent<Code,Payload...>::initiator_id() const
+		{
+			return m_initiator_id;
+		}
+
+		// A function returning the payload of the event.
+		template <EventCode Code , typename... Payload>
+		inline const typename TypedEvent<Code,Payload...>::PayloadType& TypedEvent<Code,Payload...>::payload() const
+		{
+			return m_payload;
+		}
+
+		// A function returning the value of the payload at the given index.
+		template <EventCode Code , typename... Payload>
+		template <unsigned int Index>
+		inline const typename std::tuple_element<Index,typename TypedEvent<Code,Payload...>::PayloadType>::type& TypedEvent<Code,Payload...>::get() const
+		{
+			return std::get<Index>(m_payload);
+		}
+
+		// A function returning an event holding the payload inline, that can be triggered through the event manager.
+		template <EventCode Code , typename... Payload>
+		inline Event TypedEvent<Code,Payload...>::event() const
+		{
+			Event return_value(Code,m_initiator_id);
+
+
+			TypedEventPayload<0,sizeof...(Payload)>::encode(m_payload,return_value);
+
+
+			return return_value;
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_TYPEDEVENT_INL */
\ No newline at end of file
@@ -0,0 +1,89 @@
+#ifndef ATHENA_CORE_TYPEDLISTENER_HPP
+#define ATHENA_CORE_TYPEDLISTENER_HPP
+
+#include "definitions.hpp"
+#include "listener.hpp"
+#include "typedEvent.hpp"
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		/*
+			A struct responsible of finding the typed event that matches an event and calling the
+			handler of the listener for it. The chain of comparisons is generated at compile time,
+			so the handler that is called is resolved statically.
+		*/
+		template <typename Handler , typename... TypedEvents>
+		struct TypedEventDispatcher;
+
+		template <typename Handler>
+		struct TypedEventDispatcher<Handler>
+		{
+			// A function responsible of calling the handler for the matching typed event. Returns false if no typed event matches.
+			static bool dispatch( Handler& handler , const Event& event );
+			// A function responsible of registering the codes of the typed events for the given listener.
+			static void register_events( Listener& listener );
+			// A function responsible of unregistering the codes of the typed events for the given listener.
+			static void unregister_events( Listener& listener );
+		};
+
+		template <typename Handler , typename TypedEventType , typename... TypedEvents>
+		struct TypedEventDispatcher<Handler,TypedEventType,TypedEvents...>
+		{
+			// A function responsible of calling the handler for the matching typed event. Returns false if no typed event matches.
+			static bool dispatch( Handler& handler , const Event& event );
+			// A function responsible of registering the codes of the typed events for the given listener.
+			static void register_events( Listener& listener );
+			// A function responsible of unregistering the codes of the typed events for the given listener.
+			static void unregister_events( Listener& listener );
+		};
+
+
+		/*
+			A class representing a listener that receives typed events.
+			The derived class provides an on_typed_event overload for every typed event in the list,
+			which is called with the decoded event, without any switch on the code or the parameter types.
+			Events that do not match any typed event, or whose parameters do not match the payload types,
+			are ignored, unless the derived class overrides on_event and handles them when dispatch_typed_event
+			returns false.
+		*/
+		template <typename Derived , typename... TypedEvents>
+		class TypedListener : public Listener
+		{
+			protected:
+
+				// A function responsible of calling the typed handler of the derived class for the given event. Returns false if no typed event matches.
+				bool dispatch_typed_event( const Event& event );
+
+
+			public:
+
+				// The constructor of the class.
+				explicit TypedListener( const ListenerIDType& id = 0 );
+				// The destructor of the class.
+				virtual ~TypedListener();
+
+
+				// A function to be called when an event occurs.
+				virtual void on_event( const Event& event );
+				// A function responsible of registering the codes of every typed event of the listener.
+				void register_typed_events();
+				// A function responsible of unregistering the codes of every typed event of the listener.
+				void unregister_typed_events();
+		};
+
+	} /* core */
+
+} /* athena */
+
+
+#include "typedListener.inl"
+
+
+
+#endif /* ATHENA_CORE_TYPEDLISTENER_HPP */
\ No newline at end of file
@@ -0,0 +1,123 @@
+#ifndef ATHENA_CORE_TYPEDLISTENER_INL
+#define ATHENA_CORE_TYPEDLISTENER_INL
+
+#ifndef ATHENA_CORE_TYPEDLISTENER_HPP
+	#error "typedListener.hpp must be included before typedListener.inl"
+#endif /* ATHENA_CORE_TYPEDLISTENER_HPP */
+
+
+
+namespace athena
+{
+
+	namespace core
+	{
+
+		// A function responsible of calling the handler for the matching typed event. Returns false if no typed event matches.
+		template <typename Handler>
+		inline bool TypedEventDispatcher<Handler>::dispatch( Handler& , const Event& )
+		{
+			return false;
+		}
+
+		// A function responsible of registering the codes of the typed events for the given listener.
+		template <typename Handler>
+		inline void TypedEventDispatcher<Handler>::register_events( Listener& )
+		{
+		}
+
+		// A function responsible of unregistering the codes of the typed events for the given listener.
+		template <typename Handler>
+		inline void TypedEventDispatcher<Handler>::unregister_events( Listener& )
+		{
+		}
+
+
+		// A function responsible of calling the handler for the matching typed event. Returns false if no typed event matches.
+		template <typename Handler , typename TypedEventType , typename... TypedEvents>
+		inline bool TypedEventDispatcher<Handler,TypedEventType,TypedEvents...>::dispatch( Handler& handler , const Event& event )
+		{
+			typename TypedEventType::PayloadType payload;
+			bool return_value = false;
+
+
+			// If the event matches the typed event, call the handler, otherwise try the rest of the typed events.
+			if ( TypedEventType::decode(event,payload) )
+			{
+				handler.on_typed_event(TypedEventType(payload,event.initiator_id()));
+				return_value = true;
+			}
+			else
+				return_value = TypedEventDispatcher<Handler,TypedEvents...>::dispatch(handler,event);
+
+
+			return return_value;
+		}
+
+		// A function responsible of registering the codes of the typed events for the given listener.
+		template <typename Handler , typename TypedEventType , typename... TypedEvents>
+		inline void TypedEventDispatcher<Handler,TypedEventType,TypedEvents...>::register_events( Listener& listener )
+		{
+			listener.register_event(TypedEventType::code());
+			TypedEventDispatcher<Handler,TypedEvents...>::register_events(listener);
+		}
+
+		// A function responsible of unregistering the codes of the typed events for the given listener.
+		template <typename Handler , typename TypedEventType , typename... TypedEvents>
+		inline void TypedEventDispatcher<Handler,TypedEventType,TypedEvents...>::unregister_events( Listener& listener )
+		{
+			listener.unregister_event(TypedEventType::code());
+			TypedEventDispatcher<Handler,TypedEvents...>::unregister_events(listener);
+		}
+
+
+		// A function responsible of calling the typed handler of the derived class for the given event. Returns false if no typed event matches.
+		template <typename Derived , typename... TypedEvents>
+		inline bool TypedListener<Derived,TypedEvents...>::dispatch_typed_event( const Event& event )
+		{
+			return TypedEventDispatcher<Derived,TypedEvents...>::dispatch(*(static_cast<Derived*>(this)),event);
+		}
+
+
+		// The constructor of the class.
+		template <typename Derived , typename... TypedEvents>
+		inline TypedListener<Derived,TypedEvents...>::TypedListener( const ListenerIDType& id ) :
+			Listener(id)
+		{
+		}
+
+		// The destructor of the class.
+		template <typename Derived , typename... TypedEvents>
+		inline TypedListener<Derived,TypedEvents...>::~TypedListener()
+		{
+		}
+
+
+		// A function to be called when an event occurs.
+		template <typename Derived , typename... TypedEvents>
+		inline void TypedListener<Derived,TypedEvents...>::on_event( const Event& event )
+		{
+			dispatch_typed_event(event);
+		}
+
+		// A function responsible of registering the codes of every typed event of the listener.
+		template <typename Derived , typename... TypedEvents>
+		inline void TypedListener<Derived,TypedEvents...>::register_typed_events()
+		{
+			TypedEventDispatcher<Derived,TypedEvents...>::register_events((*this));
+		}
+
+		// A function responsible of unregistering the codes of every typed event of the listener.
+		template <typename Derived , typename... TypedEvents>
+		inline void TypedListener<Derived,TypedEvents...>::unregister_typed_events()
+		{
+			TypedEventDispatcher<Derived,TypedEvents...>::unregister_events((*this));
+		}
+
+	} /* core */
+
+} /* athena */
+
+
+
+#endif /* ATHENA_CORE_TYPEDLISTENER_INL */
\ No newline at end of file